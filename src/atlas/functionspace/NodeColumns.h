@@ -83,6 +83,8 @@ public:
 
     void haloExchange( const FieldSet&, bool on_device = false ) const override;
     void haloExchange( const Field&, bool on_device = false ) const override;
+    void adjointHaloExchange( const FieldSet&, bool on_device = false ) const override;
+    void adjointHaloExchange( const Field&, bool on_device = false ) const override;
     const parallel::HaloExchange& halo_exchange() const;
 
     void gather( const FieldSet&, FieldSet& ) const;
@@ -112,6 +112,7 @@ void StructuredColumns::setup( const grid::Distribution& distribution, const eck
     i_begin_.resize( grid_->ny(), std::numeric_limits<idx_t>::max() );
     i_end_.resize( grid_->ny(), std::numeric_limits<idx_t>::min() );
     idx_t owned( 0 );
+    grid::Distribution::ranges_t owned_ranges;
 
     ATLAS_TRACE_SCOPE( "Compute bounds owned" ) {
         if ( mpi_size == 1 ) {
@@ -123,6 +124,24 @@ void StructuredColumns::setup( const grid::Distribution& distribution, const eck
             }
             owned = grid_->size();
         }
+        else if ( distribution.ranges( mpi_rank, owned_ranges ) ) {
+            // Only visit the rows owned by this partition
+            for ( const auto& range : owned_ranges ) {
+                idx_t i, j;
+                grid_->index2ij( range.begin, i, j );
+                for ( gidx_t begin = range.begin; begin < range.end; ) {
+                    const gidx_t end = std::min<gidx_t>( range.end, begin + ( grid_->nx( j ) - i ) );
+                    j_begin_         = std::min<idx_t>( j_begin_, j );
+                    j_end_           = std::max<idx_t>( j_end_, j + 1 );
+                    i_begin_[j]      = std::min<idx_t>( i_begin_[j], i );
+                    i_end_[j]        = std::max<idx_t>( i_end_[j], i + idx_t( end - begin ) );
+                    owned += idx_t( end - begin );
+                    begin = end;
+                    i     = 0;
+                    ++j;
+                }
+            }
+        }
         else {
             size_t num_threads = atlas_omp_get_max_threads();
             if ( num_threads == 1 ) {
@@ -13,6 +13,7 @@
 #pragma once
 
 #include "atlas/grid/Distribution.h"
+#include "atlas/grid/DistributionCache.h"
 #include "atlas/grid/Grid.h"
 #include "atlas/grid/Iterator.h"
 #include "atlas/grid/Partitioner.h"
@@ -10,18 +10,53 @@
 
 #include "Distribution.h"
 
+#include <algorithm>
+
+#include "eckit/serialisation/Stream.h"
 #include "eckit/utils/MD5.h"
 
 #include "atlas/grid/Grid.h"
 #include "atlas/grid/Partitioner.h"
 #include "atlas/grid/detail/distribution/DistributionArray.h"
+#include "atlas/grid/detail/distribution/RunLengthDistribution.h"
 #include "atlas/grid/detail/distribution/SerialDistribution.h"
+#include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Trace.h"
 
 namespace atlas {
 namespace grid {
 
 using namespace detail::distribution;
 
+namespace {
+
+// Version of the format written by Distribution::encode
+constexpr int encoding_version = 1;
+
+DistributionImpl* decode( eckit::Stream& s ) {
+    ATLAS_TRACE( "Distribution::decode" );
+    int version;
+    s >> version;
+    if ( version != encoding_version ) {
+        throw_Exception( "Cannot decode grid::Distribution encoded with version " + std::to_string( version ) +
+                             ", expected version " + std::to_string( encoding_version ),
+                         Here() );
+    }
+    std::string type;
+    gidx_t size;
+    idx_t nb_partitions;
+    std::vector<gidx_t> run_begin;
+    std::vector<int> run_partition;
+    s >> type;
+    s >> size;
+    s >> nb_partitions;
+    s >> run_begin;
+    s >> run_partition;
+    return new RunLengthDistribution( size, nb_partitions, std::move( run_begin ), std::move( run_partition ), type );
+}
+
+}  // namespace
+
 Distribution::Distribution( const Grid& grid ) : Handle( new SerialDistribution{grid} ) {}
 
 Distribution::Distribution( const Grid& grid, const Config& config ) :
@@ -36,6 +71,8 @@ Distribution::Distribution( int nb_partitions, idx_t npts, int part[], int part0
 Distribution::Distribution( int nb_partitions, partition_t&& part ) :
     Handle( new DistributionArray( nb_partitions, std::move( part ) ) ) {}
 
+Distribution::Distribution( eckit::Stream& s ) : Handle( decode( s ) ) {}
+
 Distribution::~Distribution() = default;
 
 const std::vector<idx_t>& Distribution::nb_pts() const {
@@ -69,5 +106,37 @@ std::string Distribution::hash() const {
     return h.digest();
 }
 
+int Distribution::encoding_version() {
+    return grid::encoding_version;
+}
+
+void Distribution::encode( eckit::Stream& s ) const {
+    ATLAS_TRACE( "Distribution::encode" );
+    std::vector<gidx_t> run_begin;
+    std::vector<int> run_partition;
+
+    // Visit the grid in blocks, so that functional distributions are evaluated with a single virtual call per block
+    const gidx_t blocksize = 4096;
+    partition_t block( blocksize );
+    for ( gidx_t begin = 0; begin < size(); begin += blocksize ) {
+        const gidx_t end = std::min( begin + blocksize, size() );
+        partition( begin, end, block );
+        for ( gidx_t n = begin; n < end; ++n ) {
+            const int p = block[n - begin];
+            if ( run_partition.empty() || run_partition.back() != p ) {
+                run_begin.emplace_back( n );
+                run_partition.emplace_back( p );
+            }
+        }
+    }
+
+    s << encoding_version();
+    s << type();
+    s << size();
+    s << nb_partitions();
+    s << run_begin;
+    s << run_partition;
+}
+
 }  // namespace grid
 }  // namespace atlas
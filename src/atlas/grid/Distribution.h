@@ -18,6 +18,10 @@
 #include "atlas/util/ObjectHandle.h"
 #include "atlas/util/vector.h"
 
+namespace eckit {
+class Stream;
+}
+
 namespace atlas {
 class Grid;
 namespace grid {
@@ -34,6 +38,7 @@ class Distribution : DOXYGEN_HIDE( public util::ObjectHandle<DistributionImpl> )
 public:
     using Config      = DistributionImpl::Config;
     using partition_t = atlas::vector<int>;
+    using ranges_t    = DistributionImpl::ranges_t;
 
     using Handle::Handle;
     Distribution() = default;
@@ -53,6 +58,12 @@ public:
     /// @brief Create a distribution by given array, and take ownership (move)
     Distribution( int nb_partitions, partition_t&& partition );
 
+    /// @brief Create a distribution from a Stream (serialization), written with encode()
+    ///
+    /// The result is functional, whatever the type of the encoded distribution: it keeps the runs of the encoding,
+    /// and the type of the encoded distribution.
+    explicit Distribution( eckit::Stream& );
+
     ~Distribution();
 
     ATLAS_ALWAYS_INLINE int partition( gidx_t index ) const { return get()->partition( index ); }
@@ -63,6 +74,10 @@ public:
         return get()->partition( begin, end, partitions.data() );
     }
 
+    /// @brief Sorted global index ranges owned by given partition
+    /// @return false when the distribution can only answer this by visiting every grid point
+    bool ranges( int partition, ranges_t& ranges ) const { return get()->ranges( partition, ranges ); }
+
     size_t footprint() const { return get()->footprint(); }
 
     ATLAS_ALWAYS_INLINE idx_t nb_partitions() const { return get()->nb_partitions(); }
@@ -82,6 +97,15 @@ public:
     std::string hash() const;
 
     void hash( eckit::Hash& ) const;
+
+    /// @brief Serialization to Stream
+    ///
+    /// Runs of consecutive global indices in the same partition are stored as their first index and partition,
+    /// which is compact for all partitioners that assign contiguous pieces of the grid.
+    void encode( eckit::Stream& ) const;
+
+    /// @brief Version of the format written by encode()
+    static int encoding_version();
 };
 
 }  // namespace grid
@@ -0,0 +1,120 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/grid/DistributionCache.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/io/ResizableBuffer.h"
+#include "eckit/serialisation/MemoryStream.h"
+#include "eckit/serialisation/ResizableMemoryStream.h"
+#include "eckit/utils/MD5.h"
+
+#include "atlas/grid/Grid.h"
+#include "atlas/library/version.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+
+namespace atlas {
+namespace grid {
+
+DistributionCache::DistributionCache( const eckit::PathName& directory ) : directory_( directory ) {}
+
+std::string DistributionCache::key( const Grid& grid, const Config& config ) const {
+    long partitions = mpi::size();
+    config.get( "partitions", partitions );
+
+    eckit::MD5 h;
+    h.add( grid.uid() );
+    config.hash( h );
+    h.add( partitions );
+    h.add( Distribution::encoding_version() );
+    h.add( std::string( library::version() ) );
+    return h.digest();
+}
+
+eckit::PathName DistributionCache::path( const std::string& key ) const {
+    return directory_ / ( "distribution-" + key + ".bin" );
+}
+
+Distribution DistributionCache::distribution( const Grid& grid, const Config& config ) const {
+    ATLAS_TRACE( "DistributionCache::distribution" );
+    const auto& comm           = mpi::comm();
+    const int root             = 0;
+    const eckit::PathName file = path( key( grid, config ) );
+
+    int cached = 0;
+    if ( comm.rank() == root ) {
+        cached = file.exists() ? 1 : 0;
+    }
+    ATLAS_TRACE_MPI( BROADCAST ) { comm.broadcast( cached, root ); }
+
+    if ( not cached ) {
+        Distribution distribution( grid, config );
+        if ( comm.rank() == root ) {
+            ATLAS_TRACE( "write" );
+            Log::debug() << "Storing distribution in cache file " << file << std::endl;
+            eckit::ResizableBuffer buffer{0};
+            eckit::ResizableMemoryStream s{buffer};
+            distribution.encode( s );
+
+            // Write to a temporary file first, so that concurrent jobs never read an incomplete file.
+            // Only this task writes, so a failure is not fatal: the distribution is simply not cached.
+            eckit::PathName tmp( file.asString() + ".tmp." + std::to_string( ::getpid() ) );
+            try {
+                directory_.mkdir();
+                {
+                    std::ofstream out( tmp.localPath(), std::ios::binary );
+                    out.write( static_cast<const char*>( buffer.data() ),
+                               static_cast<std::streamsize>( s.position() ) );
+                    if ( not out ) {
+                        throw_Exception( "Could not write distribution cache file " + tmp.asString(), Here() );
+                    }
+                }
+                eckit::PathName::rename( tmp, file );
+            }
+            catch ( const eckit::Exception& e ) {
+                Log::warning() << "Distribution could not be written to cache: " << e.what() << std::endl;
+                std::remove( tmp.localPath() );
+            }
+        }
+        return distribution;
+    }
+
+    std::string buffer;
+    int buffer_size{0};
+    if ( comm.rank() == root ) {
+        ATLAS_TRACE( "read" );
+        Log::debug() << "Loading distribution from cache file " << file << std::endl;
+        std::ifstream in( file.localPath(), std::ios::binary );
+        std::stringstream content;
+        content << in.rdbuf();
+        buffer      = content.str();
+        buffer_size = static_cast<int>( buffer.size() );
+    }
+    ATLAS_TRACE_MPI( BROADCAST ) { comm.broadcast( buffer_size, root ); }
+    if ( comm.rank() != root ) {
+        buffer.resize( buffer_size );
+    }
+    ATLAS_TRACE_MPI( BROADCAST ) { comm.broadcast( buffer.begin(), buffer.end(), root ); }
+
+    eckit::MemoryStream s( buffer.data(), buffer.size() );
+    return Distribution( s );
+}
+
+}  // namespace grid
+}  // namespace atlas
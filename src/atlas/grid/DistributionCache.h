@@ -0,0 +1,63 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "eckit/filesystem/PathName.h"
+
+#include "atlas/grid/Distribution.h"
+
+namespace atlas {
+class Grid;
+}  // namespace atlas
+
+namespace atlas {
+namespace grid {
+
+/// @brief File cache of grid distributions
+///
+/// A distribution only depends on the grid, the partitioner configuration and the number of partitions, but can
+/// take long to compute for large grids. The cache stores distributions in a directory, encoded with
+/// Distribution::encode(), in files named after a hash of these three.
+///
+/// Example:
+///
+///     grid::DistributionCache cache( "/path/to/cache" );
+///     grid::Distribution distribution = cache.distribution( grid, util::Config( "type", "equal_regions" ) );
+///
+/// All MPI tasks must call distribution(). On a cache miss the partitioner may need all of them, and
+/// MPI task 0 writes the file; if that fails, it logs a warning and the distribution is returned without being
+/// cached. On a cache hit MPI task 0 reads the file and broadcasts it.
+class DistributionCache {
+public:
+    using Config = Distribution::Config;
+
+    explicit DistributionCache( const eckit::PathName& directory );
+
+    /// @brief Load the distribution from the cache, or create it as Distribution( grid, config ) and store it
+    Distribution distribution( const Grid&, const Config& ) const;
+
+    /// @brief Key of a distribution, combining the grid hash, the partitioner configuration and the number of
+    /// partitions ("partitions" in the configuration, or else the number of MPI tasks). The encoding version and the
+    /// atlas version are included as well, so that files written in another format or by other partitioner code are
+    /// not reused.
+    std::string key( const Grid&, const Config& ) const;
+
+    /// @brief File of the distribution with given key
+    eckit::PathName path( const std::string& key ) const;
+
+private:
+    eckit::PathName directory_;
+};
+
+}  // namespace grid
+}  // namespace atlas
@@ -9,6 +9,9 @@
  */
 
 #include "atlas/grid/Partitioner.h"
+#include "atlas/array/ArrayView.h"
+#include "atlas/array/MakeView.h"
+#include "atlas/field/Field.h"
 #include "atlas/functionspace/FunctionSpace.h"
 #include "atlas/grid/Distribution.h"
 #include "atlas/grid/Grid.h"
@@ -73,6 +76,17 @@ std::string Partitioner::type() const {
     return get()->type();
 }
 
+void Partitioner::weights( const Weights& weights ) {
+    get()->weights( weights );
+}
+
+void Partitioner::weights( const Field& weights ) {
+    ATLAS_ASSERT( weights.rank() == 1 );
+    auto view = array::make_view<double, 1>( weights );
+    // The field is captured as well, to keep the viewed data alive
+    get()->weights( [weights, view]( gidx_t n ) { return view( n ); } );
+}
+
 MatchingPartitioner::MatchingPartitioner() : Partitioner() {}
 
 grid::detail::partitioner::Partitioner* matching_mesh_partititioner( const Mesh& mesh,
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 
 
@@ -21,6 +22,7 @@ class Parametrisation;
 }
 
 namespace atlas {
+class Field;
 class Grid;
 class Mesh;
 class FunctionSpace;
@@ -69,6 +71,7 @@ class Partitioner : DOXYGEN_HIDE( public util::ObjectHandle<detail::partitioner:
 public:
     using Config         = eckit::Parametrisation;
     using Implementation = detail::partitioner::Partitioner;
+    using Weights        = std::function<double( gidx_t )>;
 
 public:
     static bool exists( const std::string& type );
@@ -88,6 +91,15 @@ public:
     idx_t nb_partitions() const;
 
     std::string type() const;
+
+    /// @brief Balance the total weight instead of the number of grid points per partition
+    /// @param weights  weight (cost) of a grid point, given its global index
+    /// @note Supported by the "equal_regions", "bands" (and derived) and "hilbert" partitioners
+    void weights( const Weights& weights );
+
+    /// @brief Balance the total weight instead of the number of grid points per partition
+    /// @param weights  Field with one weight per grid point, indexed by global index
+    void weights( const Field& weights );
 };
 
 // ------------------------------------------------------------------
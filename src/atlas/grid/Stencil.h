@@ -16,11 +16,16 @@
 namespace atlas {
 namespace grid {
 
+template <idx_t StencilWidth, idx_t BlockSize>
+class HorizontalStencilBlock;
+
 //---------------------------------------------------------------------------------------------------------------------
 
 template <idx_t StencilWidth>
 class HorizontalStencil {
     friend class ComputeHorizontalStencil;
+    template <idx_t, idx_t>
+    friend class HorizontalStencilBlock;
     std::array<idx_t, StencilWidth> i_begin_;
     idx_t j_begin_;
 
@@ -56,6 +61,8 @@ template <idx_t StencilWidth>
 class Stencil3D {
     friend class ComputeHorizontalStencil;
     friend class ComputeVerticalStencil;
+    template <idx_t, idx_t>
+    friend class HorizontalStencilBlock;
     std::array<idx_t, StencilWidth> i_begin_;
     idx_t j_begin_;
     idx_t k_begin_;
@@ -69,6 +76,34 @@ public:
     idx_t k_interval() const { return k_interval_; }
 };
 
+//-----------------------------------------------------------------------------
+
+/// @brief Horizontal stencils of a block of up to BlockSize points, stored as structure of arrays
+///
+/// Stencils of all points of a block are computed together (see ComputeHorizontalStencil), so that
+/// the computation vectorises over the points of the block.
+template <idx_t StencilWidth, idx_t BlockSize>
+class HorizontalStencilBlock {
+    friend class ComputeHorizontalStencil;
+    std::array<std::array<idx_t, BlockSize>, StencilWidth> i_begin_;
+    std::array<idx_t, BlockSize> j_begin_;
+
+public:
+    idx_t i( idx_t offset_i, idx_t offset_j, idx_t p ) const { return i_begin_[offset_j][p] + offset_i; }
+    idx_t j( idx_t offset, idx_t p ) const { return j_begin_[p] + offset; }
+    constexpr idx_t width() const { return StencilWidth; }
+    static constexpr idx_t capacity() { return BlockSize; }
+
+    /// Copy the horizontal stencil of point p of the block into a HorizontalStencil or Stencil3D
+    template <typename stencil_t>
+    void get( idx_t p, stencil_t& stencil ) const {
+        stencil.j_begin_ = j_begin_[p];
+        for ( idx_t jj = 0; jj < StencilWidth; ++jj ) {
+            stencil.i_begin_[jj] = i_begin_[jj][p];
+        }
+    }
+};
+
 //---------------------------------------------------------------------------------------------------------------------
 
 }  // namespace grid
@@ -94,6 +94,36 @@ ComputeWest::ComputeWest( const StructuredGrid& grid, idx_t halo ) {
     }
 }
 
+ComputeXY::ComputeXY( const StructuredGrid& grid, idx_t halo ) {
+    ATLAS_ASSERT( grid );
+    halo_                     = halo;
+    const idx_t ny            = grid.ny();
+    idx_t north_pole_included = 90. - grid.y( 0 ) == 0.;
+    idx_t south_pole_included = 90. + grid.y( ny - 1 ) == 0.;
+    ATLAS_ASSERT( halo_ < ny );
+    y_.resize( ny + 2 * halo_ );
+    xmin_.resize( ny + 2 * halo_ );
+    dx_.resize( ny + 2 * halo_ );
+    for ( idx_t j = -halo_; j < ny + halo_; ++j ) {
+        // same mapping of rows beyond the poles as in StructuredColumns::compute_xy
+        idx_t jj;
+        if ( j < 0 ) {
+            jj            = -j - 1 + north_pole_included;
+            y_[halo_ + j] = 180. - grid.y( jj );
+        }
+        else if ( j >= ny ) {
+            jj            = 2 * ny - j - 1 - south_pole_included;
+            y_[halo_ + j] = -180. - grid.y( jj );
+        }
+        else {
+            jj            = j;
+            y_[halo_ + j] = grid.y( jj );
+        }
+        xmin_[halo_ + j] = grid.xmin( jj );
+        dx_[halo_ + j]   = grid.dx( jj );
+    }
+}
+
 ComputeHorizontalStencil::ComputeHorizontalStencil( const StructuredGrid& grid, idx_t stencil_width ) :
     halo_( ( stencil_width + 1 ) / 2 ),
     compute_north_( grid, halo_ ),
@@ -10,11 +10,14 @@
 
 #pragma once
 
+#include <array>
 #include <cmath>
 #include <vector>
 
+#include "atlas/grid/Stencil.h"
 #include "atlas/grid/Vertical.h"
 #include "atlas/library/config.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 
 namespace atlas {
@@ -75,6 +78,26 @@ public:
 
         return j;
     }
+
+    /// Same as above for n points at once: j[p] = operator()( y[p] )
+    void operator()( idx_t n, const double y[], idx_t j[] ) const {
+        // First guess for all points, which vectorises, followed by the (short) search for each point
+        atlas_omp_pragma( omp simd )
+        for ( idx_t p = 0; p < n; ++p ) {
+            const idx_t jp = static_cast<idx_t>( std::floor( ( y_[halo_ + 0] - y[p] ) / dy_ ) );
+            j[p]           = std::max<idx_t>( halo_, std::min<idx_t>( jp, halo_ + ny_ - 1 ) );
+        }
+        for ( idx_t p = 0; p < n; ++p ) {
+            idx_t jp = j[p];
+            while ( y_[halo_ + jp] > y[p] ) {
+                ++jp;
+            }
+            do {
+                --jp;
+            } while ( y_[halo_ + jp] < y[p] );
+            j[p] = jp;
+        }
+    }
 };
 
 //-----------------------------------------------------------------------------
@@ -96,6 +119,38 @@ public:
         idx_t i  = static_cast<idx_t>( std::floor( ( x - xref[jj] ) / dx[jj] ) );
         return i;
     }
+
+    /// Same as above for n points at once: i[p] = operator()( x[p], j[p] )
+    void operator()( idx_t n, const double x[], const idx_t j[], idx_t i[] ) const {
+        atlas_omp_pragma( omp simd )
+        for ( idx_t p = 0; p < n; ++p ) {
+            const idx_t jj = halo_ + j[p];
+            i[p]           = static_cast<idx_t>( std::floor( ( x[p] - xref[jj] ) / dx[jj] ) );
+        }
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+/// @class ComputeXY
+/// @brief Coordinates of grid points given their (i,j) index, also for rows beyond the poles
+///
+/// Equivalent to functionspace::StructuredColumns::compute_xy, but with the rows tabulated so that
+/// it is inlined and can be used in vectorised loops.
+class ComputeXY {
+    std::vector<double> y_;
+    std::vector<double> xmin_;
+    std::vector<double> dx_;
+    idx_t halo_;
+
+public:
+    ComputeXY() = default;
+
+    ComputeXY( const StructuredGrid& grid, idx_t halo );
+
+    double x( idx_t i, idx_t j ) const { return xmin_[halo_ + j] + static_cast<double>( i ) * dx_[halo_ + j]; }
+
+    double y( idx_t j ) const { return y_[halo_ + j]; }
 };
 
 
@@ -145,6 +200,34 @@ public:
             stencil.i_begin_[jj] = compute_west_( x, stencil.j_begin_ + jj ) - stencil_begin_;
         }
     }
+
+    /// Compute the stencils of the first n points of the arrays x and y
+    template <idx_t StencilWidth, idx_t BlockSize>
+    void operator()( idx_t n, const double x[], const double y[],
+                     HorizontalStencilBlock<StencilWidth, BlockSize>& stencils ) const {
+#ifndef NDEBUG
+        ATLAS_ASSERT( n <= BlockSize && StencilWidth == stencil_width_ );
+#endif
+        auto& j_begin = stencils.j_begin_;
+        compute_north_( n, y, j_begin.data() );
+        atlas_omp_pragma( omp simd )
+        for ( idx_t p = 0; p < n; ++p ) {
+            j_begin[p] -= stencil_begin_;
+        }
+        std::array<idx_t, BlockSize> j;
+        for ( idx_t jj = 0; jj < StencilWidth; ++jj ) {
+            auto& i_begin = stencils.i_begin_[jj];
+            atlas_omp_pragma( omp simd )
+            for ( idx_t p = 0; p < n; ++p ) {
+                j[p] = j_begin[p] + jj;
+            }
+            compute_west_( n, x, j.data(), i_begin.data() );
+            atlas_omp_pragma( omp simd )
+            for ( idx_t p = 0; p < n; ++p ) {
+                i_begin[p] -= stencil_begin_;
+            }
+        }
+    }
 };
 
 
@@ -81,6 +81,33 @@ BandsDistribution<Int>::BandsDistribution( const atlas::Grid& grid, atlas::idx_t
     ATLAS_ASSERT( detectOverflow( gridsize, nb_partitions_Int_, blocksize_ ) == false );
 }
 
+template <typename Int>
+bool BandsDistribution<Int>::ranges( int partition, DistributionImpl::ranges_t& ranges ) const {
+    ranges.clear();
+    gidx_t b = begin( partition );
+    gidx_t e = begin( partition + 1 );
+    if ( b < e ) {
+        ranges.push_back( {b, e} );
+    }
+    return true;
+}
+
+template <typename Int>
+gidx_t BandsDistribution<Int>::begin( int partition ) const {
+    gidx_t lo = 0;
+    gidx_t hi = this->size_;
+    while ( lo < hi ) {
+        gidx_t mid = lo + ( hi - lo ) / 2;
+        if ( function( mid ) < partition ) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
 template <typename Int>
 bool BandsDistribution<Int>::detectOverflow( size_t gridsize, size_t nb_partitions, size_t blocksize ) {
     int64_t size                 = gridsize;
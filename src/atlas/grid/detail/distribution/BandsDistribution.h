@@ -34,7 +34,14 @@ public:
         return ( iblock * nb_partitions_Int_ ) / nb_blocks_;
     }
 
+    /// Partitions are increasing with the global index, so each owns a single range
+    bool ranges( int partition, DistributionImpl::ranges_t& ) const override;
+
     static bool detectOverflow( size_t gridsize, size_t nb_partitions, size_t blocksize );
+
+private:
+    /// First global index with partition not below given partition
+    gidx_t begin( int partition ) const;
 };
 
 
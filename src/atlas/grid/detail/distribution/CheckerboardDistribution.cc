@@ -0,0 +1,171 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "CheckerboardDistribution.h"
+
+#include <algorithm>
+
+#include "atlas/grid/StructuredGrid.h"
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace distribution {
+
+CheckerboardDistribution::CheckerboardDistribution( const Grid& grid, idx_t nb_partitions, idx_t nb_bands,
+                                                    const std::string& type ) :
+    DistributionFunctionT<CheckerboardDistribution>( grid ) {
+    const RegularGrid rg( grid );
+    ATLAS_ASSERT( rg, "CheckerboardDistribution requires a RegularGrid" );
+    ATLAS_ASSERT( nb_bands > 0 );
+
+    type_          = type;
+    size_          = grid.size();
+    nb_partitions_ = nb_partitions;
+    nx_            = rg.nx();
+
+    // Same number of partitions and grid points per band as CheckerboardPartitioner
+    const size_t nparts = nb_partitions;
+    const size_t nbands = nb_bands;
+    const size_t nnodes = size_;
+
+    std::vector<size_t> npartsb( nbands, nparts / nbands );
+    for ( size_t iband = 0; iband < nparts - ( nparts / nbands ) * nbands; iband++ ) {
+        ++npartsb[iband];
+    }
+    std::vector<size_t> ngpb( nbands );
+    size_t remainder = nnodes;
+    for ( size_t iband = 0; iband < nbands; iband++ ) {
+        ngpb[iband] = ( nnodes * npartsb[iband] ) / nparts;
+        remainder -= ngpb[iband];
+    }
+    for ( size_t iband = 0; iband < remainder; iband++ ) {
+        ++ngpb[iband];
+    }
+
+    band_begin_.reserve( nbands + 1 );
+    band_partition_.reserve( nbands + 1 );
+    nb_pts_.reserve( nb_partitions_ );
+    gidx_t begin = 0;
+    int part     = 0;
+    for ( size_t iband = 0; iband < nbands; iband++ ) {
+        band_begin_.emplace_back( begin );
+        band_partition_.emplace_back( part );
+        for ( size_t ipart = 0; ipart < npartsb[iband]; ++ipart, ++part ) {
+            nb_pts_.emplace_back( ngpb[iband] / npartsb[iband] + ( ipart < ngpb[iband] % npartsb[iband] ? 1 : 0 ) );
+        }
+        begin += ngpb[iband];
+    }
+    band_begin_.emplace_back( begin );
+    band_partition_.emplace_back( part );
+    ATLAS_ASSERT( begin == size_ );
+    ATLAS_ASSERT( part == nb_partitions_ );
+
+    max_pts_ = *std::max_element( nb_pts_.begin(), nb_pts_.end() );
+    min_pts_ = *std::min_element( nb_pts_.begin(), nb_pts_.end() );
+}
+
+int CheckerboardDistribution::function( gidx_t index ) const {
+    const int b    = band( index );
+    const idx_t j  = static_cast<idx_t>( index / nx_ );
+    const idx_t i  = static_cast<idx_t>( index - gidx_t( j ) * nx_ );
+    const gidx_t r = rank( b, i, j );
+
+    // The first "remainder" partitions of the band have one point more
+    const gidx_t band_size = band_begin_[b + 1] - band_begin_[b];
+    const gidx_t nparts    = band_partition_[b + 1] - band_partition_[b];
+    const gidx_t size      = band_size / nparts;
+    const gidx_t remainder = band_size - size * nparts;
+    if ( r < remainder * ( size + 1 ) ) {
+        return band_partition_[b] + static_cast<int>( r / ( size + 1 ) );
+    }
+    return band_partition_[b] + static_cast<int>( remainder + ( r - remainder * ( size + 1 ) ) / size );
+}
+
+bool CheckerboardDistribution::ranges( int partition, ranges_t& ranges ) const {
+    ranges.clear();
+    if ( partition < 0 || partition >= nb_partitions_ || nb_pts_[partition] == 0 ) {
+        return true;
+    }
+    auto next_band = std::upper_bound( band_partition_.begin(), band_partition_.end(), partition );
+    const int b    = static_cast<int>( next_band - band_partition_.begin() ) - 1;
+
+    const gidx_t band_size  = band_begin_[b + 1] - band_begin_[b];
+    const gidx_t nparts     = band_partition_[b + 1] - band_partition_[b];
+    const gidx_t size       = band_size / nparts;
+    const gidx_t remainder  = band_size - size * nparts;
+    const gidx_t sector     = partition - band_partition_[b];
+    const gidx_t rank_begin = sector * size + std::min( sector, remainder );
+    const gidx_t rank_end   = rank_begin + nb_pts_[partition];
+
+    const idx_t j0 = static_cast<idx_t>( band_begin_[b] / nx_ );
+    const idx_t i0 = static_cast<idx_t>( band_begin_[b] - gidx_t( j0 ) * nx_ );
+    const idx_t j1 = static_cast<idx_t>( ( band_begin_[b + 1] - 1 ) / nx_ );
+    const idx_t i1 = static_cast<idx_t>( ( band_begin_[b + 1] - 1 ) - gidx_t( j1 ) * nx_ );
+
+    // Within a row the rank increases with i
+    auto first_not_below = [&]( idx_t j, idx_t lo, idx_t hi, gidx_t r ) -> idx_t {
+        while ( lo < hi ) {
+            idx_t mid = lo + ( hi - lo ) / 2;
+            if ( rank( b, mid, j ) < r ) {
+                lo = mid + 1;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        return lo;
+    };
+
+    for ( idx_t j = j0; j <= j1; ++j ) {
+        const idx_t ibegin = ( j == j0 ? i0 : 0 );
+        const idx_t iend   = ( j == j1 ? i1 + 1 : nx_ );
+        const idx_t lo     = first_not_below( j, ibegin, iend, rank_begin );
+        const idx_t hi     = first_not_below( j, lo, iend, rank_end );
+        if ( lo < hi ) {
+            const gidx_t begin = gidx_t( j ) * nx_ + lo;
+            const gidx_t end   = gidx_t( j ) * nx_ + hi;
+            if ( not ranges.empty() && ranges.back().end == begin ) {
+                ranges.back().end = end;
+            }
+            else {
+                ranges.push_back( {begin, end} );
+            }
+        }
+    }
+    return true;
+}
+
+int CheckerboardDistribution::band( gidx_t index ) const {
+    auto next_band = std::upper_bound( band_begin_.begin(), band_begin_.end(), index );
+    return static_cast<int>( next_band - band_begin_.begin() ) - 1;
+}
+
+gidx_t CheckerboardDistribution::rank( int band, idx_t i, idx_t j ) const {
+    // Rank of point (i,j) within its band, sorted by column i, then row j.
+    // The band holds whole rows j0..j1, except for columns before i0 in row j0 and columns after i1 in row j1.
+    const idx_t j0 = static_cast<idx_t>( band_begin_[band] / nx_ );
+    const idx_t i0 = static_cast<idx_t>( band_begin_[band] - gidx_t( j0 ) * nx_ );
+    const idx_t j1 = static_cast<idx_t>( ( band_begin_[band + 1] - 1 ) / nx_ );
+    const idx_t i1 = static_cast<idx_t>( ( band_begin_[band + 1] - 1 ) - gidx_t( j1 ) * nx_ );
+
+    const gidx_t nrows = j1 - j0 + 1;
+    // points in columns west of i
+    const gidx_t west = gidx_t( i ) * nrows - std::min( i, i0 ) - std::max<idx_t>( 0, i - i1 - 1 );
+    // points in column i in rows before j
+    const gidx_t before = ( j - j0 ) - ( i < i0 ? 1 : 0 );
+    return west + before;
+}
+
+}  // namespace distribution
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
@@ -0,0 +1,51 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "atlas/grid/detail/distribution/DistributionFunction.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace distribution {
+
+/// @brief Functional equivalent of the DistributionArray created by the CheckerboardPartitioner for a RegularGrid
+///
+/// The partitioner splits the grid, in its natural order, into bands of consecutive points.
+/// Each band is then sorted by column (i) first and split into the partitions of that band.
+/// The rank of a point within this ordering follows from the band extents, so nothing is stored per grid point.
+class CheckerboardDistribution : public DistributionFunctionT<CheckerboardDistribution> {
+public:
+    CheckerboardDistribution( const Grid& grid, idx_t nb_partitions, idx_t nb_bands,
+                              const std::string& type = "checkerboard" );
+
+    int function( gidx_t index ) const;
+
+    /// In every row of the band a partition owns a single segment
+    bool ranges( int partition, ranges_t& ) const override;
+
+private:
+    int band( gidx_t index ) const;
+    gidx_t rank( int band, idx_t i, idx_t j ) const;
+
+private:
+    idx_t nx_;
+    std::vector<gidx_t> band_begin_;   // first global index of each band, size nb_bands+1
+    std::vector<int> band_partition_;  // first partition of each band, size nb_bands+1
+};
+
+}  // namespace distribution
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
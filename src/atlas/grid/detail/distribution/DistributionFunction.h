@@ -23,6 +23,7 @@ namespace distribution {
 
 class DistributionFunction : public DistributionImpl {
 public:
+    DistributionFunction() : DistributionImpl() {}
     DistributionFunction( const Grid& ) : DistributionImpl() {}
     bool functional() const override { return true; }
     size_t footprint() const override { return nb_pts_.size() * sizeof( nb_pts_[0] ); }
@@ -54,6 +55,7 @@ protected:
 template <typename Derived>
 class DistributionFunctionT : public DistributionFunction {
 public:
+    DistributionFunctionT() : DistributionFunction() {}
     DistributionFunctionT( const Grid& grid ) : DistributionFunction( grid ) {}
     ATLAS_ALWAYS_INLINE int partition( gidx_t index ) const override {
         return static_cast<const Derived*>( this )->function( index );
@@ -44,6 +44,14 @@ namespace grid {
 class DistributionImpl : public util::Object {
 public:
     using Config = atlas::util::Config;
+
+    /// @brief Range [begin, end) of global indices
+    struct Range {
+        gidx_t begin;
+        gidx_t end;
+    };
+    using ranges_t = std::vector<Range>;
+
     virtual ~DistributionImpl() {}
     virtual int partition( const gidx_t gidx ) const = 0;
     virtual bool functional() const                  = 0;
@@ -64,6 +72,10 @@ public:
     virtual void hash( eckit::Hash& ) const = 0;
 
     virtual void partition( gidx_t begin, gidx_t end, int partitions[] ) const = 0;
+
+    /// @brief Sorted global index ranges owned by given partition
+    /// @return false when this cannot be computed without visiting every grid point, leaving ranges untouched
+    virtual bool ranges( int /*partition*/, ranges_t& ) const { return false; }
 };
 
 
@@ -0,0 +1,258 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "EqualRegionsDistribution.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+#include "atlas/grid/Grid.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/MicroDeg.h"
+
+using atlas::util::microdeg;
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace distribution {
+
+namespace {
+// Same ordering as compare_WE_NS in EqualRegionsPartitioner: west to east, then north to south
+template <typename Key>
+bool compare_WE_NS( const Key& key1, const Key& key2 ) {
+    if ( key1.x < key2.x ) {
+        return true;
+    }
+    if ( key1.x == key2.x ) {
+        return ( key1.y > key2.y );
+    }
+    return false;
+}
+}  // namespace
+
+EqualRegionsDistribution::EqualRegionsDistribution( const Grid& grid, const std::vector<int>& regions_per_band,
+                                                    const std::string& type ) :
+    DistributionFunctionT<EqualRegionsDistribution>( grid ), grid_( grid ) {
+    ATLAS_TRACE( "EqualRegionsDistribution" );
+    ATLAS_ASSERT( grid_, "EqualRegionsDistribution requires a StructuredGrid" );
+
+    // The partitions are found from the grid structure, which must be ordered from north to south and west to east
+    ATLAS_ASSERT( grid_.y( 1 ) < grid_.y( 0 ) );
+    ATLAS_ASSERT( grid_.x( 1, 0 ) > grid_.x( 0, 0 ) );
+
+    type_          = type;
+    size_          = grid.size();
+    nb_partitions_ = 0;
+    for ( int regions : regions_per_band ) {
+        nb_partitions_ += regions;
+    }
+    ATLAS_ASSERT( nb_partitions_ > 0 );
+
+    // Same chunking as EqualRegionsPartitioner: consecutive partitions in consecutive bands,
+    // the first "remainder" partitions get one point more.
+    const idx_t nb_bands    = static_cast<idx_t>( regions_per_band.size() );
+    const gidx_t chunk_size = size_ / nb_partitions_;
+    const gidx_t remainder  = size_ - chunk_size * nb_partitions_;
+
+    nb_pts_.reserve( nb_partitions_ );
+    band_begin_.reserve( nb_bands + 1 );
+    band_partition_.reserve( nb_bands + 1 );
+    gidx_t end = 0;
+    int part   = 0;
+    for ( idx_t b = 0; b < nb_bands; ++b ) {
+        band_begin_.emplace_back( end );
+        band_partition_.emplace_back( part );
+        for ( int r = 0; r < regions_per_band[b]; ++r, ++part ) {
+            nb_pts_.emplace_back( chunk_size + ( part < remainder ? 1 : 0 ) );
+            end += nb_pts_.back();
+        }
+    }
+    band_begin_.emplace_back( end );
+    band_partition_.emplace_back( part );
+
+    // Partitions that are empty because there are fewer points than partitions start beyond any point
+    first_.assign( nb_partitions_, Key{std::numeric_limits<int>::max(), std::numeric_limits<int>::min()} );
+
+    atlas_omp_parallel_for( idx_t p = 0; p < nb_partitions_; ++p ) {
+        auto next_band = std::upper_bound( band_partition_.begin(), band_partition_.end(), p );
+        const int b    = static_cast<int>( next_band - band_partition_.begin() ) - 1;
+        const gidx_t k = p * chunk_size + std::min<gidx_t>( p, remainder ) - band_begin_[b];
+        if ( p != band_partition_[b] && k < band_begin_[b + 1] - band_begin_[b] ) {
+            first_[p] = select( b, k );
+        }
+    }
+
+    max_pts_ = *std::max_element( nb_pts_.begin(), nb_pts_.end() );
+    min_pts_ = *std::min_element( nb_pts_.begin(), nb_pts_.end() );
+}
+
+int EqualRegionsDistribution::function( gidx_t index ) const {
+    idx_t i, j;
+    grid_.index2ij( index, i, j );
+    return find( band( index ), key( i, j ) );
+}
+
+void EqualRegionsDistribution::partition( gidx_t begin, gidx_t end, int partitions[] ) const {
+    if ( begin >= end ) {
+        return;
+    }
+    idx_t i, j;
+    grid_.index2ij( begin, i, j );
+    int b    = band( begin );
+    idx_t nx = grid_.nx( j );
+    size_t c = 0;
+    for ( gidx_t n = begin; n < end; ++n, ++c ) {
+        while ( n >= band_begin_[b + 1] ) {
+            ++b;
+        }
+        partitions[c] = find( b, key( i, j ) );
+        if ( ++i == nx && n + 1 < end ) {
+            i  = 0;
+            nx = grid_.nx( ++j );
+        }
+    }
+}
+
+size_t EqualRegionsDistribution::footprint() const {
+    return nb_pts_.size() * sizeof( nb_pts_[0] ) + band_begin_.size() * sizeof( band_begin_[0] ) +
+           band_partition_.size() * sizeof( band_partition_[0] ) + first_.size() * sizeof( first_[0] );
+}
+
+EqualRegionsDistribution::Key EqualRegionsDistribution::key( idx_t i, idx_t j ) const {
+    return Key{microdeg( grid_.x( i, j ) ), microdeg( grid_.y( j ) )};
+}
+
+int EqualRegionsDistribution::band( gidx_t index ) const {
+    auto next_band = std::upper_bound( band_begin_.begin(), band_begin_.end(), index );
+    return static_cast<int>( next_band - band_begin_.begin() ) - 1;
+}
+
+int EqualRegionsDistribution::find( int band, const Key& key ) const {
+    auto begin = first_.begin() + band_partition_[band] + 1;
+    auto end   = first_.begin() + band_partition_[band + 1];
+    return band_partition_[band] + static_cast<int>( std::upper_bound( begin, end, key, compare_WE_NS<Key> ) - begin );
+}
+
+EqualRegionsDistribution::Key EqualRegionsDistribution::select( int band, gidx_t k ) const {
+    // Returns the k-th point of the band when sorted west to east, then north to south.
+    // The band covers whole rows, except possibly the first and last one. Within a row the points are sorted
+    // west to east, and rows are sorted north to south, so that counting points west of a longitude is a
+    // binary search per row.
+    idx_t i0, j0, i1, j1;
+    grid_.index2ij( band_begin_[band], i0, j0 );
+    grid_.index2ij( band_begin_[band + 1] - 1, i1, j1 );
+
+    auto ibegin = [&]( idx_t j ) -> idx_t { return j == j0 ? i0 : 0; };
+    auto iend   = [&]( idx_t j ) -> idx_t { return j == j1 ? i1 + 1 : grid_.nx( j ); };
+
+    // Number of points in row j of this band west of X, or west of and at X when inclusive
+    auto count_row = [&]( idx_t j, int X, bool inclusive ) -> gidx_t {
+        const Key key{X, inclusive ? std::numeric_limits<int>::min() : std::numeric_limits<int>::max()};
+        return count_less( j, ibegin( j ), iend( j ), key );
+    };
+    auto count = [&]( int X, bool inclusive ) -> gidx_t {
+        gidx_t c = 0;
+        for ( idx_t j = j0; j <= j1; ++j ) {
+            c += count_row( j, X, inclusive );
+        }
+        return c;
+    };
+
+    long xmin = std::numeric_limits<int>::max();
+    long xmax = std::numeric_limits<int>::min();
+    for ( idx_t j = j0; j <= j1; ++j ) {
+        xmin = std::min<long>( xmin, microdeg( grid_.x( ibegin( j ), j ) ) );
+        xmax = std::max<long>( xmax, microdeg( grid_.x( iend( j ) - 1, j ) ) );
+    }
+
+    // Smallest X with more than k points west of and at X: the longitude of the k-th point
+    while ( xmin < xmax ) {
+        long mid = xmin + ( xmax - xmin ) / 2;
+        if ( count( static_cast<int>( mid ), true ) > k ) {
+            xmax = mid;
+        }
+        else {
+            xmin = mid + 1;
+        }
+    }
+    const int X = static_cast<int>( xmin );
+
+    // Points at longitude X are ordered north to south, i.e. by row
+    gidx_t m = k - count( X, false );
+    for ( idx_t j = j0; j <= j1; ++j ) {
+        if ( count_row( j, X, true ) != count_row( j, X, false ) ) {
+            if ( m == 0 ) {
+                return Key{X, microdeg( grid_.y( j ) )};
+            }
+            --m;
+        }
+    }
+    throw_AssertionFailed( "Could not select point " + std::to_string( k ) + " of band " + std::to_string( band ),
+                           Here() );
+}
+
+idx_t EqualRegionsDistribution::count_less( idx_t j, idx_t ibegin, idx_t iend, const Key& key ) const {
+    idx_t lo = ibegin;
+    idx_t hi = iend;
+    while ( lo < hi ) {
+        idx_t mid = lo + ( hi - lo ) / 2;
+        if ( compare_WE_NS( this->key( mid, j ), key ) ) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo - ibegin;
+}
+
+bool EqualRegionsDistribution::ranges( int partition, ranges_t& ranges ) const {
+    // The points of a partition are those of its band between the first point of the partition and the first
+    // point of the next partition, which in every row of the band is a single segment.
+    ranges.clear();
+    if ( partition < 0 || partition >= nb_partitions_ || nb_pts_[partition] == 0 ) {
+        return true;
+    }
+    auto next_band   = std::upper_bound( band_partition_.begin(), band_partition_.end(), partition );
+    const int b      = static_cast<int>( next_band - band_partition_.begin() ) - 1;
+    const bool first = ( partition == band_partition_[b] );
+    const bool last  = ( partition + 1 == band_partition_[b + 1] );
+
+    idx_t i0, j0, i1, j1;
+    grid_.index2ij( band_begin_[b], i0, j0 );
+    grid_.index2ij( band_begin_[b + 1] - 1, i1, j1 );
+
+    for ( idx_t j = j0; j <= j1; ++j ) {
+        const idx_t ibegin = ( j == j0 ? i0 : 0 );
+        const idx_t iend   = ( j == j1 ? i1 + 1 : grid_.nx( j ) );
+        const idx_t lo     = first ? 0 : count_less( j, ibegin, iend, first_[partition] );
+        const idx_t hi     = last ? iend - ibegin : count_less( j, ibegin, iend, first_[partition + 1] );
+        if ( lo < hi ) {
+            const gidx_t begin = grid_.index( ibegin + lo, j );
+            const gidx_t end   = grid_.index( ibegin + hi - 1, j ) + 1;
+            if ( not ranges.empty() && ranges.back().end == begin ) {
+                ranges.back().end = end;
+            }
+            else {
+                ranges.push_back( {begin, end} );
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace distribution
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
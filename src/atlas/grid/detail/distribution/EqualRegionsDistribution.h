@@ -0,0 +1,70 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "atlas/grid/StructuredGrid.h"
+#include "atlas/grid/detail/distribution/DistributionFunction.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace distribution {
+
+/// @brief Functional equivalent of the DistributionArray created by the EqualRegionsPartitioner for a StructuredGrid
+///
+/// The partitioner splits the grid, in its north-to-south / west-to-east order, into bands of consecutive points.
+/// Each band is sorted west-to-east / north-to-south and split into the regions of that band.
+/// Rather than storing that result per grid point, only the first point (in microdegrees) of every partition is
+/// stored, so that partition(gidx) reduces to two binary searches.
+class EqualRegionsDistribution : public DistributionFunctionT<EqualRegionsDistribution> {
+public:
+    /// @param regions_per_band  number of regions in each band, as given by EqualRegionsPartitioner::nb_regions()
+    EqualRegionsDistribution( const Grid& grid, const std::vector<int>& regions_per_band,
+                              const std::string& type = "equal_regions" );
+
+    int function( gidx_t index ) const;
+
+    void partition( gidx_t begin, gidx_t end, int partitions[] ) const override;
+    using DistributionFunctionT<EqualRegionsDistribution>::partition;
+
+    /// In every row of the band a partition owns a single segment
+    bool ranges( int partition, ranges_t& ) const override;
+
+    size_t footprint() const override;
+
+private:
+    struct Key {
+        int x;
+        int y;
+    };
+
+    Key key( idx_t i, idx_t j ) const;
+    int band( gidx_t index ) const;
+    int find( int band, const Key& ) const;
+    Key select( int band, gidx_t k ) const;
+
+    /// Number of points i in [ibegin, iend) of row j that come before given key
+    idx_t count_less( idx_t j, idx_t ibegin, idx_t iend, const Key& ) const;
+
+private:
+    StructuredGrid grid_;
+    std::vector<gidx_t> band_begin_;   // first global index of each band, size nb_bands+1
+    std::vector<int> band_partition_;  // first partition of each band, size nb_bands+1
+    std::vector<Key> first_;           // key of the first point of each partition
+};
+
+}  // namespace distribution
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
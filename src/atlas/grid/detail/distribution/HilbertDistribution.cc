@@ -0,0 +1,100 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "HilbertDistribution.h"
+
+#include <algorithm>
+
+#include "atlas/grid/Iterator.h"
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace distribution {
+
+HilbertDistribution::HilbertDistribution( const Grid& grid, const util::Hilbert& hilbert,
+                                          const std::vector<Key>& first, const std::vector<idx_t>& nb_pts,
+                                          const std::string& type ) :
+    DistributionFunctionT<HilbertDistribution>( grid ),
+    grid_( grid ),
+    structured_( grid ),
+    unstructured_( grid ),
+    hilbert_( hilbert ),
+    first_( first ) {
+    ATLAS_ASSERT( first_.size() == nb_pts.size() );
+    ATLAS_ASSERT( not nb_pts.empty() );
+
+    type_          = type;
+    size_          = grid.size();
+    nb_partitions_ = static_cast<idx_t>( nb_pts.size() );
+    nb_pts_        = nb_pts;
+    max_pts_       = *std::max_element( nb_pts_.begin(), nb_pts_.end() );
+    min_pts_       = *std::min_element( nb_pts_.begin(), nb_pts_.end() );
+}
+
+int HilbertDistribution::function( gidx_t index ) const {
+    return find( Key{hilbert_( xy( index ) ), index} );
+}
+
+void HilbertDistribution::partition( gidx_t begin, gidx_t end, int partitions[] ) const {
+    if ( begin >= end ) {
+        return;
+    }
+    size_t c = 0;
+    if ( structured_ ) {
+        idx_t i, j;
+        structured_.index2ij( begin, i, j );
+        idx_t nx = structured_.nx( j );
+        for ( gidx_t n = begin; n < end; ++n, ++c ) {
+            partitions[c] = find( Key{hilbert_( structured_.xy( i, j ) ), n} );
+            if ( ++i == nx && n + 1 < end ) {
+                i  = 0;
+                nx = structured_.nx( ++j );
+            }
+        }
+    }
+    else if ( unstructured_ ) {
+        for ( gidx_t n = begin; n < end; ++n, ++c ) {
+            partitions[c] = find( Key{hilbert_( unstructured_.xy( n ) ), n} );
+        }
+    }
+    else {
+        auto point = grid_.xy().begin() + begin;
+        for ( gidx_t n = begin; n < end; ++n, ++c, ++point ) {
+            partitions[c] = find( Key{hilbert_( *point ), n} );
+        }
+    }
+}
+
+size_t HilbertDistribution::footprint() const {
+    return nb_pts_.size() * sizeof( nb_pts_[0] ) + first_.size() * sizeof( first_[0] );
+}
+
+int HilbertDistribution::find( const Key& key ) const {
+    return static_cast<int>( std::upper_bound( first_.begin() + 1, first_.end(), key ) - first_.begin() ) - 1;
+}
+
+PointXY HilbertDistribution::xy( gidx_t index ) const {
+    if ( structured_ ) {
+        idx_t i, j;
+        structured_.index2ij( index, i, j );
+        return structured_.xy( i, j );
+    }
+    if ( unstructured_ ) {
+        return unstructured_.xy( index );
+    }
+    return *( grid_.xy().begin() + index );
+}
+
+}  // namespace distribution
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
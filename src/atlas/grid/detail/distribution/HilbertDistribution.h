@@ -0,0 +1,68 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "atlas/grid/Grid.h"
+#include "atlas/grid/StructuredGrid.h"
+#include "atlas/grid/UnstructuredGrid.h"
+#include "atlas/grid/detail/distribution/DistributionFunction.h"
+#include "atlas/util/Hilbert.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace distribution {
+
+/// @brief Functional equivalent of the DistributionArray created by the HilbertPartitioner
+///
+/// The points of the grid are ordered along a Hilbert space-filling curve, with ties broken by global index,
+/// and this order is split into consecutive pieces. Only the first point (curve key and global index) of every
+/// partition is stored, so that partition(gidx) reduces to computing the curve key of the point and a binary search.
+class HilbertDistribution : public DistributionFunctionT<HilbertDistribution> {
+public:
+    /// Position along the curve: Hilbert key, then global index
+    using Key = std::pair<gidx_t, gidx_t>;
+
+    /// @param hilbert  curve used to order the points
+    /// @param first    first key of every partition, keys beyond any point for empty partitions
+    /// @param nb_pts   number of points of every partition
+    HilbertDistribution( const Grid& grid, const util::Hilbert& hilbert, const std::vector<Key>& first,
+                         const std::vector<idx_t>& nb_pts, const std::string& type = "hilbert" );
+
+    int function( gidx_t index ) const;
+
+    void partition( gidx_t begin, gidx_t end, int partitions[] ) const override;
+    using DistributionFunctionT<HilbertDistribution>::partition;
+
+    size_t footprint() const override;
+
+    /// Partition of the point at given position along the curve
+    int find( const Key& ) const;
+
+private:
+    PointXY xy( gidx_t index ) const;
+
+private:
+    Grid grid_;
+    StructuredGrid structured_;
+    UnstructuredGrid unstructured_;
+    util::Hilbert hilbert_;
+    std::vector<Key> first_;  // key of the first point of each partition
+};
+
+}  // namespace distribution
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
@@ -0,0 +1,70 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "RunLengthDistribution.h"
+
+#include <algorithm>
+
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace distribution {
+
+RunLengthDistribution::RunLengthDistribution( gidx_t size, idx_t nb_partitions, std::vector<gidx_t>&& run_begin,
+                                              std::vector<int>&& run_partition, const std::string& type ) :
+    DistributionFunctionT<RunLengthDistribution>(),
+    run_begin_( std::move( run_begin ) ),
+    run_partition_( std::move( run_partition ) ) {
+    ATLAS_ASSERT( run_begin_.size() == run_partition_.size() );
+    ATLAS_ASSERT( size == 0 || ( run_begin_.size() && run_begin_.front() == 0 ) );
+    ATLAS_ASSERT( std::is_sorted( run_begin_.begin(), run_begin_.end() ) );
+
+    type_          = type;
+    size_          = size;
+    nb_partitions_ = nb_partitions;
+    nb_pts_.assign( nb_partitions_, 0 );
+    const size_t nb_runs = run_begin_.size();
+    for ( size_t r = 0; r < nb_runs; ++r ) {
+        const gidx_t end = ( r + 1 < nb_runs ) ? run_begin_[r + 1] : size_;
+        ATLAS_ASSERT( run_partition_[r] >= 0 && run_partition_[r] < nb_partitions_ );
+        nb_pts_[run_partition_[r]] += static_cast<idx_t>( end - run_begin_[r] );
+    }
+    max_pts_ = *std::max_element( nb_pts_.begin(), nb_pts_.end() );
+    min_pts_ = *std::min_element( nb_pts_.begin(), nb_pts_.end() );
+}
+
+bool RunLengthDistribution::ranges( int partition, ranges_t& ranges ) const {
+    ranges.clear();
+    const size_t nb_runs = run_begin_.size();
+    for ( size_t r = 0; r < nb_runs; ++r ) {
+        if ( run_partition_[r] == partition ) {
+            const gidx_t end = ( r + 1 < nb_runs ) ? run_begin_[r + 1] : size_;
+            if ( not ranges.empty() && ranges.back().end == run_begin_[r] ) {
+                ranges.back().end = end;
+            }
+            else {
+                ranges.push_back( {run_begin_[r], end} );
+            }
+        }
+    }
+    return true;
+}
+
+size_t RunLengthDistribution::footprint() const {
+    return nb_pts_.size() * sizeof( nb_pts_[0] ) + run_begin_.size() * sizeof( run_begin_[0] ) +
+           run_partition_.size() * sizeof( run_partition_[0] );
+}
+
+}  // namespace distribution
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
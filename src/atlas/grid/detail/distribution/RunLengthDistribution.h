@@ -0,0 +1,52 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "atlas/grid/detail/distribution/DistributionFunction.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace distribution {
+
+/// @brief Distribution given by runs of consecutive global indices in the same partition
+///
+/// This is how grid::Distribution::encode() stores any distribution. Only the first global index and the partition
+/// of every run are kept, so that partition(gidx) is a binary search, and ranges() visits the runs only.
+class RunLengthDistribution : public DistributionFunctionT<RunLengthDistribution> {
+public:
+    /// @param run_begin      first global index of every run, increasing and starting with 0
+    /// @param run_partition  partition of every run
+    RunLengthDistribution( gidx_t size, idx_t nb_partitions, std::vector<gidx_t>&& run_begin,
+                           std::vector<int>&& run_partition, const std::string& type );
+
+    int function( gidx_t index ) const {
+        auto next = std::upper_bound( run_begin_.begin(), run_begin_.end(), index );
+        return run_partition_[( next - run_begin_.begin() ) - 1];
+    }
+
+    bool ranges( int partition, ranges_t& ) const override;
+
+    size_t footprint() const override;
+
+private:
+    std::vector<gidx_t> run_begin_;   // first global index of each run
+    std::vector<int> run_partition_;  // partition of each run
+};
+
+}  // namespace distribution
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
@@ -29,6 +29,14 @@ SerialDistribution::SerialDistribution( const Grid& grid ) : DistributionFunctio
     min_pts_ = *std::min_element( nb_pts_.begin(), nb_pts_.end() );
 }
 
+bool SerialDistribution::ranges( int partition, ranges_t& ranges ) const {
+    ranges.clear();
+    if ( partition == 0 && size_ > 0 ) {
+        ranges.push_back( {0, size_} );
+    }
+    return true;
+}
+
 }  // namespace distribution
 }  // namespace detail
 }  // namespace grid
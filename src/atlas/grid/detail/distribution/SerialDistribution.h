@@ -23,6 +23,8 @@ public:
     SerialDistribution( const Grid& grid );
 
     ATLAS_ALWAYS_INLINE int function( gidx_t gidx ) const { return 0; }
+
+    bool ranges( int partition, ranges_t& ) const override;
 };
 
 }  // namespace distribution
@@ -0,0 +1,56 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "WeightedBandsDistribution.h"
+
+#include <algorithm>
+
+#include "atlas/grid/Grid.h"
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace distribution {
+
+WeightedBandsDistribution::WeightedBandsDistribution( const Grid& grid, const std::vector<gidx_t>& begin,
+                                                      const std::string& type ) :
+    DistributionFunctionT<WeightedBandsDistribution>( grid ), begin_( begin ) {
+    ATLAS_ASSERT( begin_.size() > 1 );
+    ATLAS_ASSERT( begin_.front() == 0 && begin_.back() == grid.size() );
+    ATLAS_ASSERT( std::is_sorted( begin_.begin(), begin_.end() ) );
+
+    type_          = type;
+    size_          = grid.size();
+    nb_partitions_ = static_cast<idx_t>( begin_.size() ) - 1;
+    nb_pts_.reserve( nb_partitions_ );
+    for ( idx_t p = 0; p < nb_partitions_; ++p ) {
+        nb_pts_.emplace_back( begin_[p + 1] - begin_[p] );
+    }
+    max_pts_ = *std::max_element( nb_pts_.begin(), nb_pts_.end() );
+    min_pts_ = *std::min_element( nb_pts_.begin(), nb_pts_.end() );
+}
+
+bool WeightedBandsDistribution::ranges( int partition, ranges_t& ranges ) const {
+    ranges.clear();
+    if ( partition >= 0 && partition < nb_partitions_ && begin_[partition] < begin_[partition + 1] ) {
+        ranges.push_back( {begin_[partition], begin_[partition + 1]} );
+    }
+    return true;
+}
+
+size_t WeightedBandsDistribution::footprint() const {
+    return nb_pts_.size() * sizeof( nb_pts_[0] ) + begin_.size() * sizeof( begin_[0] );
+}
+
+}  // namespace distribution
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
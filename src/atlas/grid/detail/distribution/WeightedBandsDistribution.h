@@ -0,0 +1,49 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "atlas/grid/detail/distribution/DistributionFunction.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace distribution {
+
+/// @brief Bands of consecutive global indices with explicitly given extents
+///
+/// Created by the BandsPartitioner when weights are given, in which case the bands have equal total weight
+/// rather than equal number of points.
+class WeightedBandsDistribution : public DistributionFunctionT<WeightedBandsDistribution> {
+public:
+    /// @param begin  first global index of every partition, size nb_partitions+1, ending with grid.size()
+    WeightedBandsDistribution( const Grid& grid, const std::vector<gidx_t>& begin, const std::string& type );
+
+    int function( gidx_t index ) const {
+        auto next = std::upper_bound( begin_.begin() + 1, begin_.end() - 1, index );
+        return static_cast<int>( next - begin_.begin() ) - 1;
+    }
+
+    bool ranges( int partition, ranges_t& ) const override;
+
+    size_t footprint() const override;
+
+private:
+    std::vector<gidx_t> begin_;  // first global index of each partition, size nb_partitions+1
+};
+
+}  // namespace distribution
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
@@ -11,11 +11,17 @@
 
 #include "BandsPartitioner.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <numeric>
 
 #include "atlas/grid/StructuredGrid.h"
 #include "atlas/grid/detail/distribution/BandsDistribution.h"
+#include "atlas/grid/detail/distribution/WeightedBandsDistribution.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Trace.h"
 
 namespace atlas {
 namespace grid {
@@ -37,7 +43,66 @@ BandsPartitioner::BandsPartitioner() : Partitioner(), blocksize_{1} {}
 
 BandsPartitioner::BandsPartitioner( int N, int blocksize ) : Partitioner( N ), blocksize_( blocksize ) {}
 
+std::vector<gidx_t> BandsPartitioner::weighted_begin( const Grid& grid ) const {
+    ATLAS_TRACE( "BandsPartitioner::weighted_begin" );
+
+    const auto& comm       = mpi::comm();
+    const int mpi_rank     = static_cast<int>( comm.rank() );
+    const int mpi_size     = static_cast<int>( comm.size() );
+    const idx_t N          = nb_partitions();
+    const gidx_t size      = grid.size();
+    const gidx_t bsize     = blocksize( grid );
+    const gidx_t nb_blocks = ( size + bsize - 1 ) / bsize;
+
+    // Every MPI rank sums the weights of a contiguous range of blocks
+    const gidx_t w_begin = ( mpi_rank * nb_blocks ) / mpi_size;
+    const gidx_t w_end   = ( ( mpi_rank + 1 ) * nb_blocks ) / mpi_size;
+    std::vector<double> block_weight( w_end - w_begin );
+    atlas_omp_parallel_for( gidx_t b = w_begin; b < w_end; ++b ) {
+        double w = 0.;
+        for ( gidx_t n = b * bsize; n < std::min( ( b + 1 ) * bsize, size ); ++n ) {
+            w += weights()( n );
+        }
+        block_weight[b - w_begin] = w;
+    }
+
+    std::vector<double> w_total( mpi_size );
+    ATLAS_TRACE_MPI( ALLGATHER ) {
+        comm.allGather( std::accumulate( block_weight.begin(), block_weight.end(), 0. ), w_total.begin(),
+                        w_total.end() );
+    }
+    // Cumulative weight before the blocks of every MPI rank, identical on all ranks
+    std::vector<double> w_before( mpi_size + 1, 0. );
+    for ( int w = 0; w < mpi_size; ++w ) {
+        w_before[w + 1] = w_before[w] + w_total[w];
+    }
+    const double total = w_before[mpi_size];
+    ATLAS_ASSERT( total > 0., "Sum of weights must be positive" );
+
+    // Partition p starts at the first block with cumulative weight, including the block, above p * total / N.
+    // This MPI rank finds the partitions with that target in its range of cumulative weights.
+    std::vector<gidx_t> begin( N + 1, size );
+    begin[0] = 0;
+    idx_t p  = 1;
+    while ( p < N && double( p ) * total / double( N ) < w_before[mpi_rank] ) {
+        ++p;
+    }
+    double cumulative = w_before[mpi_rank];
+    for ( gidx_t b = w_begin; b < w_end; ++b ) {
+        cumulative += block_weight[b - w_begin];
+        while ( p < N && double( p ) * total / double( N ) < w_before[mpi_rank + 1] &&
+                ( cumulative > double( p ) * total / double( N ) || b + 1 == w_end ) ) {
+            begin[p++] = b * bsize;
+        }
+    }
+    ATLAS_TRACE_MPI( ALLREDUCE ) { comm.allReduceInPlace( begin.data(), begin.size(), eckit::mpi::min() ); }
+    return begin;
+}
+
 Distribution BandsPartitioner::partition( const Partitioner::Grid& grid ) const {
+    if ( weighted() ) {
+        return Distribution{new distribution::WeightedBandsDistribution{grid, weighted_begin( grid ), type()}};
+    }
     if ( not distribution::BandsDistribution<int32_t>::detectOverflow( grid.size(), nb_partitions(),
                                                                        blocksize( ( grid ) ) ) ) {
         return Distribution{
@@ -51,8 +116,12 @@ Distribution BandsPartitioner::partition( const Partitioner::Grid& grid ) const
 
 void BandsPartitioner::partition( const Partitioner::Grid& grid, int part[] ) const {
     gidx_t gridsize = grid.size();
-    if ( not distribution::BandsDistribution<int32_t>::detectOverflow( grid.size(), nb_partitions(),
-                                                                       blocksize( ( grid ) ) ) ) {
+    if ( weighted() ) {
+        distribution::WeightedBandsDistribution distribution{grid, weighted_begin( grid ), type()};
+        atlas_omp_parallel_for( gidx_t n = 0; n < gridsize; ++n ) { part[n] = distribution.function( n ); }
+    }
+    else if ( not distribution::BandsDistribution<int32_t>::detectOverflow( grid.size(), nb_partitions(),
+                                                                            blocksize( ( grid ) ) ) ) {
         distribution::BandsDistribution<int32_t> distribution{grid, nb_partitions(), type(), blocksize( grid )};
         for ( gidx_t n = 0; n < gridsize; ++n ) {
             part[n] = distribution.function( n );
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "atlas/grid/detail/partitioner/Partitioner.h"
 
 #include "atlas/grid/Distribution.h"
@@ -31,6 +33,9 @@ private:
 
     size_t blocksize( const Grid& grid ) const;
 
+    /// First global index of every partition, for bands of blocks with equal total weight
+    std::vector<gidx_t> weighted_begin( const Grid& grid ) const;
+
 protected:
     static constexpr int BLOCKSIZE_NX{-1};
 
@@ -47,6 +52,8 @@ public:
     Distribution partition( const Grid& grid ) const override;
 
     void partition( const Grid& grid, int part[] ) const override;
+
+    bool weightable() const override { return true; }
 };
 
 }  // namespace partitioner
@@ -19,7 +19,10 @@
 #include <vector>
 
 
+#include "atlas/grid/Distribution.h"
 #include "atlas/grid/StructuredGrid.h"
+#include "atlas/grid/detail/distribution/CheckerboardDistribution.h"
+#include "atlas/grid/detail/distribution/SerialDistribution.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/util/MicroDeg.h"
@@ -215,6 +218,14 @@ std::cout << std::endl;
     }
 }
 
+Distribution CheckerboardPartitioner::partition( const Grid& grid ) const {
+    if ( nb_partitions() == 1 ) {
+        return Distribution{new distribution::SerialDistribution{grid}};
+    }
+    auto cb = checkerboard( grid );
+    return Distribution{new distribution::CheckerboardDistribution{grid, nb_partitions(), cb.nbands, type()}};
+}
+
 void CheckerboardPartitioner::partition( const Grid& grid, int part[] ) const {
     if ( nb_partitions() == 1 )  // trivial solution, so much faster
     {
@@ -40,6 +40,9 @@ public:
 
     virtual std::string type() const { return "checkerboard"; }
 
+    /// Returns a functional CheckerboardDistribution, giving the same partitions as partition( grid, part[] )
+    virtual Distribution partition( const Grid& ) const;
+
 private:
     struct Checkerboard {
         idx_t nbands;  // number of bands
@@ -52,7 +55,6 @@ private:
     // algorithm is used internally
     void partition( const Checkerboard& cb, int nb_nodes, NodeInt nodes[], int part[] ) const;
 
-    using Partitioner::partition;
     virtual void partition( const Grid&, int part[] ) const;
 
     void check() const;
@@ -11,14 +11,18 @@
 #include "atlas/grid/detail/partitioner/EqualRegionsPartitioner.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <ctime>
 #include <functional>
 #include <iostream>
 #include <vector>
 
+#include "atlas/grid/Distribution.h"
 #include "atlas/grid/Iterator.h"
 #include "atlas/grid/StructuredGrid.h"
+#include "atlas/grid/detail/distribution/EqualRegionsDistribution.h"
 #include "atlas/parallel/mpi/Buffer.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/parallel/omp/sort.h"
@@ -453,6 +457,7 @@ EqualRegionsPartitioner::EqualRegionsPartitioner( int N ) : Partitioner( N ), N_
 
 EqualRegionsPartitioner::EqualRegionsPartitioner( int N, const eckit::Parametrisation& config ) :
     Partitioner( N ), N_( N ) {
+    config.get( "distributed_sort", distributed_sort_ );
     init();
 }
 
@@ -585,10 +590,25 @@ void EqualRegionsPartitioner::partition( int nb_nodes, NodeInt nodes[], int part
     // ((double)CLOCKS_PER_SEC) << "s)" << std::endl;
 }
 
+Distribution EqualRegionsPartitioner::partition( const Grid& grid ) const {
+    if ( StructuredGrid( grid ) && not weighted() ) {
+        ATLAS_ASSERT( grid.projection().units() == "degrees" );
+        std::vector<int> regions_per_band( nb_bands() );
+        for ( int band = 0; band < nb_bands(); ++band ) {
+            regions_per_band[band] = nb_regions( band );
+        }
+        return Distribution{new distribution::EqualRegionsDistribution{grid, regions_per_band, type()}};
+    }
+    return Partitioner::partition( grid );
+}
+
 void EqualRegionsPartitioner::partition( const Grid& grid, int part[] ) const {
     if ( N_ == 1 ) {  // trivial solution, so much faster
         atlas_omp_parallel_for( idx_t j = 0; j < grid.size(); ++j ) { part[j] = 0; }
     }
+    else if ( distributed_sort_ || weighted() ) {
+        partition_distributed( grid, part );
+    }
     else {
         ATLAS_TRACE( "EqualRegionsPartitioner::partition" );
 
@@ -917,6 +937,265 @@ void EqualRegionsPartitioner::partition( const Grid& grid, int part[] ) const {
     }      // else
 }
 
+namespace {
+
+// Sort key with three integer components, compared lexicographically
+using SortKey = std::array<std::int64_t, 3>;
+
+// Key of a node in north-to-south, then west-to-east order (compare_NS_WE), ties broken by global index
+SortKey key_NS_WE( const EqualRegionsPartitioner::NodeInt& node ) {
+    return SortKey{{-std::int64_t( node.y ), std::int64_t( node.x ), std::int64_t( node.n )}};
+}
+
+// Key of a node in west-to-east, then north-to-south order (compare_WE_NS), ties broken by global index
+SortKey key_WE_NS( const EqualRegionsPartitioner::NodeInt& node ) {
+    return SortKey{{std::int64_t( node.x ), -std::int64_t( node.y ), std::int64_t( node.n )}};
+}
+
+// Distributed selection of weighted order statistics.
+// Each MPI rank holds its own part of every group, sorted in keys[begin[q]:end[q]], with the weight of the first i
+// keys in cumulative[i], or unit weights when cumulative is empty. For every query q this returns the first key of
+// its group for which the weight of the keys up to and including it, over all MPI ranks, is above target[q].
+// Without weights this is the key with global rank target[q] within its group. The components of the key are fixed
+// one after the other by bisection, with a single allreduce of the weights of all queries per bisection step.
+std::vector<SortKey> select_keys( const std::vector<SortKey>& keys, const std::vector<double>& cumulative,
+                                  const std::vector<size_t>& begin, const std::vector<size_t>& end,
+                                  const std::vector<double>& target, const mpi::Comm& comm ) {
+    // All components are 32-bit integers, or their negation
+    constexpr std::int64_t lowest  = -( std::int64_t( 1 ) << 31 ) - 1;
+    constexpr std::int64_t highest = ( std::int64_t( 1 ) << 31 );
+
+    const size_t nb_queries = target.size();
+    std::vector<SortKey> selected( nb_queries );
+    std::vector<std::int64_t> lo( nb_queries );
+    std::vector<std::int64_t> hi( nb_queries );
+    std::vector<double> weight( nb_queries );
+
+    for ( size_t c = 0; c < 3; ++c ) {
+        // Invariant: weight( lo ) <= target < weight( hi ), with weight( v ) the weight of the keys in the group with
+        // components before c equal to the selected ones and component c not above v, or with smaller components
+        // before c.
+        std::fill( lo.begin(), lo.end(), lowest );
+        std::fill( hi.begin(), hi.end(), highest );
+        while ( true ) {
+            bool converged = true;
+            for ( size_t q = 0; q < nb_queries; ++q ) {
+                converged = converged && ( hi[q] - lo[q] <= 1 );
+            }
+            if ( converged ) {
+                break;
+            }
+            atlas_omp_parallel_for( size_t q = 0; q < nb_queries; ++q ) {
+                weight[q] = 0.;
+                if ( hi[q] - lo[q] > 1 ) {
+                    SortKey bound = selected[q];
+                    bound[c]      = lo[q] + ( hi[q] - lo[q] ) / 2;
+                    for ( size_t d = c + 1; d < 3; ++d ) {
+                        bound[d] = std::numeric_limits<std::int64_t>::max();
+                    }
+                    const size_t upper =
+                        std::upper_bound( keys.begin() + begin[q], keys.begin() + end[q], bound ) - keys.begin();
+                    weight[q] = cumulative.empty() ? double( upper - begin[q] )
+                                                   : cumulative[upper] - cumulative[begin[q]];
+                }
+            }
+            ATLAS_TRACE_MPI( ALLREDUCE ) { comm.allReduceInPlace( weight.data(), nb_queries, eckit::mpi::sum() ); }
+            for ( size_t q = 0; q < nb_queries; ++q ) {
+                if ( hi[q] - lo[q] > 1 ) {
+                    std::int64_t mid = lo[q] + ( hi[q] - lo[q] ) / 2;
+                    if ( weight[q] > target[q] ) {
+                        hi[q] = mid;
+                    }
+                    else {
+                        lo[q] = mid;
+                    }
+                }
+            }
+        }
+        for ( size_t q = 0; q < nb_queries; ++q ) {
+            selected[q][c] = hi[q];
+        }
+    }
+    return selected;
+}
+
+// Weight of the first i keys in cumulative[i], with the global index of a node as last key component
+std::vector<double> cumulative_weights( const std::vector<SortKey>& keys, const Partitioner::Weights& weights ) {
+    std::vector<double> cumulative( keys.size() + 1, 0. );
+    for ( size_t n = 0; n < keys.size(); ++n ) {
+        cumulative[n + 1] = cumulative[n] + weights( keys[n][2] );
+    }
+    return cumulative;
+}
+
+}  // namespace
+
+void EqualRegionsPartitioner::partition_distributed( const Grid& grid, int part[] ) const {
+    ATLAS_TRACE( "EqualRegionsPartitioner::partition_distributed" );
+
+    ATLAS_ASSERT( grid.projection().units() == "degrees" );
+
+    const auto& comm      = mpi::comm();
+    const int mpi_rank    = static_cast<int>( comm.rank() );
+    const int mpi_size    = static_cast<int>( comm.size() );
+    const gidx_t nb_nodes = grid.size();
+    ATLAS_ASSERT( valid_mpi_size( nb_nodes ) );
+
+    // Every MPI rank handles a contiguous slice of the grid
+    std::vector<int> w_count( mpi_size );
+    std::vector<int> w_displs( mpi_size );
+    for ( int w = 0; w < mpi_size; ++w ) {
+        w_displs[w] = static_cast<int>( ( w * nb_nodes ) / mpi_size );
+        w_count[w]  = static_cast<int>( ( ( w + 1 ) * nb_nodes ) / mpi_size ) - w_displs[w];
+    }
+    const gidx_t w_begin = w_displs[mpi_rank];
+    const size_t w_size  = w_count[mpi_rank];
+
+    atlas::vector<NodeInt> nodes( w_size );
+    ATLAS_TRACE_SCOPE( "create local nodes" ) {
+        if ( StructuredGrid structured_grid = StructuredGrid( grid ) ) {
+            if ( w_size > 0 ) {
+                idx_t i, j;
+                structured_grid.index2ij( w_begin, i, j );
+                for ( size_t n = 0; n < w_size; ++n ) {
+                    nodes[n].x = microdeg( structured_grid.x( i, j ) );
+                    nodes[n].y = microdeg( structured_grid.y( j ) );
+                    nodes[n].n = static_cast<int>( w_begin + n );
+                    if ( ++i == structured_grid.nx( j ) && n + 1 < w_size ) {
+                        i = 0;
+                        ++j;
+                    }
+                }
+            }
+        }
+        else {
+            auto point = grid.xy().begin() + w_begin;
+            for ( size_t n = 0; n < w_size; ++n, ++point ) {
+                nodes[n].x = microdeg( ( *point ).x() );
+                nodes[n].y = microdeg( ( *point ).y() );
+                nodes[n].n = static_cast<int>( w_begin + n );
+            }
+        }
+    }
+
+    // Without weights, same partition sizes as partition( nb_nodes, nodes, part ). With weights, equal weight per
+    // partition. Consecutive partitions are in consecutive bands.
+    double total = nb_nodes;
+    if ( weighted() ) {
+        total = 0.;
+        for ( size_t n = 0; n < w_size; ++n ) {
+            total += weights()( nodes[n].n );
+        }
+        ATLAS_TRACE_MPI( ALLREDUCE ) { comm.allReduceInPlace( total, eckit::mpi::sum() ); }
+        ATLAS_ASSERT( total > 0., "Sum of weights must be positive" );
+    }
+    const gidx_t chunk_size      = nb_nodes / N_;
+    const gidx_t chunk_remainder = nb_nodes - chunk_size * N_;
+    std::vector<double> displs( N_ + 1 );
+    std::vector<double> b_displs( nb_bands() + 1 );
+    std::vector<int> b_partition( nb_bands() + 1 );
+    {
+        int p = 0;
+        for ( int band = 0; band < nb_bands(); ++band ) {
+            b_displs[band]    = displs[p];
+            b_partition[band] = p;
+            for ( int r = 0; r < nb_regions( band ); ++r, ++p ) {
+                displs[p + 1] = weighted() ? double( p + 1 ) * total / double( N_ )
+                                           : displs[p] + double( chunk_size + ( p < chunk_remainder ? 1 : 0 ) );
+            }
+        }
+        b_displs[nb_bands()]    = displs[p];
+        b_partition[nb_bands()] = p;
+    }
+    const SortKey beyond{{std::numeric_limits<std::int64_t>::max(), 0, 0}};
+
+    // Bands: the first key of every band but the first, in north-to-south order
+    std::vector<SortKey> band_first;
+    ATLAS_TRACE_SCOPE( "select bands" ) {
+        std::vector<SortKey> keys( w_size );
+        atlas_omp_parallel_for( size_t n = 0; n < w_size; ++n ) { keys[n] = key_NS_WE( nodes[n] ); }
+        omp::sort( keys.begin(), keys.end(), std::less<SortKey>() );
+        std::vector<double> cumulative = weighted() ? cumulative_weights( keys, weights() ) : std::vector<double>();
+
+        std::vector<size_t> begin;
+        std::vector<size_t> end;
+        std::vector<double> target;
+        for ( int band = 1; band < nb_bands(); ++band ) {
+            if ( b_displs[band] < total ) {
+                begin.emplace_back( 0 );
+                end.emplace_back( w_size );
+                target.emplace_back( b_displs[band] );
+            }
+        }
+        band_first = select_keys( keys, cumulative, begin, end, target, comm );
+        band_first.resize( nb_bands() - 1, beyond );
+    }
+
+    // Regions: group local nodes per band, and find the first key of every partition but the first of each band,
+    // in west-to-east order
+    std::vector<SortKey> keys( w_size );
+    std::vector<size_t> b_begin( nb_bands() + 1, 0 );
+    std::vector<SortKey> partition_first( N_, beyond );
+    ATLAS_TRACE_SCOPE( "select regions" ) {
+        std::vector<int> node_band( w_size );
+        atlas_omp_parallel_for( size_t n = 0; n < w_size; ++n ) {
+            node_band[n] = static_cast<int>(
+                std::upper_bound( band_first.begin(), band_first.end(), key_NS_WE( nodes[n] ) ) - band_first.begin() );
+        }
+        for ( size_t n = 0; n < w_size; ++n ) {
+            ++b_begin[node_band[n] + 1];
+        }
+        for ( int band = 0; band < nb_bands(); ++band ) {
+            b_begin[band + 1] += b_begin[band];
+        }
+        {
+            std::vector<size_t> b_fill( b_begin.begin(), b_begin.end() - 1 );
+            for ( size_t n = 0; n < w_size; ++n ) {
+                keys[b_fill[node_band[n]]++] = key_WE_NS( nodes[n] );
+            }
+        }
+        atlas_omp_parallel_for( int band = 0; band < nb_bands(); ++band ) {
+            std::sort( keys.begin() + b_begin[band], keys.begin() + b_begin[band + 1] );
+        }
+        std::vector<double> cumulative = weighted() ? cumulative_weights( keys, weights() ) : std::vector<double>();
+
+        std::vector<size_t> begin;
+        std::vector<size_t> end;
+        std::vector<double> target;
+        std::vector<int> query_partition;
+        for ( int band = 0; band < nb_bands(); ++band ) {
+            for ( int p = b_partition[band] + 1; p < b_partition[band + 1]; ++p ) {
+                if ( displs[p] < b_displs[band + 1] ) {
+                    begin.emplace_back( b_begin[band] );
+                    end.emplace_back( b_begin[band + 1] );
+                    target.emplace_back( displs[p] - b_displs[band] );
+                    query_partition.emplace_back( p );
+                }
+            }
+        }
+        std::vector<SortKey> selected = select_keys( keys, cumulative, begin, end, target, comm );
+        for ( size_t q = 0; q < selected.size(); ++q ) {
+            partition_first[query_partition[q]] = selected[q];
+        }
+    }
+
+    ATLAS_TRACE_SCOPE( "assign partitions" ) {
+        std::vector<int> w_part( w_size );
+        for ( int band = 0; band < nb_bands(); ++band ) {
+            auto first_begin = partition_first.begin() + b_partition[band] + 1;
+            auto first_end   = partition_first.begin() + b_partition[band + 1];
+            atlas_omp_parallel_for( size_t n = b_begin[band]; n < b_begin[band + 1]; ++n ) {
+                const SortKey& key = keys[n];
+                const int sector   = static_cast<int>( std::upper_bound( first_begin, first_end, key ) - first_begin );
+                w_part[key[2] - w_begin] = b_partition[band] + sector;
+            }
+        }
+        ATLAS_TRACE_MPI( ALLGATHER ) {
+            comm.allGatherv( w_part.begin(), w_part.end(), part, w_count.data(), w_displs.data() );
+        }
+    }
+}
+
 }  // namespace partitioner
 }  // namespace detail
 }  // namespace grid
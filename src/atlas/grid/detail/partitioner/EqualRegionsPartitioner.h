@@ -86,9 +86,16 @@ public:
     int nb_bands() const { return bands_.size(); }
     int nb_regions( int band ) const { return sectors_[band]; }
 
-    using Partitioner::partition;
+    /// For a StructuredGrid without weights a functional EqualRegionsDistribution is returned, which gives the
+    /// same partitions as partition( grid, part[] ) without storing them per grid point.
+    virtual Distribution partition( const Grid& ) const;
+
     virtual void partition( const Grid&, int part[] ) const;
 
+    /// With weights the bands and regions contain equal weight instead of equal number of points,
+    /// always using the distributed sort.
+    bool weightable() const override { return true; }
+
     virtual std::string type() const { return "equal_regions"; }
 
 public:
@@ -120,6 +127,10 @@ private:
     // algorithm is used internally
     void partition( int nb_nodes, NodeInt nodes[], int part[] ) const;
 
+    // Same result as gathering and sorting all nodes, but every MPI rank only sorts a contiguous slice of the grid.
+    // Band and region boundaries are found by a distributed selection over these slices.
+    void partition_distributed( const Grid&, int part[] ) const;
+
     // x and y in radians
     int partition( const double& x, const double& y ) const;
 
@@ -133,6 +144,7 @@ private:
     int N_;
     std::vector<double> bands_;
     std::vector<int> sectors_;
+    bool distributed_sort_{true};  // configurable with "distributed_sort"
 };
 
 }  // namespace partitioner
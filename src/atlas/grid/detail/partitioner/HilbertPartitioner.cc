@@ -0,0 +1,253 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "HilbertPartitioner.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+#include "atlas/domain/Domain.h"
+#include "atlas/grid/Iterator.h"
+#include "atlas/grid/detail/distribution/HilbertDistribution.h"
+#include "atlas/grid/detail/distribution/SerialDistribution.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/parallel/omp/sort.h"
+#include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/Hilbert.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace partitioner {
+
+using Key = distribution::HilbertDistribution::Key;
+
+namespace {
+
+// Distributed selection of weighted order statistics.
+// Each MPI rank holds its own sorted keys, with the weight of its first i keys in cumulative[i], or unit weights when
+// cumulative is empty. For every query q this returns the first key for which the weight of all keys up to and
+// including it, over all MPI ranks, is above target[q].
+// The Hilbert key and the global index are fixed one after the other by bisection, with a single allreduce
+// of the weights of all queries per bisection step.
+std::vector<Key> select_keys( const std::vector<Key>& keys, const std::vector<double>& cumulative,
+                              const std::vector<double>& target, gidx_t nb_hilbert_keys, gidx_t nb_nodes,
+                              const mpi::Comm& comm ) {
+    const size_t nb_queries = target.size();
+    std::vector<Key> selected( nb_queries );
+    std::vector<gidx_t> lo( nb_queries );
+    std::vector<gidx_t> hi( nb_queries );
+    std::vector<double> weight( nb_queries );
+
+    for ( int c = 0; c < 2; ++c ) {
+        // Invariant: weight( lo ) <= target < weight( hi ), with weight( v ) the weight of the keys not above the key
+        // with component c equal to v
+        std::fill( lo.begin(), lo.end(), -1 );
+        std::fill( hi.begin(), hi.end(), c == 0 ? nb_hilbert_keys - 1 : nb_nodes - 1 );
+        while ( true ) {
+            bool converged = true;
+            for ( size_t q = 0; q < nb_queries; ++q ) {
+                converged = converged && ( hi[q] - lo[q] <= 1 );
+            }
+            if ( converged ) {
+                break;
+            }
+            atlas_omp_parallel_for( size_t q = 0; q < nb_queries; ++q ) {
+                weight[q] = 0.;
+                if ( hi[q] - lo[q] > 1 ) {
+                    const gidx_t mid = lo[q] + ( hi[q] - lo[q] ) / 2;
+                    const Key bound  = ( c == 0 ) ? Key{mid, std::numeric_limits<gidx_t>::max()}
+                                                 : Key{selected[q].first, mid};
+                    const size_t count = std::upper_bound( keys.begin(), keys.end(), bound ) - keys.begin();
+                    weight[q]          = cumulative.empty() ? double( count ) : cumulative[count];
+                }
+            }
+            ATLAS_TRACE_MPI( ALLREDUCE ) { comm.allReduceInPlace( weight.data(), nb_queries, eckit::mpi::sum() ); }
+            for ( size_t q = 0; q < nb_queries; ++q ) {
+                if ( hi[q] - lo[q] > 1 ) {
+                    const gidx_t mid = lo[q] + ( hi[q] - lo[q] ) / 2;
+                    if ( weight[q] > target[q] ) {
+                        hi[q] = mid;
+                    }
+                    else {
+                        lo[q] = mid;
+                    }
+                }
+            }
+        }
+        for ( size_t q = 0; q < nb_queries; ++q ) {
+            if ( c == 0 ) {
+                selected[q].first = hi[q];
+            }
+            else {
+                selected[q].second = hi[q];
+            }
+        }
+    }
+    return selected;
+}
+
+}  // namespace
+
+struct HilbertPartitioner::Split {
+    RectangularDomain domain;    // bounding box of all grid points, spanned by the curve
+    std::vector<Key> first;      // first key of every partition
+    std::vector<idx_t> nb_pts;   // number of points of every partition
+    std::vector<int> w_part;     // partition of the grid points handled by this MPI rank
+    std::vector<int> w_count;    // number of grid points handled by every MPI rank
+    std::vector<int> w_displs;   // first grid point handled by every MPI rank
+};
+
+HilbertPartitioner::HilbertPartitioner() : Partitioner() {}
+
+HilbertPartitioner::HilbertPartitioner( int N ) : Partitioner( N ) {}
+
+HilbertPartitioner::HilbertPartitioner( int N, const eckit::Parametrisation& config ) : Partitioner( N ) {
+    config.get( "recursion", recursion_ );
+}
+
+void HilbertPartitioner::split( const Grid& grid, Split& split ) const {
+    ATLAS_TRACE( "HilbertPartitioner::split" );
+    ATLAS_ASSERT( recursion_ > 0 && recursion_ <= 30 );
+
+    const auto& comm      = mpi::comm();
+    const int mpi_rank    = static_cast<int>( comm.rank() );
+    const int mpi_size    = static_cast<int>( comm.size() );
+    const gidx_t nb_nodes = grid.size();
+    const idx_t N         = nb_partitions();
+
+    // Every MPI rank handles a contiguous slice of the grid
+    split.w_count.resize( mpi_size );
+    split.w_displs.resize( mpi_size );
+    for ( int w = 0; w < mpi_size; ++w ) {
+        split.w_displs[w] = static_cast<int>( ( w * nb_nodes ) / mpi_size );
+        split.w_count[w]  = static_cast<int>( ( ( w + 1 ) * nb_nodes ) / mpi_size ) - split.w_displs[w];
+    }
+    const gidx_t w_begin = split.w_displs[mpi_rank];
+    const size_t w_size  = split.w_count[mpi_rank];
+
+    std::vector<PointXY> points( w_size );
+    double xmin = std::numeric_limits<double>::max();
+    double xmax = -std::numeric_limits<double>::max();
+    double ymin = std::numeric_limits<double>::max();
+    double ymax = -std::numeric_limits<double>::max();
+    ATLAS_TRACE_SCOPE( "bounding box" ) {
+        auto point = grid.xy().begin() + w_begin;
+        for ( size_t n = 0; n < w_size; ++n, ++point ) {
+            points[n] = *point;
+            xmin      = std::min( xmin, points[n].x() );
+            xmax      = std::max( xmax, points[n].x() );
+            ymin      = std::min( ymin, points[n].y() );
+            ymax      = std::max( ymax, points[n].y() );
+        }
+        ATLAS_TRACE_MPI( ALLREDUCE ) {
+            comm.allReduceInPlace( xmin, eckit::mpi::min() );
+            comm.allReduceInPlace( xmax, eckit::mpi::max() );
+            comm.allReduceInPlace( ymin, eckit::mpi::min() );
+            comm.allReduceInPlace( ymax, eckit::mpi::max() );
+        }
+    }
+    split.domain = RectangularDomain( {xmin, xmax}, {ymin, ymax}, grid.projection().units() );
+    const util::Hilbert hilbert( split.domain, recursion_ );
+
+    std::vector<Key> keys( w_size );
+    ATLAS_TRACE_SCOPE( "hilbert keys" ) {
+        atlas_omp_parallel_for( size_t n = 0; n < w_size; ++n ) {
+            keys[n] = Key{hilbert( points[n] ), w_begin + static_cast<gidx_t>( n )};
+        }
+        omp::sort( keys.begin(), keys.end(), std::less<Key>() );
+    }
+
+    // Weight of the first i sorted keys in cumulative[i], left empty for unit weights
+    std::vector<double> cumulative;
+    double total = nb_nodes;
+    if ( weighted() ) {
+        cumulative.resize( w_size + 1, 0. );
+        for ( size_t n = 0; n < w_size; ++n ) {
+            cumulative[n + 1] = cumulative[n] + weights()( keys[n].second );
+        }
+        total = cumulative.back();
+        ATLAS_TRACE_MPI( ALLREDUCE ) { comm.allReduceInPlace( total, eckit::mpi::sum() ); }
+        ATLAS_ASSERT( total > 0., "Sum of weights must be positive" );
+    }
+
+    ATLAS_TRACE_SCOPE( "select partitions" ) {
+        // Without weights, equal number of points per partition, the first "remainder" partitions get one point more.
+        // Partitions that are empty because there are fewer points than partitions start beyond any point.
+        const gidx_t chunk_size = nb_nodes / N;
+        const gidx_t remainder  = nb_nodes - chunk_size * N;
+        std::vector<double> target;
+        for ( idx_t p = 1; p < N; ++p ) {
+            const double t = weighted() ? double( p ) * total / double( N )
+                                        : double( p * chunk_size + std::min<gidx_t>( p, remainder ) );
+            if ( t < total ) {
+                target.emplace_back( t );
+            }
+        }
+        const Key beyond{std::numeric_limits<gidx_t>::max(), std::numeric_limits<gidx_t>::max()};
+        split.first.assign( N, beyond );
+        split.first[0] = Key{std::numeric_limits<gidx_t>::min(), std::numeric_limits<gidx_t>::min()};
+
+        std::vector<Key> selected = select_keys( keys, cumulative, target, hilbert.nb_keys(), nb_nodes, comm );
+        std::copy( selected.begin(), selected.end(), split.first.begin() + 1 );
+    }
+
+    ATLAS_TRACE_SCOPE( "assign partitions" ) {
+        split.w_part.resize( w_size );
+        atlas_omp_parallel_for( size_t n = 0; n < w_size; ++n ) {
+            auto next = std::upper_bound( split.first.begin() + 1, split.first.end(), keys[n] );
+            split.w_part[keys[n].second - w_begin] = static_cast<int>( next - split.first.begin() ) - 1;
+        }
+        split.nb_pts.assign( N, 0 );
+        for ( int p : split.w_part ) {
+            ++split.nb_pts[p];
+        }
+        ATLAS_TRACE_MPI( ALLREDUCE ) { comm.allReduceInPlace( split.nb_pts.data(), N, eckit::mpi::sum() ); }
+    }
+}
+
+Distribution HilbertPartitioner::partition( const Grid& grid ) const {
+    if ( nb_partitions() == 1 ) {
+        return Distribution{new distribution::SerialDistribution{grid}};
+    }
+    Split s;
+    split( grid, s );
+    return Distribution{new distribution::HilbertDistribution{grid, util::Hilbert( s.domain, recursion_ ), s.first,
+                                                              s.nb_pts, type()}};
+}
+
+void HilbertPartitioner::partition( const Grid& grid, int part[] ) const {
+    if ( nb_partitions() == 1 ) {  // trivial solution, so much faster
+        atlas_omp_parallel_for( gidx_t n = 0; n < grid.size(); ++n ) { part[n] = 0; }
+        return;
+    }
+    ATLAS_TRACE( "HilbertPartitioner::partition" );
+
+    Split s;
+    split( grid, s );
+
+    const auto& comm = mpi::comm();
+    ATLAS_TRACE_MPI( ALLGATHER ) {
+        comm.allGatherv( s.w_part.begin(), s.w_part.end(), part, s.w_count.data(), s.w_displs.data() );
+    }
+}
+
+}  // namespace partitioner
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
+
+namespace {
+atlas::grid::detail::partitioner::PartitionerBuilder<atlas::grid::detail::partitioner::HilbertPartitioner> __Hilbert(
+    atlas::grid::detail::partitioner::HilbertPartitioner::static_type() );
+}
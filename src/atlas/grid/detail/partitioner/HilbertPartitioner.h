@@ -0,0 +1,65 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "atlas/grid/detail/partitioner/Partitioner.h"
+
+#include "atlas/grid/Distribution.h"
+#include "atlas/grid/Grid.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace partitioner {
+
+/// @brief Partitioner for any grid, following a Hilbert space-filling curve
+///
+/// The grid points are ordered along a Hilbert curve spanning their bounding box, and this order is split
+/// into pieces with equal number of points, or equal weight when weights are set. Neighbouring points along
+/// the curve are close in space, which gives compact partitions with small halos, also for unstructured grids
+/// and point clouds.
+///
+/// Every MPI task computes the curve keys of a contiguous slice of the grid only. The first key of every
+/// partition is found by a distributed selection, so that no task sorts or gathers all keys.
+///
+/// The optional config can contain:
+///
+///     - "recursion" : <int> (default=30)  // Recursion of the Hilbert curve, at most 30 for 64-bit keys
+class HilbertPartitioner : public Partitioner {
+public:
+    HilbertPartitioner();
+    HilbertPartitioner( int N );
+    HilbertPartitioner( int N, const eckit::Parametrisation& config );
+
+    std::string type() const override { return static_type(); }
+    static std::string static_type() { return "hilbert"; }
+
+    /// Returns a functional HilbertDistribution, which only stores the first point of every partition
+    Distribution partition( const Grid& grid ) const override;
+
+    void partition( const Grid& grid, int part[] ) const override;
+
+    bool weightable() const override { return true; }
+
+private:
+    struct Split;
+    void split( const Grid&, Split& ) const;
+
+private:
+    idx_t recursion_{30};
+};
+
+}  // namespace partitioner
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
@@ -10,6 +10,7 @@
 
 #include "atlas/grid/detail/partitioner/MatchingMeshPartitionerLonLatPolygon.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "eckit/config/Resource.h"
@@ -17,10 +18,13 @@
 
 #include "atlas/grid/Grid.h"
 #include "atlas/grid/Iterator.h"
+#include "atlas/grid/StructuredGrid.h"
 #include "atlas/mesh/Nodes.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/fill.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/PolygonXY.h"
 
@@ -52,22 +56,119 @@ void MatchingMeshPartitionerLonLatPolygon::partition( const Grid& grid, int part
     const util::PolygonXY poly{prePartitionedMesh_.polygon( 0 )};
     Projection projection = prePartitionedMesh_.projection();
 
-    {
+    const double xmin = poly.coordinatesMin()[LON];
+    const double xmax = poly.coordinatesMax()[LON];
+    const double ymin = poly.coordinatesMin()[LAT];
+    const double ymax = poly.coordinatesMax()[LAT];
+
+    auto atThePole = [&]( double y ) {
+        return ( includesNorthPole && y >= ymax ) || ( includesSouthPole && y < ymin );
+    };
+
+    // Global indices of the points claimed by this partition. Consecutive indices are merged into [begin,end) runs.
+    // A single point, as claimed mostly for unstructured grids, is stored as -1 - index instead of a run, so that
+    // scattered claims cost one value per point.
+    std::vector<idx_t> claims;
+    auto claim = [&]( idx_t begin, idx_t end ) {
+        if ( not claims.empty() && claims.back() == begin ) {
+            claims.back() = end;
+        }
+        else if ( not claims.empty() && claims.back() < 0 && -1 - claims.back() == begin - 1 ) {
+            claims.back() = begin - 1;
+            claims.push_back( end );
+        }
+        else if ( end == begin + 1 ) {
+            claims.push_back( -1 - begin );
+        }
+        else {
+            claims.push_back( begin );
+            claims.push_back( end );
+        }
+    };
+
+    // When neither the grid nor the mesh is projected, the rows of a StructuredGrid have constant y in the polygon
+    // coordinates, and x increasing with i. Rows outside the polygon bounding box are skipped, and within a row only
+    // the points inside the bounding box are tested.
+    StructuredGrid structured( grid );
+    if ( structured && grid.projection().type() == "lonlat" && projection.type() == "lonlat" ) {
+        ATLAS_TRACE( "point-in-polygon check for structured grid" );
+        for ( idx_t j = 0; j < structured.ny(); ++j ) {
+            const double y = structured.y( j );
+            const idx_t nx = structured.nx( j );
+            if ( nx == 0 ) {
+                continue;
+            }
+            const idx_t ilast = nx - 1;
+            if ( atThePole( y ) ) {
+                claim( structured.index( 0, j ), structured.index( ilast, j ) + 1 );
+                continue;
+            }
+            if ( y < ymin || y > ymax ) {
+                continue;
+            }
+            idx_t ibegin = 0;
+            idx_t iend   = nx;
+            if ( structured.x( 0, j ) <= structured.x( ilast, j ) ) {
+                auto first_not_below = [&]( double x, bool inclusive ) {
+                    idx_t lo = 0;
+                    idx_t hi = nx;
+                    while ( lo < hi ) {
+                        idx_t mid         = lo + ( hi - lo ) / 2;
+                        const double xmid = structured.x( mid, j );
+                        if ( xmid < x || ( inclusive && xmid == x ) ) {
+                            lo = mid + 1;
+                        }
+                        else {
+                            hi = mid;
+                        }
+                    }
+                    return lo;
+                };
+                ibegin = first_not_below( xmin, false );
+                iend   = first_not_below( xmax, true );
+            }
+            for ( idx_t i = ibegin; i < iend; ++i ) {
+                if ( poly.contains( PointXY{structured.x( i, j ), y} ) ) {
+                    const idx_t n = structured.index( i, j );
+                    claim( n, n + 1 );
+                }
+            }
+        }
+    }
+    else {
         eckit::ProgressTimer timer( "Partitioning", grid.size(), "point", double( 10 ), atlas::Log::trace() );
-        size_t i = 0;
+        idx_t i = 0;
 
         for ( PointLonLat P : grid.lonlat() ) {
             ++timer;
             projection.lonlat2xy( P );
-            const bool atThePole = ( includesNorthPole && P[LAT] >= poly.coordinatesMax()[LAT] ) ||
-                                   ( includesSouthPole && P[LAT] < poly.coordinatesMin()[LAT] );
+            if ( atThePole( P[LAT] ) || poly.contains( P ) ) {
+                claim( i, i + 1 );
+            }
+            ++i;
+        }
+    }
 
-            partitioning[i++] = atThePole || poly.contains( P ) ? mpi_rank : -1;
+    // Exchange only the claims instead of reducing a global array. As with the reduction, a point claimed
+    // by several partitions goes to the highest one.
+    eckit::mpi::Buffer<idx_t> recv( mpi_size );
+    ATLAS_TRACE_MPI( ALLGATHER ) { comm.allGatherv( claims.begin(), claims.end(), recv ); }
+
+    omp::fill( partitioning, partitioning + grid.size(), -1 );
+    for ( int p = 0; p < mpi_size; ++p ) {
+        const idx_t* p_claims = recv.buffer.data() + recv.displs[p];
+        for ( int c = 0; c < recv.counts[p]; ++c ) {
+            if ( p_claims[c] < 0 ) {
+                partitioning[-1 - p_claims[c]] = p;
+            }
+            else {
+                std::fill( partitioning + p_claims[c], partitioning + p_claims[c + 1], p );
+                ++c;
+            }
         }
     }
 
-    // Synchronize partitioning, do a sanity check
-    comm.allReduceInPlace( partitioning, grid.size(), eckit::mpi::Operation::MAX );
+    // Sanity check
     const int min = *std::min_element( partitioning, partitioning + grid.size() );
     if ( min < 0 ) {
         throw_Exception(
@@ -63,6 +63,13 @@ idx_t Partitioner::nb_partitions() const {
     return nb_partitions_;
 }
 
+void Partitioner::weights( const Weights& weights ) {
+    if ( not weightable() ) {
+        throw_Exception( "Partitioner " + type() + " does not support weights", Here() );
+    }
+    weights_ = weights;
+}
+
 Distribution Partitioner::partition( const Grid& grid ) const {
     return new distribution::DistributionArray{grid, atlas::grid::Partitioner( this )};
 }
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 
 #include "atlas/library/config.h"
@@ -34,6 +35,9 @@ class Partitioner : public util::Object {
 public:
     using Grid = atlas::Grid;
 
+    /// Weight (cost) of a grid point, given its global index
+    using Weights = std::function<double( gidx_t )>;
+
 public:
     Partitioner();
     Partitioner( const idx_t nb_partitions );
@@ -47,8 +51,20 @@ public:
 
     virtual std::string type() const = 0;
 
+    /// Balance the total weight instead of the number of grid points per partition.
+    /// Only for partitioners that are weightable().
+    void weights( const Weights& );
+
+    /// True if the partitioner can balance weights
+    virtual bool weightable() const { return false; }
+
+protected:
+    bool weighted() const { return bool( weights_ ); }
+    const Weights& weights() const { return weights_; }
+
 private:
     idx_t nb_partitions_;
+    Weights weights_;
 };
 
 // ------------------------------------------------------------------
@@ -88,6 +88,14 @@ void Interpolation::execute( const Field& source, Field& target ) const {
     get()->execute( source, target );
 }
 
+void Interpolation::execute_adjoint( FieldSet& source, const FieldSet& target ) const {
+    get()->execute_adjoint( source, target );
+}
+
+void Interpolation::execute_adjoint( Field& source, const Field& target ) const {
+    get()->execute_adjoint( source, target );
+}
+
 void Interpolation::print( std::ostream& out ) const {
     get()->print( out );
 }
@@ -53,6 +53,11 @@ public:
 
     void execute( const Field& source, Field& target ) const;
 
+    // Apply the adjoint of the interpolation (target -> source)
+    void execute_adjoint( FieldSet& source, const FieldSet& target ) const;
+
+    void execute_adjoint( Field& source, const Field& target ) const;
+
     void print( std::ostream& out ) const;
 
     const FunctionSpace& source() const;
@@ -67,6 +67,15 @@ struct NonLinear : DOXYGEN_HIDE( public util::ObjectHandle<nonlinear::NonLinear>
      * @return if W was modified
      */
     bool execute( Matrix& W, const Field& f ) const;
+
+    /**
+     * @brief Interpolate, applying the non-linear corrections to each row of the interpolation matrix on the fly
+     * @param [in] W interpolation matrix, not modified
+     * @param [in] src field
+     * @param [out] tgt interpolated field
+     * @return if supported, otherwise execute() should be applied to a copy of W
+     */
+    bool interpolate( const Matrix& W, const Field& src, Field& tgt ) const;
 };
 
 
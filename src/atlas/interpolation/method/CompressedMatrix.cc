@@ -0,0 +1,99 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/interpolation/method/CompressedMatrix.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+
+namespace atlas {
+namespace interpolation {
+namespace method {
+
+CompressedMatrix::CompressedMatrix( const Matrix& W, bool delta_encoding ) :
+    rows_( W.rows() ), cols_( W.cols() ), delta_encoded_( false ) {
+    ATLAS_TRACE( "atlas::interpolation::method::CompressedMatrix" );
+    ATLAS_ASSERT( cols_ <= size_t( std::numeric_limits<std::uint32_t>::max() ) );
+
+    const auto outer  = W.outer();
+    const auto index  = W.inner();
+    const auto weight = W.data();
+    const size_t nnz  = W.nonZeros();
+
+    outer_.assign( outer, outer + rows_ + 1 );
+    weights_.resize( nnz );
+    for ( size_t c = 0; c < nnz; ++c ) {
+        weights_[c] = static_cast<Weight>( weight[c] );
+    }
+
+    if ( delta_encoding ) {
+        delta_encoded_ = true;
+        base_.resize( rows_ );
+        for ( size_t r = 0; r < rows_ && delta_encoded_; ++r ) {
+            if ( outer[r] == outer[r + 1] ) {
+                base_[r] = 0;
+                continue;
+            }
+            const auto minmax = std::minmax_element( index + outer[r], index + outer[r + 1] );
+            base_[r]          = static_cast<std::uint32_t>( *minmax.first );
+            if ( *minmax.second - *minmax.first > std::numeric_limits<std::uint16_t>::max() ) {
+                Log::debug() << "CompressedMatrix: row " << r << " spans too many columns for delta encoding"
+                             << std::endl;
+                delta_encoded_ = false;
+            }
+        }
+        if ( delta_encoded_ ) {
+            offsets_.resize( nnz );
+            for ( size_t r = 0; r < rows_; ++r ) {
+                for ( auto c = outer[r]; c < outer[r + 1]; ++c ) {
+                    offsets_[c] = static_cast<std::uint16_t>( index[c] - base_[r] );
+                }
+            }
+        }
+        else {
+            std::vector<std::uint32_t>().swap( base_ );
+        }
+    }
+
+    if ( not delta_encoded_ ) {
+        inner_.resize( nnz );
+        for ( size_t c = 0; c < nnz; ++c ) {
+            inner_[c] = static_cast<std::uint32_t>( index[c] );
+        }
+    }
+}
+
+size_t CompressedMatrix::footprint() const {
+    return sizeof( *this ) + outer_.capacity() * sizeof( size_t ) + weights_.capacity() * sizeof( Weight ) +
+           inner_.capacity() * sizeof( std::uint32_t ) + base_.capacity() * sizeof( std::uint32_t ) +
+           offsets_.capacity() * sizeof( std::uint16_t );
+}
+
+CompressedMatrix::Matrix CompressedMatrix::decompress() const {
+    std::vector<eckit::linalg::Triplet> triplets;
+    triplets.reserve( nonZeros() );
+    const auto absolute = absolute_columns();
+    const auto delta    = delta_columns();
+    for ( size_t r = 0; r < rows_; ++r ) {
+        for ( size_t c = outer_[r]; c < outer_[r + 1]; ++c ) {
+            const idx_t col = delta_encoded_ ? delta( r, c ) : absolute( r, c );
+            triplets.emplace_back( r, col, weights_[c] );
+        }
+    }
+    return Matrix( rows_, cols_, triplets );
+}
+
+}  // namespace method
+}  // namespace interpolation
+}  // namespace atlas
@@ -0,0 +1,83 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "eckit/linalg/SparseMatrix.h"
+
+#include "atlas/library/config.h"
+
+namespace atlas {
+namespace interpolation {
+namespace method {
+
+/**
+ * @class CompressedMatrix
+ *
+ * Read-only CSR copy of an interpolation matrix with single precision weights and 32-bit column indices.
+ * Optionally the column indices are delta-encoded: each row stores its smallest column index, and each entry a
+ * 16-bit offset to it. This is only possible when the columns of every row span less than 65536 indices,
+ * otherwise absolute column indices are kept.
+ */
+class CompressedMatrix {
+public:
+    using Matrix = eckit::linalg::SparseMatrix;
+    using Weight = float;
+
+    /// Column index of the entries of absolute-encoded matrices
+    struct AbsoluteColumns {
+        const std::uint32_t* inner;
+        idx_t operator()( size_t /*row*/, size_t entry ) const { return static_cast<idx_t>( inner[entry] ); }
+    };
+
+    /// Column index of the entries of delta-encoded matrices
+    struct DeltaColumns {
+        const std::uint32_t* base;
+        const std::uint16_t* offset;
+        idx_t operator()( size_t row, size_t entry ) const { return static_cast<idx_t>( base[row] + offset[entry] ); }
+    };
+
+    CompressedMatrix( const Matrix&, bool delta_encoding );
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t nonZeros() const { return weights_.size(); }
+
+    /// Memory used, in bytes
+    size_t footprint() const;
+
+    bool delta_encoded() const { return delta_encoded_; }
+
+    const size_t* outer() const { return outer_.data(); }
+    const Weight* data() const { return weights_.data(); }
+
+    AbsoluteColumns absolute_columns() const { return AbsoluteColumns{inner_.data()}; }
+    DeltaColumns delta_columns() const { return DeltaColumns{base_.data(), offsets_.data()}; }
+
+    /// Convert back to a double precision matrix
+    Matrix decompress() const;
+
+private:
+    size_t rows_;
+    size_t cols_;
+    bool delta_encoded_;
+    std::vector<size_t> outer_;
+    std::vector<Weight> weights_;
+    std::vector<std::uint32_t> inner_;    // absolute encoding
+    std::vector<std::uint32_t> base_;     // delta encoding, per row
+    std::vector<std::uint16_t> offsets_;  // delta encoding, per entry
+};
+
+}  // namespace method
+}  // namespace interpolation
+}  // namespace atlas
@@ -10,8 +10,11 @@
 
 #include "atlas/interpolation/method/Method.h"
 
+#include <algorithm>
+
 #include "eckit/linalg/LinearAlgebra.h"
 #include "eckit/linalg/Vector.h"
+#include "eckit/log/Bytes.h"
 #include "eckit/log/Timer.h"
 #include "eckit/thread/AutoLock.h"
 #include "eckit/thread/Mutex.h"
@@ -23,6 +26,7 @@
 #include "atlas/field/MissingValue.h"
 #include "atlas/functionspace/NodeColumns.h"
 #include "atlas/mesh/Nodes.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
@@ -30,6 +34,198 @@
 namespace atlas {
 namespace interpolation {
 
+namespace {
+
+// Kernels for the single precision matrix storage, specialised for the column encoding (see CompressedMatrix)
+
+template <typename Value, typename Columns>
+void interpolate_compressed_rank1( const method::CompressedMatrix& W, const Columns& columns, const Field& src,
+                                   Field& tgt ) {
+    const auto outer  = W.outer();
+    const auto weight = W.data();
+    idx_t rows        = static_cast<idx_t>( W.rows() );
+
+    auto v_src = array::make_view<Value, 1>( src );
+    auto v_tgt = array::make_view<Value, 1>( tgt );
+
+    atlas_omp_parallel_for( idx_t r = 0; r < rows; ++r ) {
+        v_tgt( r ) = 0.;
+        for ( size_t c = outer[r]; c < outer[r + 1]; ++c ) {
+            idx_t n = columns( r, c );
+            Value w = static_cast<Value>( weight[c] );
+            v_tgt( r ) += w * v_src( n );
+        }
+    }
+}
+
+template <typename Value, typename Columns>
+void interpolate_compressed_rank2( const method::CompressedMatrix& W, const Columns& columns, const Field& src,
+                                   Field& tgt ) {
+    const auto outer  = W.outer();
+    const auto weight = W.data();
+    idx_t rows        = static_cast<idx_t>( W.rows() );
+
+    auto v_src = array::make_view<Value, 2>( src );
+    auto v_tgt = array::make_view<Value, 2>( tgt );
+
+    idx_t Nk = src.shape( 1 );
+
+    atlas_omp_parallel_for( idx_t r = 0; r < rows; ++r ) {
+        for ( idx_t k = 0; k < Nk; ++k ) {
+            v_tgt( r, k ) = 0.;
+        }
+        for ( size_t c = outer[r]; c < outer[r + 1]; ++c ) {
+            idx_t n = columns( r, c );
+            Value w = static_cast<Value>( weight[c] );
+            for ( idx_t k = 0; k < Nk; ++k ) {
+                v_tgt( r, k ) += w * v_src( n, k );
+            }
+        }
+    }
+}
+
+template <typename Value, typename Columns>
+void interpolate_compressed_rank3( const method::CompressedMatrix& W, const Columns& columns, const Field& src,
+                                   Field& tgt ) {
+    const auto outer  = W.outer();
+    const auto weight = W.data();
+    idx_t rows        = static_cast<idx_t>( W.rows() );
+
+    auto v_src = array::make_view<Value, 3>( src );
+    auto v_tgt = array::make_view<Value, 3>( tgt );
+
+    idx_t Nk = src.shape( 1 );
+    idx_t Nl = src.shape( 2 );
+
+    atlas_omp_parallel_for( idx_t r = 0; r < rows; ++r ) {
+        for ( idx_t k = 0; k < Nk; ++k ) {
+            for ( idx_t l = 0; l < Nl; ++l ) {
+                v_tgt( r, k, l ) = 0.;
+            }
+        }
+        for ( size_t c = outer[r]; c < outer[r + 1]; ++c ) {
+            idx_t n = columns( r, c );
+            Value w = static_cast<Value>( weight[c] );
+            for ( idx_t k = 0; k < Nk; ++k ) {
+                for ( idx_t l = 0; l < Nl; ++l ) {
+                    v_tgt( r, k, l ) += w * v_src( n, k, l );
+                }
+            }
+        }
+    }
+}
+
+template <typename Value, typename Columns>
+void interpolate_compressed( const method::CompressedMatrix& W, const Columns& columns, const Field& src,
+                             Field& tgt ) {
+    if ( src.rank() == 1 ) {
+        interpolate_compressed_rank1<Value>( W, columns, src, tgt );
+    }
+    else if ( src.rank() == 2 ) {
+        interpolate_compressed_rank2<Value>( W, columns, src, tgt );
+    }
+    else if ( src.rank() == 3 ) {
+        interpolate_compressed_rank3<Value>( W, columns, src, tgt );
+    }
+    else {
+        ATLAS_NOTIMPLEMENTED;
+    }
+}
+
+// Kernels for the SELL-C-sigma matrix format: the C rows of a chunk are computed together, one entry per row
+// at a time, so that the innermost loop runs over the contiguous weights and column indices of the chunk
+
+// rank-2 fields with more levels than this use the CSR kernel, which is vectorised along the levels
+constexpr idx_t sell_max_levels = 8;
+
+template <typename Value>
+void interpolate_sell_rank1( const method::SellMatrix& W, const Field& src, Field& tgt ) {
+    constexpr idx_t C = method::SellMatrix::C;
+    const auto row    = W.row();
+    const auto weight = W.data();
+    const auto index  = W.inner();
+    idx_t chunks      = W.chunks();
+
+    auto v_src = array::make_view<Value, 1>( src );
+    auto v_tgt = array::make_view<Value, 1>( tgt );
+
+    atlas_omp_parallel_for( idx_t i = 0; i < chunks; ++i ) {
+        const double* w = weight + W.offset( i );
+        const idx_t* n  = index + W.offset( i );
+        const idx_t Nj  = W.width( i );
+
+        Value sum[C];
+        for ( idx_t l = 0; l < C; ++l ) {
+            sum[l] = 0.;
+        }
+        for ( idx_t j = 0; j < Nj; ++j ) {
+            atlas_omp_pragma( omp simd )
+            for ( idx_t l = 0; l < C; ++l ) {
+                sum[l] += static_cast<Value>( w[j * C + l] ) * v_src( n[j * C + l] );
+            }
+        }
+        for ( idx_t l = 0; l < C; ++l ) {
+            const idx_t r = row[i * C + l];
+            if ( r >= 0 ) {
+                v_tgt( r ) = sum[l];
+            }
+        }
+    }
+
+    const auto& empty_rows = W.empty_rows();
+    const idx_t nb_empty   = static_cast<idx_t>( empty_rows.size() );
+    atlas_omp_parallel_for( idx_t j = 0; j < nb_empty; ++j ) { v_tgt( empty_rows[j] ) = 0.; }
+}
+
+template <typename Value>
+void interpolate_sell_rank2( const method::SellMatrix& W, const Field& src, Field& tgt ) {
+    constexpr idx_t C = method::SellMatrix::C;
+    const auto row    = W.row();
+    const auto weight = W.data();
+    const auto index  = W.inner();
+    idx_t chunks      = W.chunks();
+
+    auto v_src = array::make_view<Value, 2>( src );
+    auto v_tgt = array::make_view<Value, 2>( tgt );
+
+    idx_t Nk = src.shape( 1 );
+
+    atlas_omp_parallel_for( idx_t i = 0; i < chunks; ++i ) {
+        const double* w = weight + W.offset( i );
+        const idx_t* n  = index + W.offset( i );
+        const idx_t Nj  = W.width( i );
+
+        for ( idx_t k = 0; k < Nk; ++k ) {
+            Value sum[C];
+            for ( idx_t l = 0; l < C; ++l ) {
+                sum[l] = 0.;
+            }
+            for ( idx_t j = 0; j < Nj; ++j ) {
+                atlas_omp_pragma( omp simd )
+                for ( idx_t l = 0; l < C; ++l ) {
+                    sum[l] += static_cast<Value>( w[j * C + l] ) * v_src( n[j * C + l], k );
+                }
+            }
+            for ( idx_t l = 0; l < C; ++l ) {
+                const idx_t r = row[i * C + l];
+                if ( r >= 0 ) {
+                    v_tgt( r, k ) = sum[l];
+                }
+            }
+        }
+    }
+
+    const auto& empty_rows = W.empty_rows();
+    const idx_t nb_empty   = static_cast<idx_t>( empty_rows.size() );
+    atlas_omp_parallel_for( idx_t j = 0; j < nb_empty; ++j ) {
+        for ( idx_t k = 0; k < Nk; ++k ) {
+            v_tgt( empty_rows[j], k ) = 0.;
+        }
+    }
+}
+
+}  // namespace
+
 void Method::check_compatibility( const Field& src, const Field& tgt, const Matrix& W ) const {
     ATLAS_ASSERT( src.datatype() == tgt.datatype() );
     ATLAS_ASSERT( src.rank() == tgt.rank() );
@@ -151,35 +347,243 @@ void Method::interpolate_field_rank3( const Field& src, Field& tgt, const Matrix
     }
 }
 
+template <typename Value>
+void Method::interpolate_fieldset( const FieldSet& src, FieldSet& tgt, const Matrix& W ) const {
+    for ( idx_t i = 0; i < src.size(); ++i ) {
+        check_compatibility( src[i], tgt[i], W );
+    }
+
+    if ( src[0].rank() == 1 ) {
+        interpolate_fieldset_rank1<Value>( src, tgt, W );
+    }
+    else if ( src[0].rank() == 2 ) {
+        interpolate_fieldset_rank2<Value>( src, tgt, W );
+    }
+    else {
+        ATLAS_NOTIMPLEMENTED;
+    }
+}
+
+template <typename Value>
+void Method::interpolate_fieldset_rank1( const FieldSet& src, FieldSet& tgt, const Matrix& W ) const {
+    const auto outer  = W.outer();
+    const auto index  = W.inner();
+    const auto weight = W.data();
+    idx_t rows        = static_cast<idx_t>( W.rows() );
+    idx_t N           = src.size();
+
+    std::vector<array::ArrayView<const Value, 1>> v_src;
+    std::vector<array::ArrayView<Value, 1>> v_tgt;
+    v_src.reserve( N );
+    v_tgt.reserve( N );
+    for ( idx_t i = 0; i < N; ++i ) {
+        v_src.emplace_back( array::make_view<Value, 1>( src[i] ) );
+        v_tgt.emplace_back( array::make_view<Value, 1>( tgt[i] ) );
+    }
+
+    // stream the matrix once per block of fields rather than once per field
+    for ( idx_t b = 0; b < N; b += fieldset_block_size_ ) {
+        const idx_t f_end = std::min( b + fieldset_block_size_, N );
+
+        atlas_omp_parallel_for( idx_t r = 0; r < rows; ++r ) {
+            for ( idx_t f = b; f < f_end; ++f ) {
+                v_tgt[f]( r ) = 0.;
+            }
+            for ( idx_t c = outer[r]; c < outer[r + 1]; ++c ) {
+                idx_t n = index[c];
+                Value w = static_cast<Value>( weight[c] );
+                for ( idx_t f = b; f < f_end; ++f ) {
+                    v_tgt[f]( r ) += w * v_src[f]( n );
+                }
+            }
+        }
+    }
+}
+
+template <typename Value>
+void Method::interpolate_fieldset_rank2( const FieldSet& src, FieldSet& tgt, const Matrix& W ) const {
+    const auto outer  = W.outer();
+    const auto index  = W.inner();
+    const auto weight = W.data();
+    idx_t rows        = static_cast<idx_t>( W.rows() );
+    idx_t N           = src.size();
+
+    std::vector<array::ArrayView<const Value, 2>> v_src;
+    std::vector<array::ArrayView<Value, 2>> v_tgt;
+    v_src.reserve( N );
+    v_tgt.reserve( N );
+    for ( idx_t i = 0; i < N; ++i ) {
+        v_src.emplace_back( array::make_view<Value, 2>( src[i] ) );
+        v_tgt.emplace_back( array::make_view<Value, 2>( tgt[i] ) );
+    }
+
+    for ( idx_t b = 0; b < N; b += fieldset_block_size_ ) {
+        const idx_t f_end = std::min( b + fieldset_block_size_, N );
+
+        atlas_omp_parallel_for( idx_t r = 0; r < rows; ++r ) {
+            for ( idx_t f = b; f < f_end; ++f ) {
+                const idx_t Nk = v_tgt[f].shape( 1 );
+                for ( idx_t k = 0; k < Nk; ++k ) {
+                    v_tgt[f]( r, k ) = 0.;
+                }
+            }
+            for ( idx_t c = outer[r]; c < outer[r + 1]; ++c ) {
+                idx_t n = index[c];
+                Value w = static_cast<Value>( weight[c] );
+                for ( idx_t f = b; f < f_end; ++f ) {
+                    const idx_t Nk = v_tgt[f].shape( 1 );
+                    for ( idx_t k = 0; k < Nk; ++k ) {
+                        v_tgt[f]( r, k ) += w * v_src[f]( n, k );
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename Value>
+void Method::interpolate_field( const Field& src, Field& tgt, const method::CompressedMatrix& W ) const {
+    ATLAS_ASSERT( src.datatype() == tgt.datatype() );
+    ATLAS_ASSERT( src.rank() == tgt.rank() );
+    ATLAS_ASSERT( src.levels() == tgt.levels() );
+    ATLAS_ASSERT( src.variables() == tgt.variables() );
+    ATLAS_ASSERT( tgt.shape( 0 ) >= static_cast<idx_t>( W.rows() ) );
+    ATLAS_ASSERT( src.shape( 0 ) >= static_cast<idx_t>( W.cols() ) );
+
+    if ( W.delta_encoded() ) {
+        interpolate_compressed<Value>( W, W.delta_columns(), src, tgt );
+    }
+    else {
+        interpolate_compressed<Value>( W, W.absolute_columns(), src, tgt );
+    }
+}
+
+template <typename Value>
+void Method::interpolate_field( const Field& src, Field& tgt, const method::SellMatrix& W ) const {
+    check_compatibility( src, tgt, matrix_ );
+
+    if ( src.rank() == 1 ) {
+        interpolate_sell_rank1<Value>( W, src, tgt );
+    }
+    else if ( src.rank() == 2 ) {
+        interpolate_sell_rank2<Value>( W, src, tgt );
+    }
+    else {
+        ATLAS_NOTIMPLEMENTED;
+    }
+}
+
+bool Method::use_sell_matrix( const Field& src ) const {
+    if ( !sell_matrix_ ) {
+        return false;
+    }
+    const auto kind = src.datatype().kind();
+    if ( kind != array::DataType::KIND_REAL64 && kind != array::DataType::KIND_REAL32 ) {
+        return false;
+    }
+    return src.rank() == 1 || ( src.rank() == 2 && src.shape( 1 ) <= sell_max_levels );
+}
+
+bool Method::fusable( const Field& src ) const {
+    if ( matrix_.empty() || use_eckit_linalg_spmv_ || fieldset_block_size_ < 2 ) {
+        return false;
+    }
+    if ( nonLinear_ && nonLinear_( src ) ) {
+        return false;  // matrix is corrected per field
+    }
+    const auto kind = src.datatype().kind();
+    return ( src.rank() == 1 || src.rank() == 2 ) &&
+           ( kind == array::DataType::KIND_REAL64 || kind == array::DataType::KIND_REAL32 );
+}
+
 Method::Method( const Method::Config& config ) {
     std::string spmv = "";
     config.get( "spmv", spmv );
     use_eckit_linalg_spmv_ = ( spmv == "eckit" );
 
+    // number of fields interpolated together in Method::execute(FieldSet,FieldSet), (< 2 disables)
+    fieldset_block_size_ = 16;
+    config.get( "fieldset_block_size", fieldset_block_size_ );
+
     std::string non_linear;
     if ( config.get( "non_linear", non_linear ) ) {
         nonLinear_ = NonLinear( non_linear, config );
     }
+
+    // storage of the matrix after setup: "double" (default), or "float" for single precision weights and
+    // 32-bit column indices, optionally delta-encoded per row
+    std::string matrix_storage = "double";
+    config.get( "matrix_storage", matrix_storage );
+    if ( matrix_storage != "double" && matrix_storage != "float" ) {
+        throw_Exception( "matrix_storage '" + matrix_storage + "' is not supported, use 'double' or 'float'", Here() );
+    }
+    compress_matrix_       = ( matrix_storage == "float" );
+    matrix_delta_encoding_ = false;
+    config.get( "matrix_delta_encoding", matrix_delta_encoding_ );
+    if ( compress_matrix_ && ( nonLinear_ || use_eckit_linalg_spmv_ ) ) {
+        throw_NotImplemented( "matrix_storage 'float' with non_linear corrections or with the eckit spmv backend",
+                              Here() );
+    }
+
+    // optionally keep a SELL-C-sigma copy of the matrix for rank-1 fields and rank-2 fields with few levels; this
+    // doubles the memory used by the matrix. Not used with the eckit spmv backend or with matrix_storage 'float'
+    use_sell_matrix_ = false;
+    config.get( "sell_matrix", use_sell_matrix_ );
+    use_sell_matrix_ = use_sell_matrix_ && !use_eckit_linalg_spmv_ && !compress_matrix_;
 }
 
 void Method::setup( const FunctionSpace& source, const FunctionSpace& target ) {
     ATLAS_TRACE( "atlas::interpolation::method::Method::setup(FunctionSpace, FunctionSpace)" );
     this->do_setup( source, target );
+    clear_matrix_transpose();
+    compress_matrix();
+    build_sell_matrix();
 }
 
 void Method::setup( const Grid& source, const Grid& target ) {
     ATLAS_TRACE( "atlas::interpolation::method::Method::setup(Grid, Grid)" );
     this->do_setup( source, target );
+    clear_matrix_transpose();
+    compress_matrix();
+    build_sell_matrix();
 }
 
 void Method::setup( const FunctionSpace& source, const Field& target ) {
     ATLAS_TRACE( "atlas::interpolation::method::Method::setup(FunctionSpace, Field)" );
     this->do_setup( source, target );
+    clear_matrix_transpose();
+    compress_matrix();
+    build_sell_matrix();
 }
 
 void Method::setup( const FunctionSpace& source, const FieldSet& target ) {
     ATLAS_TRACE( "atlas::interpolation::method::Method::setup(FunctionSpace, FieldSet)" );
     this->do_setup( source, target );
+    clear_matrix_transpose();
+    compress_matrix();
+    build_sell_matrix();
+}
+
+void Method::compress_matrix() {
+    compressed_matrix_.reset();
+    if ( compress_matrix_ && !matrix_.empty() ) {
+        const size_t footprint = matrix_.footprint();
+        compressed_matrix_.reset( new method::CompressedMatrix( matrix_, matrix_delta_encoding_ ) );
+        Matrix().swap( matrix_ );
+        Log::debug() << "Interpolation matrix compressed from " << eckit::Bytes( footprint ) << " to "
+                     << eckit::Bytes( compressed_matrix_->footprint() )
+                     << ( compressed_matrix_->delta_encoded() ? " (delta encoded)" : "" ) << std::endl;
+    }
+}
+
+void Method::build_sell_matrix() {
+    sell_matrix_.reset();
+    if ( use_sell_matrix_ && !matrix_.empty() ) {
+        sell_matrix_.reset( new method::SellMatrix( matrix_ ) );
+        Log::debug() << "Interpolation matrix copied in SELL-C-sigma format: " << eckit::Bytes( matrix_.footprint() )
+                     << " (CSR) + " << eckit::Bytes( sell_matrix_->footprint() ) << " (SELL), padding "
+                     << sell_matrix_->paddedNonZeros() - sell_matrix_->nonZeros() << " entries" << std::endl;
+    }
 }
 
 void Method::execute( const FieldSet& source, FieldSet& target ) const {
@@ -192,6 +596,16 @@ void Method::execute( const Field& source, Field& target ) const {
     this->do_execute( source, target );
 }
 
+void Method::execute_adjoint( FieldSet& source, const FieldSet& target ) const {
+    ATLAS_TRACE( "atlas::interpolation::method::Method::execute_adjoint(FieldSet, FieldSet)" );
+    this->do_execute_adjoint( source, target );
+}
+
+void Method::execute_adjoint( Field& source, const Field& target ) const {
+    ATLAS_TRACE( "atlas::interpolation::method::Method::execute_adjoint(Field, Field)" );
+    this->do_execute_adjoint( source, target );
+}
+
 void Method::do_setup( const FunctionSpace& /*source*/, const Field& /*target*/ ) {
     ATLAS_NOTIMPLEMENTED;
 }
@@ -206,9 +620,51 @@ void Method::do_execute( const FieldSet& fieldsSource, FieldSet& fieldsTarget )
     const idx_t N = fieldsSource.size();
     ATLAS_ASSERT( N == fieldsTarget.size() );
 
-    for ( idx_t i = 0; i < fieldsSource.size(); ++i ) {
-        Log::debug() << "Method::do_execute() on field " << ( i + 1 ) << '/' << N << "..." << std::endl;
-        Method::do_execute( fieldsSource[i], fieldsTarget[i] );
+    haloExchange( fieldsSource );
+
+    // group fields of same datatype and rank that can share one pass over the matrix
+    std::vector<bool> done( N, false );
+    for ( idx_t i = 0; i < N; ++i ) {
+        if ( done[i] || !fusable( fieldsSource[i] ) ) {
+            continue;
+        }
+        FieldSet src;
+        FieldSet tgt;
+        for ( idx_t j = i; j < N; ++j ) {
+            if ( !done[j] && fieldsSource[j].datatype() == fieldsSource[i].datatype() &&
+                 fieldsSource[j].rank() == fieldsSource[i].rank() && fusable( fieldsSource[j] ) ) {
+                src.add( fieldsSource[j] );
+                tgt.add( fieldsTarget[j] );
+                done[j] = true;
+            }
+        }
+        if ( src.size() == 1 ) {
+            done[i] = false;
+            continue;
+        }
+
+        Log::debug() << "Method::do_execute() on " << src.size() << " fields together..." << std::endl;
+        if ( src[0].datatype().kind() == array::DataType::KIND_REAL64 ) {
+            interpolate_fieldset<double>( src, tgt, matrix_ );
+        }
+        else {
+            interpolate_fieldset<float>( src, tgt, matrix_ );
+        }
+
+        for ( idx_t j = 0; j < src.size(); ++j ) {
+            field::MissingValue mv( src[j] );
+            if ( mv ) {
+                mv.metadata( tgt[j] );
+            }
+            tgt[j].set_dirty();
+        }
+    }
+
+    for ( idx_t i = 0; i < N; ++i ) {
+        if ( !done[i] ) {
+            Log::debug() << "Method::do_execute() on field " << ( i + 1 ) << '/' << N << "..." << std::endl;
+            Method::do_execute( fieldsSource[i], fieldsTarget[i] );
+        }
     }
 }
 
@@ -217,16 +673,46 @@ void Method::do_execute( const Field& src, Field& tgt ) const {
 
     haloExchange( src );
 
-    // non-linearities: a non-empty M matrix contains the corrections applied to matrix_
+    // non-linearities: corrections are applied on the fly to each row of matrix_ when supported, otherwise
+    // a non-empty M matrix contains the corrections applied to matrix_
     Matrix M;
+    bool interpolated = false;
     if ( !matrix_.empty() && nonLinear_( src ) ) {
-        Matrix W( matrix_ );  // copy (a big penalty -- copy-on-write would definitely be better)
-        if ( nonLinear_->execute( W, src ) ) {
-            M.swap( W );
+        if ( not use_eckit_linalg_spmv_ ) {
+            check_compatibility( src, tgt, matrix_ );
+            interpolated = nonLinear_.interpolate( matrix_, src, tgt );
+        }
+        if ( not interpolated ) {
+            Matrix W( matrix_ );  // copy (a big penalty -- copy-on-write would definitely be better)
+            if ( nonLinear_->execute( W, src ) ) {
+                M.swap( W );
+            }
         }
     }
 
-    if ( src.datatype().kind() == array::DataType::KIND_REAL64 ) {
+    if ( interpolated ) {
+        // non-linear corrections applied on the fly
+    }
+    else if ( compressed_matrix_ ) {
+        if ( src.datatype().kind() == array::DataType::KIND_REAL64 ) {
+            interpolate_field<double>( src, tgt, *compressed_matrix_ );
+        }
+        else if ( src.datatype().kind() == array::DataType::KIND_REAL32 ) {
+            interpolate_field<float>( src, tgt, *compressed_matrix_ );
+        }
+        else {
+            ATLAS_NOTIMPLEMENTED;
+        }
+    }
+    else if ( M.empty() && use_sell_matrix( src ) ) {
+        if ( src.datatype().kind() == array::DataType::KIND_REAL64 ) {
+            interpolate_field<double>( src, tgt, *sell_matrix_ );
+        }
+        else {
+            interpolate_field<float>( src, tgt, *sell_matrix_ );
+        }
+    }
+    else if ( src.datatype().kind() == array::DataType::KIND_REAL64 ) {
         interpolate_field<double>( src, tgt, M.empty() ? matrix_ : M );
     }
     else if ( src.datatype().kind() == array::DataType::KIND_REAL32 ) {
@@ -246,6 +732,71 @@ void Method::do_execute( const Field& src, Field& tgt ) const {
     tgt.set_dirty();
 }
 
+void Method::do_execute_adjoint( FieldSet& fieldsSource, const FieldSet& fieldsTarget ) const {
+    ATLAS_TRACE( "atlas::interpolation::method::Method::do_execute_adjoint()" );
+
+    const idx_t N = fieldsSource.size();
+    ATLAS_ASSERT( N == fieldsTarget.size() );
+
+    for ( idx_t i = 0; i < fieldsSource.size(); ++i ) {
+        Method::do_execute_adjoint( fieldsSource[i], fieldsTarget[i] );
+    }
+}
+
+void Method::do_execute_adjoint( Field& src, const Field& tgt ) const {
+    ATLAS_TRACE( "atlas::interpolation::method::Method::do_execute_adjoint()" );
+
+    // NOTE: only the linear part is considered, non-linear (missing value) corrections are not applied
+    // rows of the transposed matrix are independent, so no scatter is needed
+    const Matrix& Wt = matrix_transpose();
+    ATLAS_ASSERT( !Wt.empty() );
+    ATLAS_ASSERT( src.shape( 0 ) == static_cast<idx_t>( Wt.rows() ) );
+
+    if ( src.datatype().kind() == array::DataType::KIND_REAL64 ) {
+        interpolate_field<double>( tgt, src, Wt );
+    }
+    else if ( src.datatype().kind() == array::DataType::KIND_REAL32 ) {
+        interpolate_field<float>( tgt, src, Wt );
+    }
+    else {
+        ATLAS_NOTIMPLEMENTED;
+    }
+
+    adjointHaloExchange( src );
+    src.set_dirty();
+}
+
+void Method::clear_matrix_transpose() {
+    std::lock_guard<std::mutex> lock( matrix_transpose_mutex_ );
+    Matrix().swap( matrix_transpose_ );
+}
+
+const Method::Matrix& Method::matrix_transpose() const {
+    std::lock_guard<std::mutex> lock( matrix_transpose_mutex_ );
+
+    if ( matrix_transpose_.empty() && ( !matrix_.empty() || compressed_matrix_ ) ) {
+        ATLAS_TRACE( "atlas::interpolation::method::Method::matrix_transpose()" );
+        const Matrix W    = compressed_matrix_ ? compressed_matrix_->decompress() : Matrix();
+        const Matrix& A   = compressed_matrix_ ? W : matrix_;
+        const auto outer  = A.outer();
+        const auto index  = A.inner();
+        const auto weight = A.data();
+
+        Triplets triplets;
+        triplets.reserve( A.nonZeros() );
+        for ( size_t r = 0; r < A.rows(); ++r ) {
+            for ( auto c = outer[r]; c < outer[r + 1]; ++c ) {
+                triplets.emplace_back( index[c], r, weight[c] );
+            }
+        }
+        std::sort( triplets.begin(), triplets.end() );
+
+        Matrix Wt( A.cols(), A.rows(), triplets );
+        matrix_transpose_.swap( Wt );
+    }
+    return matrix_transpose_;
+}
+
 void Method::normalise( Triplets& triplets ) {
     // sum all calculated weights for normalisation
     double sum = 0.0;
@@ -262,8 +813,15 @@ void Method::normalise( Triplets& triplets ) {
 }
 
 void Method::haloExchange( const FieldSet& fields ) const {
+    // exchange all dirty fields in one call to the functionspace
+    FieldSet dirty;
     for ( auto& field : fields ) {
-        haloExchange( field );
+        if ( field.dirty() ) {
+            dirty.add( field );
+        }
+    }
+    if ( dirty.size() ) {
+        source().haloExchange( dirty );
     }
 }
 void Method::haloExchange( const Field& field ) const {
@@ -272,5 +830,12 @@ void Method::haloExchange( const Field& field ) const {
     }
 }
 
+void Method::adjointHaloExchange( const FieldSet& fields ) const {
+    source().adjointHaloExchange( fields );
+}
+void Method::adjointHaloExchange( const Field& field ) const {
+    source().adjointHaloExchange( field );
+}
+
 }  // namespace interpolation
 }  // namespace atlas
@@ -11,10 +11,15 @@
 #pragma once
 
 #include <iosfwd>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "atlas/interpolation/NonLinear.h"
+#include "atlas/interpolation/method/CompressedMatrix.h"
+#include "atlas/interpolation/method/SellMatrix.h"
+#include "atlas/library/config.h"
 #include "atlas/util/Object.h"
 #include "eckit/config/Configuration.h"
 #include "eckit/linalg/SparseMatrix.h"
@@ -49,6 +54,14 @@ public:
     void execute( const FieldSet& source, FieldSet& target ) const;
     void execute( const Field& source, Field& target ) const;
 
+    /**
+     * @brief Apply the adjoint (transpose) of the interpolation, accumulating into the source
+     * @param source field(s) on the source functionspace, overwritten with the adjoint result
+     * @param target field(s) on the target functionspace
+     */
+    void execute_adjoint( FieldSet& source, const FieldSet& target ) const;
+    void execute_adjoint( Field& source, const Field& target ) const;
+
     virtual void print( std::ostream& ) const = 0;
 
     virtual const FunctionSpace& source() const = 0;
@@ -58,6 +71,9 @@ protected:
     virtual void do_execute( const FieldSet& source, FieldSet& target ) const;
     virtual void do_execute( const Field& source, Field& target ) const;
 
+    virtual void do_execute_adjoint( FieldSet& source, const FieldSet& target ) const;
+    virtual void do_execute_adjoint( Field& source, const Field& target ) const;
+
     using Triplet  = eckit::linalg::Triplet;
     using Triplets = std::vector<Triplet>;
     using Matrix   = eckit::linalg::SparseMatrix;
@@ -67,10 +83,28 @@ protected:
     void haloExchange( const FieldSet& ) const;
     void haloExchange( const Field& ) const;
 
+    void adjointHaloExchange( const FieldSet& ) const;
+    void adjointHaloExchange( const Field& ) const;
+
+    /// @brief Transpose of matrix_, computed once on first use
+    const Matrix& matrix_transpose() const;
+
     // NOTE : Matrix-free operators do not have matrices (!), so do not expose here
     Matrix matrix_;
     NonLinear nonLinear_;
     bool use_eckit_linalg_spmv_;
+    idx_t fieldset_block_size_;
+
+    /// Single precision copy of matrix_, which is then released (config "matrix_storage" = "float"); code reading
+    /// the matrix after setup, such as print(), must then read this copy
+    std::unique_ptr<method::CompressedMatrix> compressed_matrix_;
+    bool compress_matrix_;
+    bool matrix_delta_encoding_;
+
+    /// Copy of matrix_ in the SELL-C-sigma format, used for rank-1 fields and rank-2 fields with few levels
+    /// if configured with "sell_matrix" = true
+    std::unique_ptr<method::SellMatrix> sell_matrix_;
+    bool use_sell_matrix_;
 
 protected:
     virtual void do_setup( const FunctionSpace& source, const FunctionSpace& target ) = 0;
@@ -91,6 +125,39 @@ private:
     template <typename Value>
     void interpolate_field_rank3( const Field& src, Field& tgt, const Matrix& ) const;
 
+    template <typename Value>
+    void interpolate_fieldset( const FieldSet& src, FieldSet& tgt, const Matrix& ) const;
+
+    template <typename Value>
+    void interpolate_fieldset_rank1( const FieldSet& src, FieldSet& tgt, const Matrix& ) const;
+
+    template <typename Value>
+    void interpolate_fieldset_rank2( const FieldSet& src, FieldSet& tgt, const Matrix& ) const;
+
+    bool fusable( const Field& src ) const;
+
+    template <typename Value>
+    void interpolate_field( const Field& src, Field& tgt, const method::CompressedMatrix& ) const;
+
+    template <typename Value>
+    void interpolate_field( const Field& src, Field& tgt, const method::SellMatrix& ) const;
+
+    /// Replace matrix_ by its compressed copy, if configured
+    void compress_matrix();
+
+    /// Build sell_matrix_ from matrix_, if configured
+    void build_sell_matrix();
+
+    /// Whether the field is interpolated with sell_matrix_ rather than matrix_
+    bool use_sell_matrix( const Field& src ) const;
+
+    /// Drop the transpose of the matrix of a previous setup
+    void clear_matrix_transpose();
+
+    /// Guards matrix_transpose_, which is built on first use by matrix_transpose() and cleared by setup()
+    mutable std::mutex matrix_transpose_mutex_;
+    mutable Matrix matrix_transpose_;
+
     void check_compatibility( const Field& src, const Field& tgt, const Matrix& W ) const;
 };
 
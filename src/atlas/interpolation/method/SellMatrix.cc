@@ -0,0 +1,106 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/interpolation/method/SellMatrix.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Trace.h"
+
+namespace atlas {
+namespace interpolation {
+namespace method {
+
+constexpr idx_t SellMatrix::C;
+
+SellMatrix::SellMatrix( const Matrix& W, idx_t sigma ) :
+    rows_( W.rows() ), cols_( W.cols() ), nonZeros_( W.nonZeros() ) {
+    ATLAS_TRACE( "atlas::interpolation::method::SellMatrix" );
+    ATLAS_ASSERT( sigma > 0 );
+    sigma = ( ( sigma + C - 1 ) / C ) * C;
+
+    const auto outer  = W.outer();
+    const auto index  = W.inner();
+    const auto weight = W.data();
+
+    const idx_t nb_rows = static_cast<idx_t>( rows_ );
+
+    auto length = [&]( idx_t r ) { return static_cast<idx_t>( outer[r + 1] - outer[r] ); };
+
+    // Sort rows by decreasing length within each window, keeping the original order for equal lengths
+    std::vector<idx_t> sorted( nb_rows );
+    std::iota( sorted.begin(), sorted.end(), 0 );
+    for ( idx_t begin = 0; begin < nb_rows; begin += sigma ) {
+        const idx_t end = std::min( begin + sigma, nb_rows );
+        std::stable_sort( sorted.begin() + begin, sorted.begin() + end,
+                          [&]( idx_t a, idx_t b ) { return length( a ) > length( b ); } );
+    }
+
+    // Rows without entries are left out of the chunks, as their lanes would otherwise read a padding column
+    for ( const idx_t r : sorted ) {
+        if ( length( r ) > 0 ) {
+            row_.emplace_back( r );
+        }
+        else {
+            empty_rows_.emplace_back( r );
+        }
+    }
+    std::sort( empty_rows_.begin(), empty_rows_.end() );
+    const idx_t nb_chunks = ( static_cast<idx_t>( row_.size() ) + C - 1 ) / C;
+    row_.resize( nb_chunks * C, -1 );
+
+    offset_.resize( nb_chunks + 1 );
+    width_.resize( nb_chunks );
+    offset_[0] = 0;
+    for ( idx_t i = 0; i < nb_chunks; ++i ) {
+        idx_t width = 0;
+        for ( idx_t l = 0; l < C; ++l ) {
+            const idx_t r = row_[i * C + l];
+            if ( r >= 0 ) {
+                width = std::max( width, length( r ) );
+            }
+        }
+        width_[i]      = width;
+        offset_[i + 1] = offset_[i] + static_cast<size_t>( width ) * C;
+    }
+
+    weights_.assign( offset_[nb_chunks], 0. );
+    inner_.assign( offset_[nb_chunks], 0 );
+    for ( idx_t i = 0; i < nb_chunks; ++i ) {
+        for ( idx_t l = 0; l < C; ++l ) {
+            const idx_t r = row_[i * C + l];
+            if ( r < 0 ) {
+                continue;
+            }
+            const idx_t n = length( r );
+            idx_t col     = 0;
+            for ( idx_t j = 0; j < width_[i]; ++j ) {
+                const size_t e = offset_[i] + static_cast<size_t>( j ) * C + l;
+                if ( j < n ) {
+                    col         = index[outer[r] + j];
+                    weights_[e] = weight[outer[r] + j];
+                }
+                inner_[e] = col;
+            }
+        }
+    }
+}
+
+size_t SellMatrix::footprint() const {
+    return sizeof( *this ) + offset_.capacity() * sizeof( size_t ) + width_.capacity() * sizeof( idx_t ) +
+           row_.capacity() * sizeof( idx_t ) + weights_.capacity() * sizeof( double ) +
+           inner_.capacity() * sizeof( idx_t ) + empty_rows_.capacity() * sizeof( idx_t );
+}
+
+}  // namespace method
+}  // namespace interpolation
+}  // namespace atlas
@@ -0,0 +1,86 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "eckit/linalg/SparseMatrix.h"
+
+#include "atlas/library/config.h"
+
+namespace atlas {
+namespace interpolation {
+namespace method {
+
+/**
+ * @class SellMatrix
+ *
+ * Read-only copy of an interpolation matrix in the sliced ELLPACK format (SELL-C-sigma).
+ *
+ * Rows are grouped in chunks of C consecutive rows, after sorting them by decreasing number of entries within
+ * windows of sigma rows. All rows of a chunk are padded to the length of the longest one, and the entries of a chunk
+ * are stored column-major, so that the C rows of a chunk are computed together with contiguous loads of weights
+ * and column indices. Padding entries have weight zero and repeat the last column of their row, so that the result
+ * of each row is identical to the CSR product (same order of summation). Rows without entries have no column to
+ * repeat, so they are not stored in chunks, and are listed by empty_rows() instead.
+ */
+class SellMatrix {
+public:
+    using Matrix = eckit::linalg::SparseMatrix;
+
+    /// Number of rows per chunk
+    static constexpr idx_t C = 8;
+
+    /// @param sigma sorting window, in number of rows (rounded up to a multiple of C)
+    SellMatrix( const Matrix&, idx_t sigma = 32 * C );
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t nonZeros() const { return nonZeros_; }
+
+    /// Number of entries including padding
+    size_t paddedNonZeros() const { return weights_.size(); }
+
+    /// Memory used, in bytes
+    size_t footprint() const;
+
+    idx_t chunks() const { return static_cast<idx_t>( width_.size() ); }
+
+    /// Entries of chunk i start at offset(i), and entry j of lane l of the chunk is at offset(i) + j * C + l
+    size_t offset( idx_t chunk ) const { return offset_[chunk]; }
+
+    /// Number of entries of each row of a chunk, including padding
+    idx_t width( idx_t chunk ) const { return width_[chunk]; }
+
+    /// Row of the matrix computed by lane l of chunk i, or -1 for the padding lanes of the last chunk
+    const idx_t* row() const { return row_.data(); }
+
+    /// Rows without entries, whose result is zero; these are not computed by any chunk
+    const std::vector<idx_t>& empty_rows() const { return empty_rows_; }
+
+    const double* data() const { return weights_.data(); }
+    const idx_t* inner() const { return inner_.data(); }
+
+private:
+    size_t rows_;
+    size_t cols_;
+    size_t nonZeros_;
+    std::vector<size_t> offset_;
+    std::vector<idx_t> width_;
+    std::vector<idx_t> row_;
+    std::vector<double> weights_;
+    std::vector<idx_t> inner_;
+    std::vector<idx_t> empty_rows_;
+};
+
+}  // namespace method
+}  // namespace interpolation
+}  // namespace atlas
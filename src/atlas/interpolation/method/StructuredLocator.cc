@@ -0,0 +1,205 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/interpolation/method/StructuredLocator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "atlas/array.h"
+#include "atlas/domain/Domain.h"
+#include "atlas/mesh/Halo.h"
+#include "atlas/mesh/HybridElements.h"
+#include "atlas/mesh/Mesh.h"
+#include "atlas/mesh/Nodes.h"
+#include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/Constants.h"
+#include "atlas/util/CoordinateEnums.h"
+
+namespace atlas {
+namespace interpolation {
+namespace method {
+
+namespace {
+
+PointXYZ unit_sphere_xyz( double lon, double lat ) {
+    const double lambda  = lon * util::Constants::degreesToRadians();
+    const double phi     = lat * util::Constants::degreesToRadians();
+    const double cos_phi = std::cos( phi );
+    return PointXYZ{cos_phi * std::cos( lambda ), cos_phi * std::sin( lambda ), std::sin( phi )};
+}
+
+double distance2( const PointXYZ& a, const PointXYZ& b ) {
+    const double dx = a.x() - b.x();
+    const double dy = a.y() - b.y();
+    const double dz = a.z() - b.z();
+    return dx * dx + dy * dy + dz * dz;
+}
+
+}  // namespace
+
+bool StructuredLocator::applicable( const Mesh& mesh ) {
+    if ( not mesh.grid() ) {
+        return false;
+    }
+    StructuredGrid grid( mesh.grid() );
+    if ( not grid || not grid.domain().global() || grid.projection() || grid.ny() < 2 ) {
+        return false;
+    }
+    for ( idx_t j = 0; j < grid.ny(); ++j ) {
+        if ( grid.nx( j ) < 2 ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+StructuredLocator::StructuredLocator( const Mesh& mesh ) : StructuredLocator( mesh, mesh::Halo( mesh ) ) {}
+
+StructuredLocator::StructuredLocator( const Mesh& mesh, const mesh::Halo& halo ) {
+    ATLAS_TRACE( "atlas::interpolation::method::StructuredLocator" );
+    ATLAS_ASSERT( applicable( mesh ) );
+
+    grid_          = StructuredGrid( mesh.grid() );
+    compute_north_ = grid::ComputeNorth( grid_, 1 );
+    compute_west_  = grid::ComputeWest( grid_, 1 );
+
+    const auto& nodes    = mesh.nodes();
+    const auto gidx      = array::make_view<gidx_t, 1>( nodes.global_index() );
+    const auto ghost     = array::make_view<int, 1>( nodes.ghost() );
+    const auto node_halo = array::make_view<int, 1>( nodes.halo() );
+    const auto lonlat    = array::make_view<double, 2>( nodes.lonlat() );
+    const idx_t nb_nodes = nodes.size();
+    const gidx_t size    = grid_.size();
+    const int h          = halo.size();
+
+    // Grid points are the nodes with global index 1..size; prefer owned nodes over ghost copies
+    node_.assign( size, -1 );
+    std::vector<idx_t> other_nodes;
+    for ( idx_t n = 0; n < nb_nodes; ++n ) {
+        if ( node_halo( n ) > h ) {
+            continue;
+        }
+        const gidx_t g = gidx( n ) - 1;
+        if ( g >= 0 && g < size ) {
+            idx_t& mapped = node_[g];
+            if ( mapped < 0 || ( ghost( mapped ) && not ghost( n ) ) ) {
+                mapped = n;
+            }
+        }
+        else {
+            other_nodes.push_back( n );
+        }
+    }
+
+    // Other nodes, such as periodic copies, do not change the nearest node as long as they coincide with grid points
+    for ( idx_t n : other_nodes ) {
+        double d2;
+        nearestGridPoint( PointLonLat{lonlat( n, LON ), lonlat( n, LAT )}, d2 );
+        if ( d2 > 1.e-20 ) {
+            nodes_are_grid_points_ = false;
+            break;
+        }
+    }
+
+    // Cells connected to each node
+    const auto& connectivity = mesh.cells().node_connectivity();
+    const idx_t nb_cells     = mesh.cells().size();
+    cells_offset_.assign( nb_nodes + 1, 0 );
+    for ( idx_t c = 0; c < nb_cells; ++c ) {
+        for ( idx_t k = 0; k < connectivity.cols( c ); ++k ) {
+            ++cells_offset_[connectivity( c, k ) + 1];
+        }
+    }
+    for ( idx_t n = 0; n < nb_nodes; ++n ) {
+        cells_offset_[n + 1] += cells_offset_[n];
+    }
+    cells_.resize( cells_offset_[nb_nodes] );
+    std::vector<idx_t> position( cells_offset_.begin(), cells_offset_.end() - 1 );
+    for ( idx_t c = 0; c < nb_cells; ++c ) {
+        for ( idx_t k = 0; k < connectivity.cols( c ); ++k ) {
+            cells_[position[connectivity( c, k )]++] = c;
+        }
+    }
+}
+
+void StructuredLocator::cells( const PointLonLat& p, std::vector<idx_t>& cells ) const {
+    cells.clear();
+    const idx_t ny = grid_.ny();
+    const idx_t j  = compute_north_( p.lat() );
+    for ( idx_t jj = std::max<idx_t>( j, 0 ); jj <= std::min<idx_t>( j + 1, ny - 1 ); ++jj ) {
+        // one more grid point on either side, as cells between two rows of a reduced grid can be skewed
+        const idx_t i = compute_west_( p.lon(), jj );
+        for ( idx_t ii = i - 1; ii <= i + 2; ++ii ) {
+            const idx_t n = node( ii, jj );
+            if ( n < 0 ) {
+                continue;
+            }
+            for ( idx_t k = cells_offset_[n]; k < cells_offset_[n + 1]; ++k ) {
+                if ( std::find( cells.begin(), cells.end(), cells_[k] ) == cells.end() ) {
+                    cells.push_back( cells_[k] );
+                }
+            }
+        }
+    }
+}
+
+idx_t StructuredLocator::nearestNode( const PointLonLat& p ) const {
+    double d2;
+    return node_[nearestGridPoint( p, d2 )];
+}
+
+gidx_t StructuredLocator::nearestGridPoint( const PointLonLat& p, double& distance2_min ) const {
+    const PointXYZ P = unit_sphere_xyz( p.lon(), p.lat() );
+    const idx_t ny   = grid_.ny();
+
+    gidx_t nearest = 0;
+    distance2_min  = std::numeric_limits<double>::max();
+
+    // On a row, the closest grid points are the ones west and east of p. Rows are visited away from p until their
+    // latitude alone is further than the closest grid point found so far.
+    auto visit_row = [&]( idx_t j ) {
+        const double dlat  = std::abs( p.lat() - grid_.y( j ) ) * util::Constants::degreesToRadians();
+        const double bound = 2. * std::sin( 0.5 * dlat );
+        if ( bound * bound > distance2_min ) {
+            return false;
+        }
+        const idx_t nx = grid_.nx( j );
+        const idx_t i  = compute_west_( p.lon(), j );
+        for ( idx_t ii = i; ii <= i + 1; ++ii ) {
+            const idx_t iw  = ( ( ii % nx ) + nx ) % nx;
+            const double d2 = distance2( P, unit_sphere_xyz( grid_.x( iw, j ), grid_.y( j ) ) );
+            if ( d2 < distance2_min ) {
+                distance2_min = d2;
+                nearest       = grid_.index( iw, j );
+            }
+        }
+        return true;
+    };
+
+    const idx_t j = compute_north_( p.lat() );
+    for ( idx_t jj = std::min<idx_t>( j, ny - 1 ); jj >= 0; --jj ) {
+        if ( not visit_row( jj ) ) {
+            break;
+        }
+    }
+    for ( idx_t jj = std::max<idx_t>( j + 1, 0 ); jj < ny; ++jj ) {
+        if ( not visit_row( jj ) ) {
+            break;
+        }
+    }
+    return nearest;
+}
+
+}  // namespace method
+}  // namespace interpolation
+}  // namespace atlas
@@ -0,0 +1,86 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "atlas/grid/StencilComputer.h"
+#include "atlas/grid/StructuredGrid.h"
+#include "atlas/library/config.h"
+#include "atlas/util/Point.h"
+
+namespace atlas {
+class Mesh;
+namespace mesh {
+class Halo;
+}
+}  // namespace atlas
+
+namespace atlas {
+namespace interpolation {
+namespace method {
+
+/**
+ * @class StructuredLocator
+ *
+ * Locates points in a mesh generated from a global StructuredGrid, without search tree.
+ *
+ * The grid rows north and south of a point, and the grid points west and east of it on these rows, follow from
+ * latitude and longitude arithmetic (grid::ComputeNorth, grid::ComputeWest). The grid points are mapped to the mesh
+ * nodes with the same global index, which gives in constant time per point the candidate cells containing it, or the
+ * nearest node. Points that cannot be located this way (e.g. grid points outside of the mesh partition) are
+ * reported, so that the caller can fall back to a search tree.
+ */
+class StructuredLocator {
+public:
+    /// True if the mesh was generated from a global StructuredGrid, without projection
+    static bool applicable( const Mesh& );
+
+    /// Locate nodes of the mesh up to its full halo
+    StructuredLocator( const Mesh& );
+
+    /// Locate nodes of the mesh up to the given halo only
+    StructuredLocator( const Mesh&, const mesh::Halo& );
+
+    /// Cells of the mesh connected to the grid points surrounding p, one of which contains p if the mesh covers p
+    void cells( const PointLonLat& p, std::vector<idx_t>& cells ) const;
+
+    /// Node of the mesh closest to p, as a search tree on 3D coordinates would find it,
+    /// or -1 if the closest grid point is not a node of the mesh
+    idx_t nearestNode( const PointLonLat& p ) const;
+
+    /// True if all nodes of the mesh (up to the halo) coincide with grid points, as required by nearestNode()
+    bool nodesAreGridPoints() const { return nodes_are_grid_points_; }
+
+private:
+    /// Index of the grid point closest to p, and its squared chord distance to p on the unit sphere
+    gidx_t nearestGridPoint( const PointLonLat& p, double& distance2 ) const;
+
+    /// Node of the grid point (i,j), with i taken periodically, or -1
+    idx_t node( idx_t i, idx_t j ) const {
+        const idx_t nx = grid_.nx( j );
+        i %= nx;
+        return node_[grid_.index( i < 0 ? i + nx : i, j )];
+    }
+
+private:
+    StructuredGrid grid_;
+    grid::ComputeNorth compute_north_;
+    grid::ComputeWest compute_west_;
+    std::vector<idx_t> node_;          // mesh node of each grid point, or -1
+    std::vector<idx_t> cells_offset_;  // cells connected to mesh node n: cells_[cells_offset_[n]:cells_offset_[n+1]]
+    std::vector<idx_t> cells_;
+    bool nodes_are_grid_points_{true};
+};
+
+}  // namespace method
+}  // namespace interpolation
+}  // namespace atlas
@@ -8,15 +8,18 @@
  * nor does it submit to any jurisdiction. and Interpolation
  */
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <limits>
+#include <sstream>
 
 #include "FiniteElement.h"
 
 #include "eckit/log/Plural.h"
 #include "eckit/log/ProgressTimer.h"
 #include "eckit/log/Seconds.h"
+#include "eckit/utils/MD5.h"
 
 #include "atlas/functionspace/NodeColumns.h"
 #include "atlas/functionspace/PointCloud.h"
@@ -25,6 +28,7 @@
 #include "atlas/interpolation/element/Triag3D.h"
 #include "atlas/interpolation/method/MethodFactory.h"
 #include "atlas/interpolation/method/Ray.h"
+#include "atlas/interpolation/method/StructuredLocator.h"
 #include "atlas/mesh/ElementType.h"
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/actions/BuildCellCentres.h"
@@ -33,12 +37,14 @@
 #include "atlas/parallel/GatherScatter.h"
 #include "atlas/parallel/mpi/Buffer.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/Earth.h"
 #include "atlas/util/Point.h"
+#include "atlas/util/detail/FlatKDTree.h"
 
 
 namespace atlas {
@@ -52,6 +58,9 @@ MethodBuilder<FiniteElement> __builder( "finite-element" );
 // epsilon used to scale edge tolerance when projecting ray to intesect element
 static const double parametricEpsilon = 1e-15;
 
+// search tree of element centres, with payload the element index; searches are thread-safe
+using ElementCentreTree = util::detail::FlatKDTree<idx_t, PointXYZ>;
+
 }  // namespace
 
 
@@ -127,7 +136,11 @@ void FiniteElement::print( std::ostream& out ) const {
     }
     auto gidx_src = array::make_view<gidx_t, 1>( src.nodes().global_index() );
 
-    ATLAS_ASSERT( tgt.nodes().size() == idx_t( matrix_.rows() ) );
+    // the matrix may be stored in single precision (config "matrix_storage" = "float")
+    const Matrix W  = compressed_matrix_ ? compressed_matrix_->decompress() : Matrix();
+    const Matrix& A = compressed_matrix_ ? W : matrix_;
+
+    ATLAS_ASSERT( tgt.nodes().size() == idx_t( A.rows() ) );
 
 
     auto field_stencil_points_loc  = tgt.createField<gidx_t>( option::variables( Stencil::max_stencil_size ) );
@@ -139,7 +152,7 @@ void FiniteElement::print( std::ostream& out ) const {
     auto stencil_size_loc    = array::make_view<idx_t, 1>( field_stencil_size_loc );
     stencil_size_loc.assign( 0 );
 
-    for ( Matrix::const_iterator it = matrix_.begin(); it != matrix_.end(); ++it ) {
+    for ( Matrix::const_iterator it = A.begin(); it != A.end(); ++it ) {
         idx_t p                     = idx_t( it.row() );
         idx_t& i                    = stencil_size_loc( p );
         stencil_points_loc( p, i )  = gidx_src( it.col() );
@@ -197,12 +210,61 @@ void FiniteElement::setup( const FunctionSpace& source ) {
     Field source_xyz = mesh::actions::BuildXYZField( "xyz" )( meshSource );
 
     // generate barycenters of each triangle & insert them on a kd-tree
-    util::Config config;
-    config.set( "name", "centre " );
-    config.set( "flatten_virtual_elements", false );
-    Field cell_centres = mesh::actions::BuildCellCentres( config )( meshSource );
+    std::unique_ptr<ElementCentreTree> eTree;
+    auto build_element_tree = [&]() {
+        ATLAS_TRACE( "Build element kd-tree" );
+        util::Config config;
+        config.set( "name", "centre " );
+        config.set( "flatten_virtual_elements", false );
+        Field cell_centres      = mesh::actions::BuildCellCentres( config )( meshSource );
+        auto centres            = array::make_view<double, 2>( cell_centres );
+        const idx_t nb_elements = centres.shape( 0 );
+        eTree.reset( new ElementCentreTree );
+
+        // reuse a tree stored for the same element centres, identified by a hash of the centres and their indices
+        std::string path;
+        std::string key;
+        if ( not search_tree_cache_.empty() ) {
+            eckit::MD5 md5;
+            for ( idx_t j = 0; j < nb_elements; ++j ) {
+                const double xyz[] = {centres( j, XX ), centres( j, YY ), centres( j, ZZ )};
+                md5.add( xyz, sizeof( xyz ) );
+                md5.add( long( j ) );
+            }
+            key  = md5.digest();
+            path = search_tree_cache_ + "/atlas-element-search-tree-" + key + ".bin";
+            if ( eTree->open( path, key ) ) {
+                Log::debug() << "Element search tree read from " << path << std::endl;
+                return;
+            }
+        }
+
+        eTree->reserve( nb_elements );
+        for ( idx_t j = 0; j < nb_elements; ++j ) {
+            eTree->insert( PointXYZ{centres( j, XX ), centres( j, YY ), centres( j, ZZ )}, j );
+        }
+        eTree->build();
+
+        if ( not path.empty() ) {
+            try {
+                eTree->write( path, key );
+                Log::debug() << "Element search tree written to " << path << std::endl;
+            }
+            catch ( const eckit::Exception& e ) {
+                Log::warning() << "Element search tree could not be written to cache: " << e.what() << std::endl;
+            }
+        }
+    };
 
-    std::unique_ptr<ElemIndex3> eTree( create_element_kdtree( cell_centres ) );
+    // on structured source meshes, candidate elements follow directly from the grid structure, and the kd-tree is
+    // only built if some point cannot be located that way
+    std::unique_ptr<StructuredLocator> locator;
+    if ( use_structured_locator_ && StructuredLocator::applicable( meshSource ) ) {
+        locator.reset( new StructuredLocator( meshSource ) );
+    }
+    else {
+        build_element_tree();
+    }
 
     trace_setup_source.stop();
 
@@ -226,9 +288,6 @@ void FiniteElement::setup( const FunctionSpace& source ) {
 
     // weights -- one per vertex of element, triangles (3) or quads (4)
 
-    Triplets weights_triplets;                 // structure to fill-in sparse matrix
-    weights_triplets.reserve( out_npts * 4 );  // preallocate space as if all elements where quads
-
     // search nearest k cell centres
 
     const idx_t maxNbElemsToTry = std::max<idx_t>( 64, idx_t( Nelements * maxFractionElemsToTry ) );
@@ -236,43 +295,142 @@ void FiniteElement::setup( const FunctionSpace& source ) {
 
     std::vector<size_t> failures;
 
+    // Target points are split in contiguous chunks, each with its own buffers; concatenating these in chunk order
+    // gives the same triplets (and failure report) as a serial loop, independently of the number of threads.
+    struct Chunk {
+        Triplets triplets;
+        std::vector<idx_t> unlocated;  // points to search with the element kd-tree, in increasing order
+        std::vector<std::string> unlocated_log;
+        std::vector<size_t> failures;
+        std::ostringstream failures_log;
+        idx_t max_neighbours = 0;
+    };
+    const idx_t nb_chunks = std::min<idx_t>( out_npts, 8 * atlas_omp_get_max_threads() );
+    std::vector<Chunk> chunks( nb_chunks );
+
     ATLAS_TRACE_SCOPE( "Computing interpolation matrix" ) {
         eckit::ProgressTimer progress( "Computing interpolation weights", out_npts, "point", double( 5 ),
                                        Log::debug() );
-        for ( idx_t ip = 0; ip < out_npts; ++ip, ++progress ) {
-            if ( out_ghosts( ip ) ) {
-                continue;
+        auto advance_progress = [&progress]( size_t nb_points ) {
+            // ProgressTimer is not thread-safe, so it is advanced once per chunk
+            atlas_omp_critical {
+                for ( size_t i = 0; i < nb_points; ++i ) {
+                    ++progress;
+                }
             }
+        };
 
-            PointXYZ p{( *ocoords_ )( ip, 0 ), ( *ocoords_ )( ip, 1 ), ( *ocoords_ )( ip, 2 )};  // lookup point
+        // candidate elements from the grid structure, if possible
+        atlas_omp_parallel_for( idx_t c = 0; c < nb_chunks; ++c ) {
+            Chunk& chunk         = chunks[c];
+            const idx_t ip_begin = ( out_npts * c ) / nb_chunks;
+            const idx_t ip_end   = ( out_npts * ( c + 1 ) ) / nb_chunks;
+            chunk.triplets.reserve( ( ip_end - ip_begin ) * 4 );  // as if all elements where quads
+            std::vector<idx_t> candidates;
+
+            for ( idx_t ip = ip_begin; ip < ip_end; ++ip ) {
+                if ( out_ghosts( ip ) ) {
+                    continue;
+                }
 
-            idx_t kpts   = 1;
-            bool success = false;
-            std::ostringstream failures_log;
+                std::ostringstream failures_log;
 
-            while ( !success && kpts <= maxNbElemsToTry ) {
-                max_neighbours = std::max( kpts, max_neighbours );
+                if ( locator ) {
+                    locator->cells( PointLonLat{out_lonlat( ip, LON ), out_lonlat( ip, LAT )}, candidates );
+                    if ( candidates.size() ) {
+                        Triplets triplets = projectPointToElements( ip, candidates, failures_log );
+                        if ( triplets.size() ) {
+                            std::copy( triplets.begin(), triplets.end(), std::back_inserter( chunk.triplets ) );
+                            continue;
+                        }
+                    }
+                }
 
-                ElemIndex3::NodeList cs = eTree->kNearestNeighbours( p, kpts );
-                Triplets triplets       = projectPointToElements( ip, cs, failures_log );
+                chunk.unlocated.push_back( ip );
+                chunk.unlocated_log.push_back( failures_log.str() );
+            }
+            advance_progress( ip_end - ip_begin - chunk.unlocated.size() );
+        }
 
-                if ( triplets.size() ) {
-                    std::copy( triplets.begin(), triplets.end(), std::back_inserter( weights_triplets ) );
-                    success = true;
-                }
-                kpts *= 2;
+        // candidate elements from the element kd-tree, for the remaining points
+        size_t nb_unlocated = 0;
+        for ( const auto& chunk : chunks ) {
+            nb_unlocated += chunk.unlocated.size();
+        }
+        if ( nb_unlocated ) {
+            if ( not eTree ) {
+                build_element_tree();  // outside of the parallel region, as it traces and modifies the mesh
             }
+            atlas_omp_parallel_for( idx_t c = 0; c < nb_chunks; ++c ) {
+                Chunk& chunk = chunks[c];
+                Triplets located;
+                located.swap( chunk.triplets );
+                Triplets searched;
+                std::vector<ElementCentreTree::Neighbour> neighbours;
+                std::vector<idx_t> cs;
+
+                for ( size_t j = 0; j < chunk.unlocated.size(); ++j ) {
+                    const idx_t ip = chunk.unlocated[j];
+
+                    PointXYZ p{( *ocoords_ )( ip, 0 ), ( *ocoords_ )( ip, 1 ), ( *ocoords_ )( ip, 2 )};  // lookup point
+
+                    idx_t kpts   = 1;
+                    bool success = false;
+                    std::ostringstream failures_log;
+                    failures_log << chunk.unlocated_log[j];
+
+                    while ( !success && kpts <= maxNbElemsToTry ) {
+                        chunk.max_neighbours = std::max( kpts, chunk.max_neighbours );
+
+                        eTree->closestPoints( p, kpts, neighbours );
+                        cs.clear();
+                        for ( const auto& neighbour : neighbours ) {
+                            cs.push_back( eTree->payload( neighbour.index ) );
+                        }
+                        Triplets triplets = projectPointToElements( ip, cs, failures_log );
 
-            if ( !success ) {
-                failures.push_back( ip );
-                Log::debug() << "------------------------------------------------------"
-                                "---------------------\n";
-                const PointLonLat pll{out_lonlat( ip, 0 ), out_lonlat( ip, 1 )};
-                Log::debug() << "Failed to project point (lon,lat)=" << pll << '\n';
-                Log::debug() << failures_log.str();
+                        if ( triplets.size() ) {
+                            std::copy( triplets.begin(), triplets.end(), std::back_inserter( searched ) );
+                            success = true;
+                        }
+                        kpts *= 2;
+                    }
+
+                    if ( !success ) {
+                        chunk.failures.push_back( ip );
+                        const PointLonLat pll{out_lonlat( ip, 0 ), out_lonlat( ip, 1 )};
+                        chunk.failures_log << "------------------------------------------------------"
+                                              "---------------------\n";
+                        chunk.failures_log << "Failed to project point (lon,lat)=" << pll << '\n';
+                        chunk.failures_log << failures_log.str();
+                    }
+                }
+
+                // both are ordered by target point, so merging them keeps the order of a serial loop
+                chunk.triplets.reserve( located.size() + searched.size() );
+                std::merge( located.begin(), located.end(), searched.begin(), searched.end(),
+                            std::back_inserter( chunk.triplets ),
+                            []( const Triplet& a, const Triplet& b ) { return a.row() < b.row(); } );
+                advance_progress( chunk.unlocated.size() );
             }
         }
     }
+
+    size_t nb_triplets = 0;
+    for ( const auto& chunk : chunks ) {
+        nb_triplets += chunk.triplets.size();
+    }
+    Triplets weights_triplets;  // structure to fill-in sparse matrix
+    weights_triplets.reserve( nb_triplets );
+    for ( auto& chunk : chunks ) {
+        weights_triplets.insert( weights_triplets.end(), chunk.triplets.begin(), chunk.triplets.end() );
+        Triplets().swap( chunk.triplets );
+        failures.insert( failures.end(), chunk.failures.begin(), chunk.failures.end() );
+        max_neighbours = std::max( max_neighbours, chunk.max_neighbours );
+        if ( chunk.failures.size() ) {
+            Log::debug() << chunk.failures_log.str();
+        }
+    }
     Log::debug() << "Maximum neighbours searched was " << eckit::Plural( max_neighbours, "element" ) << std::endl;
 
     eckit::mpi::comm().barrier();
@@ -304,6 +462,16 @@ struct ElementEdge {
 };
 
 Method::Triplets FiniteElement::projectPointToElements( size_t ip, const ElemIndex3::NodeList& elems,
+                                                        std::ostream& failures_log ) const {
+    std::vector<idx_t> elem_ids;
+    elem_ids.reserve( elems.size() );
+    for ( ElemIndex3::NodeList::const_iterator itc = elems.begin(); itc != elems.end(); ++itc ) {
+        elem_ids.push_back( idx_t( ( *itc ).value().payload() ) );
+    }
+    return projectPointToElements( ip, elem_ids, failures_log );
+}
+
+Method::Triplets FiniteElement::projectPointToElements( size_t ip, const std::vector<idx_t>& elems,
                                                         std::ostream& /* failures_log */ ) const {
     ATLAS_ASSERT( elems.begin() != elems.end() );
 
@@ -319,8 +487,7 @@ Method::Triplets FiniteElement::projectPointToElements( size_t ip, const ElemInd
                      ( *ocoords_ )( ip, size_t( 2 ) )};
     ElementEdge edge;
     idx_t single_point;
-    for ( ElemIndex3::NodeList::const_iterator itc = elems.begin(); itc != elems.end(); ++itc ) {
-        const idx_t elem_id = idx_t( ( *itc ).value().payload() );
+    for ( const idx_t elem_id : elems ) {
         ATLAS_ASSERT( elem_id < connectivity_->rows() );
 
         const idx_t nb_cols = connectivity_->cols( elem_id );
@@ -13,6 +13,7 @@
 #include "atlas/interpolation/method/Method.h"
 
 #include <string>
+#include <vector>
 
 #include "eckit/config/Configuration.h"
 #include "eckit/memory/NonCopyable.h"
@@ -28,7 +29,10 @@ namespace method {
 
 class FiniteElement : public Method {
 public:
-    FiniteElement( const Config& config ) : Method( config ) {}
+    FiniteElement( const Config& config ) : Method( config ) {
+        config.get( "structured_locator", use_structured_locator_ );
+        config.get( "search_tree_cache", search_tree_cache_ );
+    }
 
     virtual ~FiniteElement() override {}
 
@@ -56,6 +60,9 @@ protected:
    */
     Triplets projectPointToElements( size_t ip, const ElemIndex3::NodeList& elems, std::ostream& failures_log ) const;
 
+    /// Same as above, with the candidate elements given by their index
+    Triplets projectPointToElements( size_t ip, const std::vector<idx_t>& elems, std::ostream& failures_log ) const;
+
     virtual const FunctionSpace& source() const override { return source_; }
     virtual const FunctionSpace& target() const override { return target_; }
 
@@ -77,6 +84,12 @@ protected:
 
     FunctionSpace source_;
     FunctionSpace target_;
+
+    /// Find the candidate elements with StructuredLocator instead of a search tree, if the source mesh is structured
+    bool use_structured_locator_{true};
+
+    /// Directory where element search trees are stored, and reused by later setups over the same source elements
+    std::string search_tree_cache_;
 };
 
 }  // namespace method
@@ -10,10 +10,7 @@
 
 #include "atlas/interpolation/method/knn/KNearestNeighbours.h"
 
-#include <limits>
-
-#include "eckit/log/Plural.h"
-#include "eckit/types/FloatCompare.h"
+#include <algorithm>
 
 #include "atlas/array.h"
 #include "atlas/functionspace/NodeColumns.h"
@@ -23,6 +20,7 @@
 #include "atlas/mesh/actions/BuildXYZField.h"
 #include "atlas/meshgenerator.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
@@ -83,54 +81,66 @@ void KNearestNeighbours::do_setup( const FunctionSpace& source, const FunctionSp
     size_t inp_npts = meshSource.nodes().size();
     meshSource.metadata().get( "nb_nodes_including_halo[" + std::to_string( src.halo().size() ) + "]", inp_npts );
     size_t out_npts = meshTarget.nodes().size();
+    ATLAS_ASSERT( out_npts == 0 || not pTree_->empty() );
 
     // fill the sparse matrix
-    std::vector<Triplet> weights_triplets;
-    weights_triplets.reserve( out_npts * k_ );
-    {
-        Trace timer( Here(), "atlas::interpolation::method::NearestNeighbour::do_setup()" );
-
-        std::vector<double> weights;
-
-        for ( size_t ip = 0; ip < out_npts; ++ip ) {
-            if ( ip && ( ip % 1000 == 0 ) ) {
-                auto elapsed = timer.elapsed();
-                auto rate    = eckit::types::is_approximately_equal( elapsed, 0. )
-                                ? std::numeric_limits<double>::infinity()
-                                : ( ip / elapsed );
-                Log::debug() << eckit::BigNum( ip ) << " (at " << rate << " points/s)..." << std::endl;
-            }
-
-            // find the closest input points to the output point
-            PointIndex3::Point p{coords( ip, (size_t)0 ), coords( ip, (size_t)1 ), coords( ip, (size_t)2 )};
-            PointIndex3::NodeList nn = pTree_->kNearestNeighbours( p, k_ );
-
-            // calculate weights (individual and total, to normalise) using distance
-            // squared
-            const size_t npts = nn.size();
-            ATLAS_ASSERT( npts );
-            weights.resize( npts, 0 );
-
-            double sum = 0;
-            for ( size_t j = 0; j < npts; ++j ) {
-                PointIndex3::Point np = nn[j].point();
-                const double d2       = eckit::geometry::Point3::distance2( p, np );
-
-                weights[j] = 1. / ( 1. + d2 );
-                sum += weights[j];
-            }
-            ATLAS_ASSERT( sum > 0 );
-
-            // insert weights into the matrix
-            for ( size_t j = 0; j < npts; ++j ) {
-                size_t jp = nn[j].payload();
-                ATLAS_ASSERT( jp < inp_npts,
-                              "point found which is not covered within the halo of the source function space" );
-                weights_triplets.emplace_back( ip, jp, weights[j] / sum );
+    // Target points are split in contiguous chunks, each with its own triplets; concatenating these in chunk order
+    // gives the same matrix as a serial loop, independently of the number of threads.
+    struct Chunk {
+        std::vector<Triplet> triplets;
+        bool covered = true;
+    };
+    const size_t nb_chunks = std::min<size_t>( out_npts, 8 * atlas_omp_get_max_threads() );
+    std::vector<Chunk> chunks( nb_chunks );
+
+    ATLAS_TRACE_SCOPE( "atlas::interpolation::method::KNearestNeighbours::do_setup()" ) {
+        atlas_omp_parallel_for( size_t c = 0; c < nb_chunks; ++c ) {
+            Chunk& chunk          = chunks[c];
+            const size_t ip_begin = ( out_npts * c ) / nb_chunks;
+            const size_t ip_end   = ( out_npts * ( c + 1 ) ) / nb_chunks;
+            chunk.triplets.reserve( ( ip_end - ip_begin ) * k_ );
+
+            std::vector<PointSearchTree::Neighbour> nn;
+            std::vector<double> weights;
+
+            for ( size_t ip = ip_begin; ip < ip_end; ++ip ) {
+                // find the closest input points to the output point
+                PointIndex3::Point p{coords( ip, (size_t)0 ), coords( ip, (size_t)1 ), coords( ip, (size_t)2 )};
+                pTree_->closestPoints( p, k_, nn );
+
+                // calculate weights (individual and total, to normalise) using distance
+                // squared
+                const size_t npts = nn.size();
+                ATLAS_ASSERT( npts );
+                weights.resize( npts, 0 );
+
+                double sum = 0;
+                for ( size_t j = 0; j < npts; ++j ) {
+                    weights[j] = 1. / ( 1. + nn[j].distance2 );
+                    sum += weights[j];
+                }
+                ATLAS_ASSERT( sum > 0 );
+
+                // insert weights into the matrix
+                for ( size_t j = 0; j < npts; ++j ) {
+                    size_t jp = pTree_->payload( nn[j].index );
+                    if ( jp >= inp_npts ) {
+                        chunk.covered = false;
+                    }
+                    chunk.triplets.emplace_back( ip, jp, weights[j] / sum );
+                }
             }
         }
     }
 
+    std::vector<Triplet> weights_triplets;
+    weights_triplets.reserve( out_npts * k_ );
+    for ( auto& chunk : chunks ) {
+        ATLAS_ASSERT( chunk.covered, "point found which is not covered within the halo of the source function space" );
+        weights_triplets.insert( weights_triplets.end(), chunk.triplets.begin(), chunk.triplets.end() );
+        std::vector<Triplet>().swap( chunk.triplets );
+    }
+
     // fill sparse matrix and return
     Matrix A( out_npts, inp_npts, weights_triplets );
     matrix_.swap( A );
@@ -8,14 +8,15 @@
  * nor does it submit to any jurisdiction. and Interpolation
  */
 
-#include "eckit/config/Resource.h"
 #include "eckit/log/TraceTimer.h"
+#include "eckit/utils/MD5.h"
 
 #include "atlas/array.h"
 #include "atlas/interpolation/method/knn/KNearestNeighboursBase.h"
 #include "atlas/library/Library.h"
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/actions/BuildXYZField.h"
+#include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
 
 namespace atlas {
@@ -31,29 +32,53 @@ void KNearestNeighboursBase::buildPointSearchTree( Mesh& meshSource, const mesh:
     auto coords = array::make_view<double, 2>( meshSource.nodes().field( "xyz" ) );
     auto halo   = array::make_view<int, 1>( meshSource.nodes().halo() );
 
-    // build point-search tree
-    pTree_.reset( new PointIndex3 );
+    // build point-search tree, in one go from all nodes within the halo
+    pTree_.reset( new PointSearchTree );
 
-    static bool fastBuildKDTrees = eckit::Resource<bool>( "$ATLAS_FAST_BUILD_KDTREES", true );
+    const idx_t h        = _halo.size();
+    const idx_t nb_nodes = meshSource.nodes().size();
 
-    int h = _halo.size();
-    if ( fastBuildKDTrees ) {
-        std::vector<PointIndex3::Value> pidx;
-        pidx.reserve( meshSource.nodes().size() );
-        for ( idx_t ip = 0; ip < meshSource.nodes().size(); ++ip ) {
+    // reuse a tree stored for the same points, identified by a hash of the points and their node indices
+    std::string path;
+    std::string key;
+    if ( not search_tree_cache_.empty() ) {
+        eckit::MD5 md5;
+        for ( idx_t ip = 0; ip < nb_nodes; ++ip ) {
             if ( halo( ip ) <= h ) {
-                PointIndex3::Point p{coords( ip, 0 ), coords( ip, 1 ), coords( ip, 2 )};
-                pidx.emplace_back( p, ip );
+                const double xyz[] = {coords( ip, 0 ), coords( ip, 1 ), coords( ip, 2 )};
+                md5.add( xyz, sizeof( xyz ) );
+                md5.add( long( ip ) );
             }
         }
-        pTree_->build( pidx.begin(), pidx.end() );
+        key  = md5.digest();
+        path = search_tree_cache_ + "/atlas-point-search-tree-" + key + ".bin";
+        if ( pTree_->open( path, key ) ) {
+            Log::debug() << "Point search tree read from " << path << std::endl;
+            return;
+        }
     }
-    else {
-        for ( idx_t ip = 0; ip < meshSource.nodes().size(); ++ip ) {
-            if ( halo( ip ) <= h ) {
-                PointIndex3::Point p{coords( ip, 0 ), coords( ip, 1 ), coords( ip, 2 )};
-                pTree_->insert( PointIndex3::Value( p, ip ) );
-            }
+
+    size_t nb_points = 0;
+    for ( idx_t ip = 0; ip < nb_nodes; ++ip ) {
+        if ( halo( ip ) <= h ) {
+            ++nb_points;
+        }
+    }
+    pTree_->reserve( nb_points );
+    for ( idx_t ip = 0; ip < nb_nodes; ++ip ) {
+        if ( halo( ip ) <= h ) {
+            pTree_->insert( PointIndex3::Point{coords( ip, 0 ), coords( ip, 1 ), coords( ip, 2 )}, ip );
+        }
+    }
+    pTree_->build();
+
+    if ( not path.empty() ) {
+        try {
+            pTree_->write( path, key );
+            Log::debug() << "Point search tree written to " << path << std::endl;
+        }
+        catch ( const eckit::Exception& e ) {
+            Log::warning() << "Point search tree could not be written to cache: " << e.what() << std::endl;
         }
     }
 }
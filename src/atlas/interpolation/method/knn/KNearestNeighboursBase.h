@@ -11,10 +11,12 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include "atlas/interpolation/method/Method.h"
 #include "atlas/interpolation/method/PointIndex3.h"
 #include "atlas/mesh/Halo.h"
+#include "atlas/util/detail/FlatKDTree.h"
 
 namespace atlas {
 namespace interpolation {
@@ -22,14 +24,22 @@ namespace method {
 
 class KNearestNeighboursBase : public Method {
 public:
-    KNearestNeighboursBase( const Config& config ) : Method( config ) {}
+    KNearestNeighboursBase( const Config& config ) : Method( config ) {
+        config.get( "search_tree_cache", search_tree_cache_ );
+    }
     virtual ~KNearestNeighboursBase() override {}
 
 protected:
     void buildPointSearchTree( Mesh& meshSource ) { buildPointSearchTree( meshSource, mesh::Halo( meshSource ) ); }
     void buildPointSearchTree( Mesh& meshSource, const mesh::Halo& );
 
-    std::unique_ptr<PointIndex3> pTree_;
+    /// Search tree over source points, with payload the node index; searches are thread-safe
+    using PointSearchTree = util::detail::FlatKDTree<size_t, PointIndex3::Point>;
+
+    std::unique_ptr<PointSearchTree> pTree_;
+
+    /// Directory where point search trees are stored, and reused by later setups over the same source points
+    std::string search_tree_cache_;
 };
 
 }  // namespace method
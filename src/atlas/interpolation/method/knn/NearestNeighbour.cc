@@ -10,22 +10,23 @@
 
 #include "atlas/interpolation/method/knn/NearestNeighbour.h"
 
+#include <algorithm>
 #include <limits>
 
-#include "eckit/log/Plural.h"
-#include "eckit/types/FloatCompare.h"
-
 #include "atlas/array.h"
 #include "atlas/functionspace/NodeColumns.h"
 #include "atlas/grid.h"
 #include "atlas/interpolation/method/MethodFactory.h"
+#include "atlas/interpolation/method/StructuredLocator.h"
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/actions/BuildXYZField.h"
 #include "atlas/meshgenerator.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
+#include "atlas/util/CoordinateEnums.h"
 
 namespace atlas {
 namespace interpolation {
@@ -66,44 +67,60 @@ void NearestNeighbour::do_setup( const FunctionSpace& source, const FunctionSpac
     Mesh meshSource = src.mesh();
     Mesh meshTarget = tgt.mesh();
 
-    // build point-search tree
-    buildPointSearchTree( meshSource, src.halo() );
-    ATLAS_ASSERT( pTree_ != nullptr );
-
-    // generate 3D point coordinates
-    mesh::actions::BuildXYZField( "xyz" )( meshTarget );
-    array::ArrayView<double, 2> coords = array::make_view<double, 2>( meshTarget.nodes().field( "xyz" ) );
-
     size_t inp_npts = meshSource.nodes().size();
     meshSource.metadata().get( "nb_nodes_including_halo[" + std::to_string( src.halo().size() ) + "]", inp_npts );
     size_t out_npts = meshTarget.nodes().size();
 
-    // fill the sparse matrix
-    std::vector<Triplet> weights_triplets;
-    weights_triplets.reserve( out_npts );
-    {
-        Trace timer( Here(), "atlas::interpolation::method::NearestNeighbour::do_setup()" );
-        for ( size_t ip = 0; ip < out_npts; ++ip ) {
-            if ( ip && ( ip % 1000 == 0 ) ) {
-                auto elapsed = timer.elapsed();
-                auto rate    = eckit::types::is_approximately_equal( elapsed, 0. )
-                                ? std::numeric_limits<double>::infinity()
-                                : ( ip / elapsed );
-                Log::debug() << eckit::BigNum( ip ) << " (at " << rate << " points/s)..." << std::endl;
+    // find the closest input point to each output point, in parallel
+    constexpr size_t not_found = std::numeric_limits<size_t>::max();
+    std::vector<size_t> nearest( out_npts, not_found );
+    size_t nb_not_found = out_npts;
+
+    // on structured source meshes, directly from the grid structure
+    if ( use_structured_locator_ && StructuredLocator::applicable( meshSource ) ) {
+        StructuredLocator locator( meshSource, src.halo() );
+        if ( locator.nodesAreGridPoints() ) {
+            ATLAS_TRACE( "atlas::interpolation::method::NearestNeighbour::do_setup() structured" );
+            auto lonlat = array::make_view<double, 2>( meshTarget.nodes().lonlat() );
+            atlas_omp_parallel_for( size_t ip = 0; ip < out_npts; ++ip ) {
+                const idx_t jp = locator.nearestNode( PointLonLat{lonlat( ip, LON ), lonlat( ip, LAT )} );
+                if ( jp >= 0 ) {
+                    nearest[ip] = static_cast<size_t>( jp );
+                }
             }
+            nb_not_found = static_cast<size_t>( std::count( nearest.begin(), nearest.end(), not_found ) );
+        }
+    }
 
-            // find the closest input point to the output point
-            PointIndex3::Point p{coords( ip, (size_t)0 ), coords( ip, (size_t)1 ), coords( ip, (size_t)2 )};
-            PointIndex3::NodeInfo nn = pTree_->nearestNeighbour( p );
-            size_t jp                = nn.payload();
-
-            // insert the weights into the interpolant matrix
-            ATLAS_ASSERT( jp < inp_npts,
-                          "point found which is not covered within the halo of the source function space" );
-            weights_triplets.emplace_back( ip, jp, 1 );
+    // otherwise, and for points whose closest grid point is not part of the source mesh, with a point-search tree
+    if ( nb_not_found ) {
+        buildPointSearchTree( meshSource, src.halo() );
+        ATLAS_ASSERT( pTree_ != nullptr );
+        ATLAS_ASSERT( not pTree_->empty() );
+
+        // generate 3D point coordinates
+        mesh::actions::BuildXYZField( "xyz" )( meshTarget );
+        array::ArrayView<double, 2> coords = array::make_view<double, 2>( meshTarget.nodes().field( "xyz" ) );
+
+        ATLAS_TRACE_SCOPE( "atlas::interpolation::method::NearestNeighbour::do_setup()" ) {
+            atlas_omp_parallel_for( size_t ip = 0; ip < out_npts; ++ip ) {
+                if ( nearest[ip] == not_found ) {
+                    PointIndex3::Point p{coords( ip, (size_t)0 ), coords( ip, (size_t)1 ), coords( ip, (size_t)2 )};
+                    nearest[ip] = pTree_->payload( pTree_->closestPoint( p ).index );
+                }
+            }
         }
     }
 
+    // fill the sparse matrix
+    std::vector<Triplet> weights_triplets;
+    weights_triplets.reserve( out_npts );
+    for ( size_t ip = 0; ip < out_npts; ++ip ) {
+        size_t jp = nearest[ip];
+        ATLAS_ASSERT( jp < inp_npts, "point found which is not covered within the halo of the source function space" );
+        weights_triplets.emplace_back( ip, jp, 1 );
+    }
+
     // fill sparse matrix and return
     Matrix A( out_npts, inp_npts, weights_triplets );
     matrix_.swap( A );
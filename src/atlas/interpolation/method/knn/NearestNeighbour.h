@@ -19,7 +19,9 @@ namespace method {
 
 class NearestNeighbour : public KNearestNeighboursBase {
 public:
-    NearestNeighbour( const Config& config ) : KNearestNeighboursBase( config ) {}
+    NearestNeighbour( const Config& config ) : KNearestNeighboursBase( config ) {
+        config.get( "structured_locator", use_structured_locator_ );
+    }
     virtual ~NearestNeighbour() override {}
 
     virtual void print( std::ostream& ) const override {}
@@ -44,6 +46,9 @@ private:
 
     FunctionSpace source_;
     FunctionSpace target_;
+
+    /// Locate target points with StructuredLocator instead of a search tree, if the source mesh is structured
+    bool use_structured_locator_{true};
 };
 
 }  // namespace method
@@ -13,10 +13,12 @@
 #include "atlas/interpolation/method/Method.h"
 
 #include <memory>
+#include <vector>
 
 #include "atlas/field/Field.h"
 #include "atlas/field/FieldSet.h"
 #include "atlas/functionspace/FunctionSpace.h"
+#include "atlas/util/Point.h"
 
 namespace atlas {
 namespace interpolation {
@@ -60,9 +62,24 @@ private:
 
     virtual void do_execute( const FieldSet& src, FieldSet& tgt ) const override;
 
+    virtual void do_execute_adjoint( Field& src, const Field& tgt ) const override;
+
+    virtual void do_execute_adjoint( FieldSet& src, const FieldSet& tgt ) const override;
+
     template <typename Value, int Rank>
     void execute_impl( const Kernel& kernel, const FieldSet& src, FieldSet& tgt ) const;
 
+    /// Apply the kernel to blocks of target points; target_point( n, x, y ) sets the coordinates of target
+    /// point n, and returns false if it is skipped
+    template <typename SourceViews, typename TargetViews, typename TargetPoint>
+    void execute_blocks( const Kernel& kernel, idx_t out_npts, const TargetPoint& target_point,
+                         const SourceViews& src, TargetViews& tgt ) const;
+
+    template <typename Value, int Rank>
+    void execute_adjoint_impl( const Kernel& kernel, FieldSet& src, const FieldSet& tgt ) const;
+
+    void target_points( std::vector<PointLonLat>&, std::vector<bool>& skip ) const;
+
     static double convert_units_multiplier( const Field& field );
 
 protected:
@@ -12,6 +12,10 @@
 
 #include "StructuredInterpolation2D.h"
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
 
 #include "atlas/array/ArrayView.h"
 #include "atlas/field/Field.h"
@@ -20,6 +24,7 @@
 #include "atlas/functionspace/PointCloud.h"
 #include "atlas/functionspace/StructuredColumns.h"
 #include "atlas/grid/Grid.h"
+#include "atlas/grid/Partitioner.h"
 #include "atlas/grid/StructuredGrid.h"
 #include "atlas/mesh/Nodes.h"
 #include "atlas/parallel/mpi/mpi.h"
@@ -30,11 +35,98 @@
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/NormaliseLongitude.h"
 #include "atlas/util/Point.h"
+#include "atlas/util/PolygonXY.h"
 
 namespace atlas {
 namespace interpolation {
 namespace method {
 
+namespace detail {
+
+/// Points of a global grid inside the partition polygon of this task, with the same result as a
+/// MatchingPartitioner( source ), but without an array of the partition of every grid point on every task:
+/// a point inside the polygons of several tasks goes to the highest one, which is decided by the task owning
+/// the block of global indices of the point.
+inline std::vector<PointXY> matching_points( const functionspace::StructuredColumns& source, const Grid& target ) {
+    ATLAS_TRACE( "matching_points" );
+    const auto& comm   = mpi::comm();
+    const int nparts   = static_cast<int>( comm.size() );
+    const gidx_t size  = target.size();
+    const gidx_t block = ( size + nparts - 1 ) / nparts;
+
+    // 1) Claim the points inside the polygon, most of them rejected by its bounding box
+    const util::PolygonXY poly{source.polygon()};
+    const int nb_chunks = atlas_omp_get_max_threads();
+    std::vector<std::vector<gidx_t>> chunk_index( nb_chunks );
+    std::vector<std::vector<PointXY>> chunk_point( nb_chunks );
+    atlas_omp_parallel_for( int c = 0; c < nb_chunks; ++c ) {
+        const gidx_t begin = ( c * size ) / nb_chunks;
+        const gidx_t end   = ( ( c + 1 ) * size ) / nb_chunks;
+        auto it            = target.xy().begin() + begin;
+        for ( gidx_t n = begin; n < end; ++n, ++it ) {
+            if ( poly.contains( *it ) ) {
+                chunk_index[c].emplace_back( n );
+                chunk_point[c].emplace_back( *it );
+            }
+        }
+    }
+    std::vector<gidx_t> claimed;
+    std::vector<PointXY> points;
+    for ( int c = 0; c < nb_chunks; ++c ) {
+        claimed.insert( claimed.end(), chunk_index[c].begin(), chunk_index[c].end() );
+        points.insert( points.end(), chunk_point[c].begin(), chunk_point[c].end() );
+    }
+
+    // 2) Send the claimed indices, in increasing order, to the task owning their block
+    std::vector<std::vector<gidx_t>> send( nparts );
+    std::vector<std::vector<gidx_t>> recv( nparts );
+    for ( gidx_t n : claimed ) {
+        send[n / block].emplace_back( n );
+    }
+    ATLAS_TRACE_MPI( ALLTOALL ) { comm.allToAll( send, recv ); }
+
+    // 3) Every point of the block goes to the highest task claiming it, and must be claimed at least once
+    const gidx_t block_begin = std::min( size, static_cast<gidx_t>( comm.rank() ) * block );
+    const gidx_t block_end   = std::min( size, block_begin + block );
+    std::vector<int> part( block_end - block_begin, -1 );
+    for ( int p = 0; p < nparts; ++p ) {
+        for ( gidx_t n : recv[p] ) {
+            part[n - block_begin] = p;
+        }
+    }
+    idx_t nb_missing = static_cast<idx_t>( std::count( part.begin(), part.end(), -1 ) );
+    ATLAS_TRACE_MPI( ALLREDUCE ) { comm.allReduceInPlace( nb_missing, eckit::mpi::sum() ); }
+    if ( nb_missing ) {
+        throw_Exception(
+            "Could not find partition for target point (source functionspace does not contain all target grid "
+            "points)",
+            Here() );
+    }
+
+    // 4) Return the claims that were granted, which keep the order in which they were sent
+    for ( int p = 0; p < nparts; ++p ) {
+        auto& granted = recv[p];
+        granted.erase( std::remove_if( granted.begin(), granted.end(),
+                                       [&]( gidx_t n ) { return part[n - block_begin] != p; } ),
+                       granted.end() );
+    }
+    ATLAS_TRACE_MPI( ALLTOALL ) { comm.allToAll( recv, send ); }
+
+    std::vector<PointXY> owned;
+    size_t j = 0;
+    for ( int p = 0; p < nparts; ++p ) {
+        for ( gidx_t n : send[p] ) {
+            while ( claimed[j] != n ) {
+                ++j;
+            }
+            owned.emplace_back( points[j++] );
+        }
+    }
+    return owned;
+}
+
+}  // namespace detail
+
 template <typename Kernel>
 double StructuredInterpolation2D<Kernel>::convert_units_multiplier( const Field& field ) {
     std::string units = field.metadata().getString( "units", "degrees" );
@@ -57,16 +149,28 @@ StructuredInterpolation2D<Kernel>::StructuredInterpolation2D( const Method::Conf
 
 template <typename Kernel>
 void StructuredInterpolation2D<Kernel>::do_setup( const Grid& source, const Grid& target ) {
-    if ( mpi::size() > 1 ) {
-        ATLAS_NOTIMPLEMENTED;
-    }
-
+    ATLAS_TRACE( "StructuredInterpolation<" + Kernel::className() + ">::do_setup(Grid source, Grid target)" );
 
     ATLAS_ASSERT( StructuredGrid( source ) );
-    FunctionSpace source_fs =
-        functionspace::StructuredColumns( source, option::halo( std::max<idx_t>( kernel_->stencil_halo(), 1 ) ) );
+    functionspace::StructuredColumns source_fs( source,
+                                                option::halo( std::max<idx_t>( Kernel::stencil_halo(), 1 ) ) );
     // guarantee "1" halo for pole treatment!
-    FunctionSpace target_fs = functionspace::PointCloud( target );
+
+    FunctionSpace target_fs;
+    if ( mpi::size() == 1 ) {
+        target_fs = functionspace::PointCloud( target );
+    }
+    else {
+        // Distribute the target grid to match the source partitions, so that each target point is interpolated
+        // on the partition owning the source points of its stencil, using the halo of the source functionspace.
+        if ( StructuredGrid( target ) ) {
+            grid::MatchingPartitioner partitioner( source_fs );
+            target_fs = functionspace::StructuredColumns( target, partitioner );
+        }
+        else {
+            target_fs = functionspace::PointCloud( detail::matching_points( source_fs, target ) );
+        }
+    }
 
     do_setup( source_fs, target_fs );
 }
@@ -259,44 +363,28 @@ void StructuredInterpolation2D<Kernel>::execute_impl( const Kernel& kernel, cons
         tgt_view.emplace_back( array::make_view<Value, Rank>( tgt_fields[i] ) );
     }
     if ( target_lonlat_ ) {
+        idx_t out_npts       = target_lonlat_.shape( 0 );
+        const auto lonlat    = array::make_view<double, 2>( target_lonlat_ );
         double convert_units = convert_units_multiplier( target_lonlat_ );
 
         if ( target_ghost_ ) {
-            idx_t out_npts = target_lonlat_.shape( 0 );
-            auto ghost     = array::make_view<int, 1>( target_ghost_ );
-            auto lonlat    = array::make_view<double, 2>( target_lonlat_ );
-
-            atlas_omp_parallel {
-                typename Kernel::Stencil stencil;
-                typename Kernel::Weights weights;
-                atlas_omp_for( idx_t n = 0; n < out_npts; ++n ) {
-                    if ( not ghost( n ) ) {
-                        PointLonLat p{lonlat( n, LON ) * convert_units, lonlat( n, LAT ) * convert_units};
-                        kernel.compute_stencil( p.lon(), p.lat(), stencil );
-                        kernel.compute_weights( p.lon(), p.lat(), stencil, weights );
-                        for ( idx_t i = 0; i < N; ++i ) {
-                            kernel.interpolate( stencil, weights, src_view[i], tgt_view[i], n );
-                        }
-                    }
-                }
-            }
+            const auto ghost = array::make_view<int, 1>( target_ghost_ );
+            execute_blocks( kernel, out_npts,
+                            [&]( idx_t n, double& x, double& y ) {
+                                x = lonlat( n, LON ) * convert_units;
+                                y = lonlat( n, LAT ) * convert_units;
+                                return not ghost( n );
+                            },
+                            src_view, tgt_view );
         }
         else {
-            idx_t out_npts    = target_lonlat_.shape( 0 );
-            const auto lonlat = array::make_view<double, 2>( target_lonlat_ );
-
-            atlas_omp_parallel {
-                typename Kernel::Stencil stencil;
-                typename Kernel::Weights weights;
-                atlas_omp_for( idx_t n = 0; n < out_npts; ++n ) {
-                    PointLonLat p{lonlat( n, LON ) * convert_units, lonlat( n, LAT ) * convert_units};
-                    kernel.compute_stencil( p.lon(), p.lat(), stencil );
-                    kernel.compute_weights( p.lon(), p.lat(), stencil, weights );
-                    for ( idx_t i = 0; i < N; ++i ) {
-                        kernel.interpolate( stencil, weights, src_view[i], tgt_view[i], n );
-                    }
-                }
-            }
+            execute_blocks( kernel, out_npts,
+                            [&]( idx_t n, double& x, double& y ) {
+                                x = lonlat( n, LON ) * convert_units;
+                                y = lonlat( n, LAT ) * convert_units;
+                                return true;
+                            },
+                            src_view, tgt_view );
         }
     }
     else if ( not target_lonlat_fields_.empty() ) {
@@ -305,24 +393,238 @@ void StructuredInterpolation2D<Kernel>::execute_impl( const Kernel& kernel, cons
         const auto lat       = array::make_view<double, 1>( target_lonlat_fields_[LAT] );
         double convert_units = convert_units_multiplier( target_lonlat_fields_[LON] );
 
-        atlas_omp_parallel {
-            typename Kernel::Stencil stencil;
-            typename Kernel::Weights weights;
-            atlas_omp_for( idx_t n = 0; n < out_npts; ++n ) {
-                PointLonLat p{lon( n ) * convert_units, lat( n ) * convert_units};
-                kernel.compute_stencil( p.lon(), p.lat(), stencil );
-                kernel.compute_weights( p.lon(), p.lat(), stencil, weights );
+        execute_blocks( kernel, out_npts,
+                        [&]( idx_t n, double& x, double& y ) {
+                            x = lon( n ) * convert_units;
+                            y = lat( n ) * convert_units;
+                            return true;
+                        },
+                        src_view, tgt_view );
+    }
+    else {
+        ATLAS_NOTIMPLEMENTED;
+    }
+}
+
+
+template <typename Kernel>
+template <typename SourceViews, typename TargetViews, typename TargetPoint>
+void StructuredInterpolation2D<Kernel>::execute_blocks( const Kernel& kernel, idx_t out_npts,
+                                                        const TargetPoint& target_point, const SourceViews& src_view,
+                                                        TargetViews& tgt_view ) const {
+    // Stencils and weights are computed for blocks of target points at once, which vectorises,
+    // and then applied to each point of the block
+    constexpr idx_t block_size = Kernel::block_size();
+
+    const idx_t N         = static_cast<idx_t>( src_view.size() );
+    const idx_t nb_blocks = ( out_npts + block_size - 1 ) / block_size;
+
+    atlas_omp_parallel {
+        typename Kernel::StencilBlock stencils;
+        typename Kernel::WeightsBlock weights_block;
+        typename Kernel::Stencil stencil;
+        typename Kernel::Weights weights;
+        std::array<double, block_size> x;
+        std::array<double, block_size> y;
+        std::array<idx_t, block_size> index;
+        atlas_omp_for( idx_t b = 0; b < nb_blocks; ++b ) {
+            const idx_t n_end = std::min( out_npts, ( b + 1 ) * block_size );
+            idx_t m           = 0;
+            for ( idx_t n = b * block_size; n < n_end; ++n ) {
+                if ( target_point( n, x[m], y[m] ) ) {
+                    index[m++] = n;
+                }
+            }
+            kernel.compute_stencils( m, x.data(), y.data(), stencils );
+            kernel.compute_weights( m, x.data(), y.data(), stencils, weights_block );
+            for ( idx_t p = 0; p < m; ++p ) {
+                stencils.get( p, stencil );
+                weights_block.get( p, weights );
                 for ( idx_t i = 0; i < N; ++i ) {
-                    kernel.interpolate( stencil, weights, src_view[i], tgt_view[i], n );
+                    kernel.interpolate( stencil, weights, src_view[i], tgt_view[i], index[p] );
                 }
             }
         }
     }
+}
+
+
+template <typename Kernel>
+void StructuredInterpolation2D<Kernel>::do_execute_adjoint( Field& src_field, const Field& tgt_field ) const {
+    FieldSet src( src_field );
+    do_execute_adjoint( src, FieldSet( tgt_field ) );
+}
+
+
+template <typename Kernel>
+void StructuredInterpolation2D<Kernel>::do_execute_adjoint( FieldSet& src_fields, const FieldSet& tgt_fields ) const {
+    if ( not matrix_free_ ) {
+        Method::do_execute_adjoint( src_fields, tgt_fields );
+        return;
+    }
+
+    ATLAS_TRACE( "StructuredInterpolation<" + Kernel::className() + ">::do_execute_adjoint()" );
+
+    const idx_t N = src_fields.size();
+    ATLAS_ASSERT( N == tgt_fields.size() );
+
+    if ( N == 0 )
+        return;
+
+    array::DataType datatype = src_fields[0].datatype();
+    int rank                 = src_fields[0].rank();
+
+    for ( idx_t i = 0; i < N; ++i ) {
+        ATLAS_ASSERT( src_fields[i].datatype() == datatype );
+        ATLAS_ASSERT( src_fields[i].rank() == rank );
+        ATLAS_ASSERT( tgt_fields[i].datatype() == datatype );
+        ATLAS_ASSERT( tgt_fields[i].rank() == rank );
+    }
+
+    if ( datatype.kind() == array::DataType::KIND_REAL64 && rank == 1 ) {
+        execute_adjoint_impl<double, 1>( *kernel_, src_fields, tgt_fields );
+    }
+    if ( datatype.kind() == array::DataType::KIND_REAL32 && rank == 1 ) {
+        execute_adjoint_impl<float, 1>( *kernel_, src_fields, tgt_fields );
+    }
+    if ( datatype.kind() == array::DataType::KIND_REAL64 && rank == 2 ) {
+        execute_adjoint_impl<double, 2>( *kernel_, src_fields, tgt_fields );
+    }
+    if ( datatype.kind() == array::DataType::KIND_REAL32 && rank == 2 ) {
+        execute_adjoint_impl<float, 2>( *kernel_, src_fields, tgt_fields );
+    }
+
+    adjointHaloExchange( src_fields );
+    src_fields.set_dirty();
+}
+
+
+template <typename Kernel>
+void StructuredInterpolation2D<Kernel>::target_points( std::vector<PointLonLat>& points,
+                                                       std::vector<bool>& skip ) const {
+    if ( target_lonlat_ ) {
+        const idx_t out_npts = target_lonlat_.shape( 0 );
+        const auto lonlat    = array::make_view<double, 2>( target_lonlat_ );
+        double convert_units = convert_units_multiplier( target_lonlat_ );
+        points.resize( out_npts );
+        skip.assign( out_npts, false );
+        for ( idx_t n = 0; n < out_npts; ++n ) {
+            points[n] = PointLonLat{lonlat( n, LON ) * convert_units, lonlat( n, LAT ) * convert_units};
+        }
+        if ( target_ghost_ ) {
+            auto ghost = array::make_view<int, 1>( target_ghost_ );
+            for ( idx_t n = 0; n < out_npts; ++n ) {
+                skip[n] = ghost( n );
+            }
+        }
+    }
+    else if ( not target_lonlat_fields_.empty() ) {
+        const idx_t out_npts = target_lonlat_fields_[0].shape( 0 );
+        const auto lon       = array::make_view<double, 1>( target_lonlat_fields_[LON] );
+        const auto lat       = array::make_view<double, 1>( target_lonlat_fields_[LAT] );
+        double convert_units = convert_units_multiplier( target_lonlat_fields_[LON] );
+        points.resize( out_npts );
+        skip.assign( out_npts, false );
+        for ( idx_t n = 0; n < out_npts; ++n ) {
+            points[n] = PointLonLat{lon( n ) * convert_units, lat( n ) * convert_units};
+        }
+    }
     else {
         ATLAS_NOTIMPLEMENTED;
     }
 }
 
+
+template <typename Kernel>
+template <typename Value, int Rank>
+void StructuredInterpolation2D<Kernel>::execute_adjoint_impl( const Kernel& kernel, FieldSet& src_fields,
+                                                              const FieldSet& tgt_fields ) const {
+    const idx_t N = src_fields.size();
+
+    std::vector<array::ArrayView<Value, Rank> > src_view;
+    std::vector<array::ArrayView<const Value, Rank> > tgt_view;
+    src_view.reserve( N );
+    tgt_view.reserve( N );
+
+    for ( idx_t i = 0; i < N; ++i ) {
+        src_view.emplace_back( array::make_view<Value, Rank>( src_fields[i] ) );
+        tgt_view.emplace_back( array::make_view<Value, Rank>( tgt_fields[i] ) );
+        src_view.back().assign( 0. );
+    }
+
+    std::vector<PointLonLat> points;
+    std::vector<bool> skip;
+    target_points( points, skip );
+    const idx_t out_npts = static_cast<idx_t>( points.size() );
+
+    // The scatter-add of a target point only touches the source rows [ j, j + stencil_width ) of its stencil.
+    // Targets are grouped in bands of stencil_width rows (by first stencil row); bands of the same parity never
+    // touch the same source points, so each colour can be processed in parallel without atomics.
+    constexpr idx_t width = Kernel::stencil_width();
+
+    std::vector<idx_t> j_begin( out_npts );
+    atlas_omp_parallel {
+        typename Kernel::Stencil stencil;
+        atlas_omp_for( idx_t n = 0; n < out_npts; ++n ) {
+            if ( not skip[n] ) {
+                kernel.compute_stencil( points[n].lon(), points[n].lat(), stencil );
+                j_begin[n] = stencil.j( 0 );
+            }
+        }
+    }
+
+    idx_t j_min = std::numeric_limits<idx_t>::max();
+    idx_t j_max = std::numeric_limits<idx_t>::min();
+    for ( idx_t n = 0; n < out_npts; ++n ) {
+        if ( not skip[n] ) {
+            j_min = std::min( j_min, j_begin[n] );
+            j_max = std::max( j_max, j_begin[n] );
+        }
+    }
+    if ( j_min > j_max ) {
+        return;
+    }
+
+    const idx_t nb_bands = ( j_max - j_min ) / width + 1;
+    std::vector<idx_t> band_offset( nb_bands + 1, 0 );
+    for ( idx_t n = 0; n < out_npts; ++n ) {
+        if ( not skip[n] ) {
+            ++band_offset[( j_begin[n] - j_min ) / width + 1];
+        }
+    }
+    for ( idx_t b = 0; b < nb_bands; ++b ) {
+        band_offset[b + 1] += band_offset[b];
+    }
+    std::vector<idx_t> band_points( band_offset[nb_bands] );
+    {
+        std::vector<idx_t> pos( band_offset.begin(), band_offset.end() - 1 );
+        for ( idx_t n = 0; n < out_npts; ++n ) {
+            if ( not skip[n] ) {
+                band_points[pos[( j_begin[n] - j_min ) / width]++] = n;
+            }
+        }
+    }
+
+    for ( idx_t colour = 0; colour < 2; ++colour ) {
+        const idx_t nb_coloured_bands = ( nb_bands - colour + 1 ) / 2;
+        atlas_omp_parallel {
+            typename Kernel::Stencil stencil;
+            typename Kernel::Weights weights;
+            atlas_omp_for( idx_t cb = 0; cb < nb_coloured_bands; ++cb ) {
+                const idx_t b = colour + 2 * cb;
+                for ( idx_t p = band_offset[b]; p < band_offset[b + 1]; ++p ) {
+                    const idx_t n = band_points[p];
+                    kernel.compute_stencil( points[n].lon(), points[n].lat(), stencil );
+                    kernel.compute_weights( points[n].lon(), points[n].lat(), stencil, weights );
+                    for ( idx_t i = 0; i < N; ++i ) {
+                        kernel.interpolate_adjoint( stencil, weights, src_view[i], tgt_view[i], n );
+                    }
+                }
+            }
+        }
+    }
+}
+
 }  // namespace method
 }  // namespace interpolation
 }  // namespace atlas
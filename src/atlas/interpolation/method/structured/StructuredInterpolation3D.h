@@ -61,6 +61,13 @@ private:
     template <typename Value, int Rank>
     void execute_impl( const Kernel& kernel, const FieldSet& src, FieldSet& tgt ) const;
 
+    /// Interpolate all fields at once to out_npts x out_nlev target points, with the coordinates of target point (n,k)
+    /// given by target_point(n,k,x,y,z). The stencils and weights are computed once per target point, for blocks of
+    /// consecutive levels of a target column, and then applied to every field.
+    template <typename SourceViews, typename TargetViews, typename TargetPoint>
+    void execute_fused( const Kernel& kernel, idx_t out_npts, idx_t out_nlev, const TargetPoint& target_point,
+                        const SourceViews& src_view, TargetViews& tgt_view ) const;
+
     static double convert_units_multiplier( const Field& field );
 
 protected:
@@ -77,6 +84,7 @@ protected:
 
     bool matrix_free_;
     bool limiter_;
+    bool fused_;
 
     std::unique_ptr<Kernel> kernel_;
 };
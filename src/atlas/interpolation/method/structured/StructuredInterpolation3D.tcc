@@ -12,6 +12,8 @@
 
 #include "StructuredInterpolation3D.h"
 
+#include <algorithm>
+
 #include "atlas/array/ArrayView.h"
 #include "atlas/field/Field.h"
 #include "atlas/field/FieldSet.h"
@@ -28,6 +30,8 @@
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/Point.h"
 
+#include "kernels/StencilWeights3DBlock.h"
+
 namespace atlas {
 namespace interpolation {
 namespace method {
@@ -48,9 +52,11 @@ template <typename Kernel>
 StructuredInterpolation3D<Kernel>::StructuredInterpolation3D( const Method::Config& config ) :
     Method( config ),
     matrix_free_{false},
-    limiter_{false} {
+    limiter_{false},
+    fused_{true} {
     config.get( "matrix_free", matrix_free_ );
     config.get( "limiter", limiter_ );
+    config.get( "fused", fused_ );
 
     if ( not matrix_free_ ) {
         throw_NotImplemented( "Matrix-free StructuredInterpolation3D not implemented", Here() );
@@ -272,6 +278,17 @@ void StructuredInterpolation3D<Kernel>::execute_impl( const Kernel& kernel, cons
 
         const double convert_units = convert_units_multiplier( target_3d_ );
 
+        if ( fused_ && not limiter_ ) {
+            execute_fused( kernel, out_npts, out_nlev,
+                           [&]( idx_t n, idx_t k, double& x, double& y, double& z ) {
+                               x = coords( n, k, LON ) * convert_units;
+                               y = coords( n, k, LAT ) * convert_units;
+                               z = coords( n, k, ZZ );
+                           },
+                           src_view, tgt_view );
+            return;
+        }
+
         atlas_omp_parallel {
             typename Kernel::Stencil stencil;
             typename Kernel::Weights weights;
@@ -317,6 +334,17 @@ void StructuredInterpolation3D<Kernel>::execute_impl( const Kernel& kernel, cons
 
         const double convert_units = convert_units_multiplier( target_xyz_[LON] );
 
+        if ( fused_ && not limiter_ ) {
+            execute_fused( kernel, out_npts, out_nlev,
+                           [&]( idx_t n, idx_t k, double& x, double& y, double& z ) {
+                               x = xcoords( n, k ) * convert_units;
+                               y = ycoords( n, k ) * convert_units;
+                               z = zcoords( n, k );
+                           },
+                           src_view, tgt_view );
+            return;
+        }
+
         atlas_omp_parallel {
             typename Kernel::Stencil stencil;
             typename Kernel::Weights weights;
@@ -340,6 +368,37 @@ void StructuredInterpolation3D<Kernel>::execute_impl( const Kernel& kernel, cons
     }
 }
 
+template <typename Kernel>
+template <typename SourceViews, typename TargetViews, typename TargetPoint>
+void StructuredInterpolation3D<Kernel>::execute_fused( const Kernel& kernel, idx_t out_npts, idx_t out_nlev,
+                                                       const TargetPoint& target_point, const SourceViews& src_view,
+                                                       TargetViews& tgt_view ) const {
+    // Stencils and weights of 16 levels, reused for all fields while in L1 cache
+    using Block   = StencilWeights3DBlock<Kernel::stencil_size(), 16>;
+    const idx_t N = static_cast<idx_t>( src_view.size() );
+
+    atlas_omp_parallel {
+        typename Kernel::Stencil stencil;
+        typename Kernel::Weights weights;
+        Block block;
+        atlas_omp_for( idx_t n = 0; n < out_npts; ++n ) {
+            for ( idx_t k0 = 0; k0 < out_nlev; k0 += Block::capacity() ) {
+                const idx_t np = std::min<idx_t>( Block::capacity(), out_nlev - k0 );
+                for ( idx_t p = 0; p < np; ++p ) {
+                    double x, y, z;
+                    target_point( n, k0 + p, x, y, z );
+                    kernel.compute_stencil( x, y, z, stencil );
+                    kernel.compute_weights( x, y, z, stencil, weights );
+                    kernel.flatten( stencil, weights, p, block );
+                }
+                for ( idx_t i = 0; i < N; ++i ) {
+                    block.interpolate( np, src_view[i], tgt_view[i], n, k0 );
+                }
+            }
+        }
+    }
+}
+
 }  // namespace method
 }  // namespace interpolation
 }  // namespace atlas
@@ -14,6 +14,7 @@
 #include <limits>
 
 #include "CubicHorizontalLimiter.h"
+#include "HorizontalWeightsBlock.h"
 
 #include "eckit/linalg/Triplet.h"
 
@@ -21,6 +22,7 @@
 #include "atlas/functionspace/StructuredColumns.h"
 #include "atlas/grid/Stencil.h"
 #include "atlas/grid/StencilComputer.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/Point.h"
@@ -42,12 +44,14 @@ public:
         ATLAS_ASSERT( src_ );
         ATLAS_ASSERT( src_.halo() >= 2 );
         compute_horizontal_stencil_ = grid::ComputeHorizontalStencil( src_.grid(), stencil_width() );
+        compute_xy_                 = grid::ComputeXY( src_.grid(), stencil_width() );
         limiter_                    = config.getBool( "limiter", false );
     }
 
 protected:
     functionspace::StructuredColumns src_;
     grid::ComputeHorizontalStencil compute_horizontal_stencil_;
+    grid::ComputeXY compute_xy_;
     bool limiter_{false};
 
 public:
@@ -71,6 +75,11 @@ public:
         Weights weights;
     };
 
+    /// Stencils and weights of blocks of points, computed at once with compute_stencils() and compute_weights()
+    using StencilBlock = grid::HorizontalStencilBlock<4, 32>;
+    using WeightsBlock = HorizontalWeightsBlock<4, 32>;
+    static constexpr idx_t block_size() { return StencilBlock::capacity(); }
+
     template <typename stencil_t>
     void compute_stencil( const double x, const double y, stencil_t& stencil ) const {
         compute_horizontal_stencil_( x, y, stencil );
@@ -128,6 +137,58 @@ public:
         weights_j[3] = 1. - weights_j[0] - weights_j[1] - weights_j[2];
     }
 
+    /// Compute the stencils of the first n <= block_size() points of x and y together
+    void compute_stencils( idx_t n, const double x[], const double y[], StencilBlock& stencils ) const {
+        compute_horizontal_stencil_( n, x, y, stencils );
+    }
+
+    /// Compute the weights of the first n <= block_size() points of x and y together; same as compute_weights()
+    /// for each point, with the loops over the points innermost so that they vectorise
+    void compute_weights( idx_t n, const double x[], const double y[], const StencilBlock& stencils,
+                          WeightsBlock& weights ) const {
+        std::array<std::array<double, block_size()>, 4> yvec;
+        for ( idx_t j = 0; j < stencil_width(); ++j ) {
+            auto& weights_i = weights.weights_i[j];
+            atlas_omp_pragma( omp simd )
+            for ( idx_t p = 0; p < n; ++p ) {
+                const double x1                  = compute_xy_.x( stencils.i( 1, j, p ), stencils.j( j, p ) );
+                const double x2                  = compute_xy_.x( stencils.i( 2, j, p ), stencils.j( j, p ) );
+                const double alpha               = ( x2 - x[p] ) / ( x2 - x1 );
+                const double alpha_sqr           = alpha * alpha;
+                const double two_minus_alpha     = 2. - alpha;
+                const double one_minus_alpha_sqr = 1. - alpha_sqr;
+                weights_i[0][p]                  = -alpha * one_minus_alpha_sqr / 6.;
+                weights_i[1][p]                  = 0.5 * alpha * ( 1. + alpha ) * two_minus_alpha;
+                weights_i[2][p]                  = 0.5 * one_minus_alpha_sqr * two_minus_alpha;
+                weights_i[3][p]                  = 1. - weights_i[0][p] - weights_i[1][p] - weights_i[2][p];
+                yvec[j][p]                       = compute_xy_.y( stencils.j( j, p ) );
+            }
+        }
+        auto& weights_j = weights.weights_j;
+        atlas_omp_pragma( omp simd )
+        for ( idx_t p = 0; p < n; ++p ) {
+            const double dl12 = yvec[0][p] - yvec[1][p];
+            const double dl13 = yvec[0][p] - yvec[2][p];
+            const double dl14 = yvec[0][p] - yvec[3][p];
+            const double dl23 = yvec[1][p] - yvec[2][p];
+            const double dl24 = yvec[1][p] - yvec[3][p];
+            const double dl34 = yvec[2][p] - yvec[3][p];
+            const double dcl1 = dl12 * dl13 * dl14;
+            const double dcl2 = -dl12 * dl23 * dl24;
+            const double dcl3 = dl13 * dl23 * dl34;
+
+            const double dl1 = y[p] - yvec[0][p];
+            const double dl2 = y[p] - yvec[1][p];
+            const double dl3 = y[p] - yvec[2][p];
+            const double dl4 = y[p] - yvec[3][p];
+
+            weights_j[0][p] = ( dl2 * dl3 * dl4 ) / dcl1;
+            weights_j[1][p] = ( dl1 * dl3 * dl4 ) / dcl2;
+            weights_j[2][p] = ( dl1 * dl2 * dl4 ) / dcl3;
+            weights_j[3][p] = 1. - weights_j[0][p] - weights_j[1][p] - weights_j[2][p];
+        }
+    }
+
     template <typename stencil_t, typename weights_t, typename array_t>
     typename array_t::value_type interpolate( const stencil_t& stencil, const weights_t& weights,
                                               const array_t& input ) const {
@@ -205,6 +266,46 @@ public:
         }
     }
 
+    // Adjoint of interpolate(): scatter-add output( r ) into the stencil points of input
+    template <typename stencil_t, typename weights_t, typename Value, int Rank>
+    typename std::enable_if<( Rank == 1 ), void>::type interpolate_adjoint(
+        const stencil_t& stencil, const weights_t& weights, array::ArrayView<Value, Rank>& input,
+        const array::ArrayView<const Value, Rank>& output, idx_t r ) const {
+        if ( limiter_ ) {
+            throw_NotImplemented( "Adjoint of limited interpolation", Here() );
+        }
+        const auto& weights_j = weights.weights_j;
+        for ( idx_t j = 0; j < stencil_width(); ++j ) {
+            const auto& weights_i = weights.weights_i[j];
+            for ( idx_t i = 0; i < stencil_width(); ++i ) {
+                idx_t n = src_.index( stencil.i( i, j ), stencil.j( j ) );
+                Value w = static_cast<Value>( weights_i[i] * weights_j[j] );
+                input( n ) += w * output( r );
+            }
+        }
+    }
+
+    template <typename stencil_t, typename weights_t, typename Value, int Rank>
+    typename std::enable_if<( Rank == 2 ), void>::type interpolate_adjoint(
+        const stencil_t& stencil, const weights_t& weights, array::ArrayView<Value, Rank>& input,
+        const array::ArrayView<const Value, Rank>& output, idx_t r ) const {
+        if ( limiter_ ) {
+            throw_NotImplemented( "Adjoint of limited interpolation", Here() );
+        }
+        const auto& weights_j = weights.weights_j;
+        const idx_t Nk        = output.shape( 1 );
+        for ( idx_t j = 0; j < stencil_width(); ++j ) {
+            const auto& weights_i = weights.weights_i[j];
+            for ( idx_t i = 0; i < stencil_width(); ++i ) {
+                idx_t n = src_.index( stencil.i( i, j ), stencil.j( j ) );
+                Value w = static_cast<Value>( weights_i[i] * weights_j[j] );
+                for ( idx_t k = 0; k < Nk; ++k ) {
+                    input( n, k ) += w * output( r, k );
+                }
+            }
+        }
+    }
+
     template <typename array_t>
     typename array_t::value_type operator()( const double x, const double y, const array_t& input ) const {
         Stencil stencil;
@@ -0,0 +1,44 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <array>
+
+#include "atlas/library/config.h"
+
+namespace atlas {
+namespace interpolation {
+namespace method {
+
+/// @brief Horizontal interpolation weights of a block of up to BlockSize points, stored as structure of arrays
+///
+/// This is the block equivalent of the Weights struct of the horizontal kernels, with the point index innermost:
+/// weights_i[j][i][p] and weights_j[j][p].
+template <idx_t StencilWidth, idx_t BlockSize>
+struct HorizontalWeightsBlock {
+    std::array<std::array<std::array<double, BlockSize>, StencilWidth>, StencilWidth> weights_i;
+    std::array<std::array<double, BlockSize>, StencilWidth> weights_j;
+
+    /// Copy the weights of point p of the block into the horizontal part of a kernel's Weights
+    template <typename weights_t>
+    void get( idx_t p, weights_t& weights ) const {
+        for ( idx_t j = 0; j < StencilWidth; ++j ) {
+            for ( idx_t i = 0; i < StencilWidth; ++i ) {
+                weights.weights_i[j][i] = weights_i[j][i][p];
+            }
+            weights.weights_j[j] = weights_j[j][p];
+        }
+    }
+};
+
+}  // namespace method
+}  // namespace interpolation
+}  // namespace atlas
@@ -110,6 +110,27 @@ public:
         return output;
     }
 
+    /// Store the source points and weights of the stencil of target point p in a StencilWeights3DBlock, in the order
+    /// of summation of interpolate(); the limiter is not applied
+    template <typename stencil_t, typename weights_t, typename block_t>
+    void flatten( const stencil_t& stencil, const weights_t& weights, idx_t p, block_t& block ) const {
+        static_assert( block_t::stencil_size() == stencil_size(), "block_t does not match the stencil size" );
+        const auto& wj = weights.weights_j;
+        const auto& wk = weights.weights_k;
+
+        idx_t s = 0;
+        for ( idx_t j = 0; j < stencil_width(); ++j ) {
+            const auto& wi = weights.weights_i[j];
+            for ( idx_t i = 0; i < stencil_width(); ++i ) {
+                const idx_t n    = src_.index( stencil.i( i, j ), stencil.j( j ) );
+                const double wij = wi[i] * wj[j];
+                for ( idx_t k = 0; k < stencil_width(); ++k ) {
+                    block.set( s++, p, n, stencil.k( k ), wij * wk[k] );
+                }
+            }
+        }
+    }
+
     template <typename Value>
     struct OutputView1D {
         template <typename Int>
@@ -13,12 +13,15 @@
 #include <cmath>
 #include <limits>
 
+#include "HorizontalWeightsBlock.h"
+
 #include "eckit/linalg/Triplet.h"
 
 #include "atlas/array/ArrayView.h"
 #include "atlas/functionspace/StructuredColumns.h"
 #include "atlas/grid/Stencil.h"
 #include "atlas/grid/StencilComputer.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/Point.h"
@@ -38,11 +41,13 @@ public:
         src_ = fs;
         ATLAS_ASSERT( src_ );
         compute_horizontal_stencil_ = grid::ComputeHorizontalStencil( src_.grid(), stencil_width() );
+        compute_xy_                 = grid::ComputeXY( src_.grid(), stencil_width() );
     }
 
 private:
     functionspace::StructuredColumns src_;
     grid::ComputeHorizontalStencil compute_horizontal_stencil_;
+    grid::ComputeXY compute_xy_;
 
 public:
     static std::string className() { return "LinearHorizontalKernel"; }
@@ -63,6 +68,11 @@ public:
         Weights weights;
     };
 
+    /// Stencils and weights of blocks of points, computed at once with compute_stencils() and compute_weights()
+    using StencilBlock = grid::HorizontalStencilBlock<2, 32>;
+    using WeightsBlock = HorizontalWeightsBlock<2, 32>;
+    static constexpr idx_t block_size() { return StencilBlock::capacity(); }
+
     template <typename stencil_t>
     void compute_stencil( const double x, const double y, stencil_t& stencil ) const {
         compute_horizontal_stencil_( x, y, stencil );
@@ -99,6 +109,37 @@ public:
         }
     }
 
+    /// Compute the stencils of the first n <= block_size() points of x and y together
+    void compute_stencils( idx_t n, const double x[], const double y[], StencilBlock& stencils ) const {
+        compute_horizontal_stencil_( n, x, y, stencils );
+    }
+
+    /// Compute the weights of the first n <= block_size() points of x and y together; same as compute_weights()
+    /// for each point, with the loops over the points innermost so that they vectorise
+    void compute_weights( idx_t n, const double x[], const double y[], const StencilBlock& stencils,
+                          WeightsBlock& weights ) const {
+        std::array<std::array<double, block_size()>, 2> yvec;
+        for ( idx_t j = 0; j < stencil_width(); ++j ) {
+            auto& weights_i = weights.weights_i[j];
+            atlas_omp_pragma( omp simd )
+            for ( idx_t p = 0; p < n; ++p ) {
+                const double x1    = compute_xy_.x( stencils.i( 0, j, p ), stencils.j( j, p ) );
+                const double x2    = compute_xy_.x( stencils.i( 1, j, p ), stencils.j( j, p ) );
+                const double alpha = ( x2 - x[p] ) / ( x2 - x1 );
+                weights_i[0][p]    = alpha;
+                weights_i[1][p]    = 1. - alpha;
+                yvec[j][p]         = compute_xy_.y( stencils.j( j, p ) );
+            }
+        }
+        auto& weights_j = weights.weights_j;
+        atlas_omp_pragma( omp simd )
+        for ( idx_t p = 0; p < n; ++p ) {
+            const double alpha = ( yvec[1][p] - y[p] ) / ( yvec[1][p] - yvec[0][p] );
+            weights_j[0][p]    = alpha;
+            weights_j[1][p]    = 1. - alpha;
+        }
+    }
+
     template <typename stencil_t, typename weights_t, typename array_t>
     typename array_t::value_type interpolate( const stencil_t& stencil, const weights_t& weights,
                                               const array_t& input ) const {
@@ -157,6 +198,40 @@ public:
         }
     }
 
+    // Adjoint of interpolate(): scatter-add output( r ) into the stencil points of input
+    template <typename stencil_t, typename weights_t, typename Value, int Rank>
+    typename std::enable_if<( Rank == 1 ), void>::type interpolate_adjoint(
+        const stencil_t& stencil, const weights_t& weights, array::ArrayView<Value, Rank>& input,
+        const array::ArrayView<const Value, Rank>& output, idx_t r ) const {
+        const auto& weights_j = weights.weights_j;
+        for ( idx_t j = 0; j < stencil_width(); ++j ) {
+            const auto& weights_i = weights.weights_i[j];
+            for ( idx_t i = 0; i < stencil_width(); ++i ) {
+                idx_t n = src_.index( stencil.i( i, j ), stencil.j( j ) );
+                Value w = static_cast<Value>( weights_i[i] * weights_j[j] );
+                input( n ) += w * output( r );
+            }
+        }
+    }
+
+    template <typename stencil_t, typename weights_t, typename Value, int Rank>
+    typename std::enable_if<( Rank == 2 ), void>::type interpolate_adjoint(
+        const stencil_t& stencil, const weights_t& weights, array::ArrayView<Value, Rank>& input,
+        const array::ArrayView<const Value, Rank>& output, idx_t r ) const {
+        const auto& weights_j = weights.weights_j;
+        const idx_t Nk        = output.shape( 1 );
+        for ( idx_t j = 0; j < stencil_width(); ++j ) {
+            const auto& weights_i = weights.weights_i[j];
+            for ( idx_t i = 0; i < stencil_width(); ++i ) {
+                idx_t n = src_.index( stencil.i( i, j ), stencil.j( j ) );
+                Value w = static_cast<Value>( weights_i[i] * weights_j[j] );
+                for ( idx_t k = 0; k < Nk; ++k ) {
+                    input( n, k ) += w * output( r, k );
+                }
+            }
+        }
+    }
+
     template <typename array_t>
     typename array_t::value_type operator()( const double x, const double y, const array_t& input ) const {
         Stencil stencil;
@@ -207,6 +207,53 @@ public:
         return output;
     }
 
+    /// Store the source points and weights of the stencil of target point p in a StencilWeights3DBlock, in the order
+    /// of summation of interpolate(); the limiter is not applied
+    template <typename stencil_t, typename weights_t, typename block_t>
+    void flatten( const stencil_t& stencil, const weights_t& weights, idx_t p, block_t& block ) const {
+        static_assert( block_t::stencil_size() == stencil_size(), "block_t does not match the stencil size" );
+        const auto& wj = weights.weights_j;
+        const auto& wk = weights.weights_k;
+
+        idx_t s = 0;
+        // Inner levels, inner rows (cubic in i, cubic in j)   --> 16 points
+        for ( idx_t j = 1; j < 3; ++j ) {
+            const auto& wi = weights.weights_i[j];
+            for ( idx_t i = 0; i < 4; ++i ) {
+                const idx_t n    = src_.index( stencil.i( i, j ), stencil.j( j ) );
+                const double wij = wi[i] * wj[j];
+                for ( idx_t k = 1; k < 3; ++k ) {
+                    block.set( s++, p, n, stencil.k( k ), wij * wk[k] );
+                }
+            }
+        }
+        // Inner levels, outer rows: (linear in i, cubic in j)  --> 8 points
+        for ( idx_t j = 0; j < 4; j += 3 ) {
+            const auto& wi = weights.weights_i[j];
+            for ( idx_t i = 1; i < 3; ++i ) {
+                const idx_t n    = src_.index( stencil.i( i, j ), stencil.j( j ) );
+                const double wij = wi[i] * wj[j];
+                for ( idx_t k = 1; k < 3; ++k ) {
+                    block.set( s++, p, n, stencil.k( k ), wij * wk[k] );
+                }
+            }
+        }
+        // Outer levels: (linear in i, linear in j) -- > 8 points
+        constexpr QuasiCubicLinearPoints pts{};
+        for ( idx_t m = 0; m < 2; ++m ) {
+            const idx_t j   = pts.j[m];
+            const auto& wi  = weights.weights_i[pts.jj[m]];
+            const double wl = weights.weights_j[pts.jw[m]];
+            for ( idx_t l = 0; l < 2; ++l ) {
+                const idx_t n    = src_.index( stencil.i( pts.i[l], j ), stencil.j( j ) );
+                const double wij = wi[pts.ii[l]] * wl;
+                for ( idx_t k = 0; k < 4; k += 3 ) {
+                    block.set( s++, p, n, stencil.k( k ), wij * wk[k] );
+                }
+            }
+        }
+    }
+
     template <typename Value>
     struct OutputView1D {
         template <typename Int>
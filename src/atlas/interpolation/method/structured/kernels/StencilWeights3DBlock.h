@@ -0,0 +1,101 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <array>
+#include <type_traits>
+
+#include "atlas/library/config.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace interpolation {
+namespace method {
+
+/// @brief Source points and weights of the 3D stencils of a block of up to BlockSize target points
+///
+/// The stencil of each target point is flattened to StencilSize source points, given by the index of the source
+/// column, the source level, and the product of the horizontal and vertical weights, in the order of summation of
+/// the kernel's interpolate(). The entries are filled with the kernel's flatten() and are then applied to any number
+/// of fields, so that stencils and weights are computed only once per target point.
+///
+/// Target points of a block are consecutive levels of one target column: for rank-2 fields the innermost loop runs
+/// over the contiguous levels of the block, for rank-3 fields over the contiguous variables.
+template <idx_t StencilSize, idx_t BlockSize>
+struct StencilWeights3DBlock {
+    static constexpr idx_t stencil_size() { return StencilSize; }
+    static constexpr idx_t capacity() { return BlockSize; }
+
+    std::array<std::array<idx_t, BlockSize>, StencilSize> node;
+    std::array<std::array<idx_t, BlockSize>, StencilSize> level;
+    std::array<std::array<double, BlockSize>, StencilSize> weight;
+
+    void set( idx_t s, idx_t p, idx_t n, idx_t k, double w ) {
+        node[s][p]   = n;
+        level[s][p]  = k;
+        weight[s][p] = w;
+    }
+
+    /// Interpolate the first np points of the block to output( r, k0 + p )
+    template <typename InputArray, typename OutputArray>
+    typename std::enable_if<( InputArray::RANK == 2 && OutputArray::RANK == 2 ), void>::type interpolate(
+        idx_t np, const InputArray& input, OutputArray& output, idx_t r, idx_t k0 ) const {
+        using Value = typename std::remove_const<typename InputArray::value_type>::type;
+
+        std::array<Value, BlockSize> sum;
+        for ( idx_t p = 0; p < np; ++p ) {
+            sum[p] = 0.;
+        }
+        for ( idx_t s = 0; s < StencilSize; ++s ) {
+            const auto& n = node[s];
+            const auto& k = level[s];
+            const auto& w = weight[s];
+            atlas_omp_pragma( omp simd )
+            for ( idx_t p = 0; p < np; ++p ) {
+                sum[p] += static_cast<Value>( w[p] ) * input( n[p], k[p] );
+            }
+        }
+        for ( idx_t p = 0; p < np; ++p ) {
+            output( r, k0 + p ) = sum[p];
+        }
+    }
+
+    /// Interpolate all variables of the first np points of the block to output( r, k0 + p, : )
+    /// The variables are accessed through raw pointers, so they must have a unit stride in input and output.
+    template <typename InputArray, typename OutputArray>
+    typename std::enable_if<( InputArray::RANK == 3 && OutputArray::RANK == 3 ), void>::type interpolate(
+        idx_t np, const InputArray& input, OutputArray& output, idx_t r, idx_t k0 ) const {
+        using Value = typename std::remove_const<typename InputArray::value_type>::type;
+
+        ATLAS_ASSERT( input.stride( 2 ) == 1 && output.stride( 2 ) == 1 );
+
+        const idx_t nvar = output.shape( 2 );
+        for ( idx_t p = 0; p < np; ++p ) {
+            Value* out = &output( r, k0 + p, 0 );
+            for ( idx_t v = 0; v < nvar; ++v ) {
+                out[v] = 0.;
+            }
+            for ( idx_t s = 0; s < StencilSize; ++s ) {
+                const Value w   = static_cast<Value>( weight[s][p] );
+                const Value* in = &input( node[s][p], level[s][p], 0 );
+                atlas_omp_pragma( omp simd )
+                for ( idx_t v = 0; v < nvar; ++v ) {
+                    out[v] += w * in[v];
+                }
+            }
+        }
+    }
+};
+
+}  // namespace method
+}  // namespace interpolation
+}  // namespace atlas
@@ -12,8 +12,12 @@
 
 #pragma once
 
+#include <type_traits>
+#include <vector>
+
 #include "atlas/field/MissingValue.h"
 #include "atlas/interpolation/nonlinear/NonLinear.h"
+#include "atlas/parallel/omp/omp.h"
 
 
 namespace atlas {
@@ -27,6 +31,99 @@ private:
 };
 
 
+/**
+ * @brief Missing values policy applied row by row, either to the interpolation matrix (execute) or on the fly while
+ * interpolating (interpolate), so that both give the same results.
+ * Derived implements the correction of the weights of one matrix row:
+ *   template <typename IsMissing>
+ *   static bool correct_row( const Scalar* weights, Size N, const IsMissing& is_missing, Scalar* corrected,
+ *                            bool& zeros );
+ * returning if the row is modified, with is_missing(j) telling if the value of entry j (< N) is missing, and
+ * setting zeros if weights were zeroed because of missing values. weights and corrected may be the same array.
+ */
+template <typename T, typename Derived>
+struct MissingRowByRow : Missing {
+    bool execute( NonLinear::Matrix& W, const Field& field ) const override {
+        field::MissingValue mv( field );
+        auto& missingValue = mv.ref();
+
+        // NOTE only for scalars (for now)
+        auto values = make_view_field_values<T, 1>( field );
+        ATLAS_ASSERT( idx_t( W.cols() ) == values.size() );
+
+        const auto outer = W.outer();
+        const auto index = W.inner();
+        auto data        = const_cast<Scalar*>( W.data() );
+        bool modif       = false;
+        bool zeros       = false;
+
+        for ( Size r = 0; r < W.rows(); ++r ) {
+            const Size k    = outer[r];
+            auto is_missing = [&]( Size j ) { return missingValue( values[index[k + j]] ); };
+            if ( Derived::correct_row( data + k, outer[r + 1] - k, is_missing, data + k, zeros ) ) {
+                modif = true;
+            }
+        }
+
+        if ( zeros && missingValue.isnan() ) {
+            W.prune( 0. );
+        }
+
+        return modif;
+    }
+
+    bool interpolate( const Matrix& W, const Field& src, Field& tgt ) const override {
+        return interpolate( W, src, tgt, std::is_floating_point<T>() );
+    }
+
+private:
+    bool interpolate( const Matrix&, const Field&, Field&, std::false_type ) const { return false; }
+
+    bool interpolate( const Matrix& W, const Field& src, Field& tgt, std::true_type ) const {
+        field::MissingValue mv( src );
+        auto& missingValue = mv.ref();
+
+        // NOTE only for scalars (for now)
+        auto values = make_view_field_values<T, 1>( src );
+        auto target = array::make_view<T, 1>( tgt );
+        ATLAS_ASSERT( idx_t( W.cols() ) == values.size() );
+        ATLAS_ASSERT( idx_t( W.rows() ) <= target.size() );
+
+        const auto outer  = W.outer();
+        const auto index  = W.inner();
+        const auto weight = W.data();
+        const idx_t rows  = static_cast<idx_t>( W.rows() );
+
+        // execute() prunes zeroed weights when the missing value is NaN, as 0*NaN would still be NaN
+        const bool skip_zeros = missingValue.isnan();
+
+        atlas_omp_parallel {
+            std::vector<Scalar> corrected;
+            bool zeros = false;
+            atlas_omp_for( idx_t r = 0; r < rows; ++r ) {
+                const Size k = outer[r];
+                const Size N = outer[r + 1] - k;
+                corrected.resize( N );
+
+                auto is_missing = [&]( Size j ) { return missingValue( values[index[k + j]] ); };
+                const Scalar* w =
+                    Derived::correct_row( weight + k, N, is_missing, corrected.data(), zeros ) ? corrected.data()
+                                                                                                : weight + k;
+                T t = 0.;
+                for ( Size j = 0; j < N; ++j ) {
+                    if ( skip_zeros && w[j] == 0. ) {
+                        continue;
+                    }
+                    t += static_cast<T>( w[j] ) * values[index[k + j]];
+                }
+                target( r ) = t;
+            }
+        }
+        return true;
+    }
+};
+
+
 }  // namespace nonlinear
 }  // namespace interpolation
 }  // namespace atlas
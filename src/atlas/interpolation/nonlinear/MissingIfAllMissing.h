@@ -24,73 +24,52 @@ namespace nonlinear {
 
 
 template <typename T>
-struct MissingIfAllMissing : Missing {
-    bool execute( NonLinear::Matrix& W, const Field& field ) const {
-        field::MissingValue mv( field );
-        auto& missingValue = mv.ref();
-
-        // NOTE only for scalars (for now)
-        auto values = make_view_field_values<T, 1>( field );
-        ATLAS_ASSERT( idx_t( W.cols() ) == values.size() );
-
-        auto data  = const_cast<Scalar*>( W.data() );
-        bool modif = false;
-        bool zeros = false;
-
-        Size i = 0;
-        Matrix::iterator it( W );
-        for ( Size r = 0; r < W.rows(); ++r ) {
-            const Matrix::iterator end = W.end( r );
-
-            // count missing values, accumulate weights (disregarding missing values)
-            size_t i_missing = i;
-            size_t N_missing = 0;
-            size_t N_entries = 0;
-            Scalar sum       = 0.;
+struct MissingIfAllMissing : MissingRowByRow<T, MissingIfAllMissing<T>> {
+    using Scalar = NonLinear::Scalar;
+    using Size   = NonLinear::Size;
+
+    template <typename IsMissing>
+    static bool correct_row( const Scalar* weights, Size N, const IsMissing& is_missing, Scalar* corrected,
+                             bool& zeros ) {
+        // count missing values, accumulate weights (disregarding missing values)
+        Size i_missing = 0;
+        Size N_missing = 0;
+        Scalar sum     = 0.;
+
+        for ( Size j = 0; j < N; ++j ) {
+            if ( is_missing( j ) ) {
+                ++N_missing;
+                i_missing = j;
+            }
+            else {
+                sum += weights[j];
+            }
+        }
 
-            Matrix::iterator kt( it );
-            Size k = i;
-            for ( ; it != end; ++it, ++i, ++N_entries ) {
-                const bool miss = missingValue( values[it.col()] );
+        if ( N_missing == 0 ) {
+            return false;
+        }
 
-                if ( miss ) {
-                    ++N_missing;
-                    i_missing = i;
-                }
-                else {
-                    sum += *it;
-                }
+        // weights redistribution: zero-weight all missing values, linear re-weighting for the others;
+        // the result is missing value if all values in row are missing
+        if ( N_missing == N || eckit::types::is_approximately_equal( sum, 0. ) ) {
+            for ( Size j = 0; j < N; ++j ) {
+                corrected[j] = j == i_missing ? 1. : 0.;
             }
-
-            // weights redistribution: zero-weight all missing values, linear re-weighting for the others;
-            // the result is missing value if all values in row are missing
-            if ( N_missing > 0 ) {
-                if ( N_missing == N_entries || eckit::types::is_approximately_equal( sum, 0. ) ) {
-                    for ( Size j = k; j < k + N_entries; ++j ) {
-                        data[j] = j == i_missing ? 1. : 0.;
-                    }
+        }
+        else {
+            const Scalar factor = 1. / sum;
+            for ( Size j = 0; j < N; ++j ) {
+                if ( is_missing( j ) ) {
+                    corrected[j] = 0.;
+                    zeros        = true;
                 }
                 else {
-                    const Scalar factor = 1. / sum;
-                    for ( Size j = k; j < k + N_entries; ++j, ++kt ) {
-                        if ( missingValue( values[kt.col()] ) ) {
-                            data[j] = 0.;
-                            zeros   = true;
-                        }
-                        else {
-                            data[j] *= factor;
-                        }
-                    }
+                    corrected[j] = weights[j] * factor;
                 }
-                modif = true;
             }
         }
-
-        if ( zeros && missingValue.isnan() ) {
-            W.prune( 0. );
-        }
-
-        return modif;
+        return true;
     }
 
     static std::string static_type() { return "missing-if-all-missing"; }
@@ -22,60 +22,39 @@ namespace nonlinear {
 
 
 template <typename T>
-struct MissingIfAnyMissing : Missing {
-    bool execute( NonLinear::Matrix& W, const Field& field ) const {
-        field::MissingValue mv( field );
-        auto& missingValue = mv.ref();
-
-        // NOTE only for scalars (for now)
-        auto values = make_view_field_values<T, 1>( field );
-        ATLAS_ASSERT( idx_t( W.cols() ) == values.size() );
-
-        auto data  = const_cast<Scalar*>( W.data() );
-        bool modif = false;
-        bool zeros = false;
-
-        Size i = 0;
-        Matrix::iterator it( W );
-        for ( Size r = 0; r < W.rows(); ++r ) {
-            const Matrix::iterator end = W.end( r );
-
-            // count missing values, accumulate weights (disregarding missing values)
-            size_t i_missing = i;
-            size_t N_missing = 0;
-            size_t N_entries = 0;
-
-            Matrix::iterator kt( it );
-            Size k = i;
-            for ( ; it != end; ++it, ++i, ++N_entries ) {
-                const bool miss = missingValue( values[it.col()] );
-
-                if ( miss ) {
-                    ++N_missing;
-                    i_missing = i;
-                }
-            }
-
-            // if any values in row are missing, force missing value
-            if ( N_missing > 0 ) {
-                for ( Size j = k; j < k + N_entries; ++j ) {
-                    if ( j == i_missing ) {
-                        data[j] = 1.;
-                    }
-                    else {
-                        data[j] = 0.;
-                        zeros   = true;
-                    }
-                }
-                modif = true;
+struct MissingIfAnyMissing : MissingRowByRow<T, MissingIfAnyMissing<T>> {
+    using Scalar = NonLinear::Scalar;
+    using Size   = NonLinear::Size;
+
+    template <typename IsMissing>
+    static bool correct_row( const Scalar* /*weights*/, Size N, const IsMissing& is_missing, Scalar* corrected,
+                             bool& zeros ) {
+        // count missing values
+        Size i_missing = 0;
+        Size N_missing = 0;
+
+        for ( Size j = 0; j < N; ++j ) {
+            if ( is_missing( j ) ) {
+                ++N_missing;
+                i_missing = j;
             }
         }
 
-        if ( zeros && missingValue.isnan() ) {
-            W.prune( 0. );
+        if ( N_missing == 0 ) {
+            return false;
         }
 
-        return modif;
+        // if any values in row are missing, force missing value
+        for ( Size j = 0; j < N; ++j ) {
+            if ( j == i_missing ) {
+                corrected[j] = 1.;
+            }
+            else {
+                corrected[j] = 0.;
+                zeros        = true;
+            }
+        }
+        return true;
     }
 
     static std::string static_type() { return "missing-if-any-missing"; }
@@ -24,81 +24,61 @@ namespace nonlinear {
 
 
 template <typename T>
-struct MissingIfHeaviestMissing : Missing {
-    bool execute( NonLinear::Matrix& W, const Field& field ) const {
-        field::MissingValue mv( field );
-        auto& missingValue = mv.ref();
-
-        // NOTE only for scalars (for now)
-        auto values = make_view_field_values<T, 1>( field );
-        ATLAS_ASSERT( idx_t( W.cols() ) == values.size() );
-
-        auto data  = const_cast<Scalar*>( W.data() );
-        bool modif = false;
-        bool zeros = false;
-
-        Size i = 0;
-        Matrix::iterator it( W );
-        for ( Size r = 0; r < W.rows(); ++r ) {
-            const Matrix::iterator end = W.end( r );
-
-            // count missing values, accumulate weights (disregarding missing values) and find maximum weight in row
-            size_t i_missing         = i;
-            size_t N_missing         = 0;
-            size_t N_entries         = 0;
-            Scalar sum               = 0.;
-            Scalar heaviest          = -1.;
-            bool heaviest_is_missing = false;
-
-            Matrix::iterator kt( it );
-            Size k = i;
-            for ( ; it != end; ++it, ++i, ++N_entries ) {
-                const bool miss = missingValue( values[it.col()] );
-
-                if ( miss ) {
-                    ++N_missing;
-                    i_missing = i;
-                }
-                else {
-                    sum += *it;
-                }
+struct MissingIfHeaviestMissing : MissingRowByRow<T, MissingIfHeaviestMissing<T>> {
+    using Scalar = NonLinear::Scalar;
+    using Size   = NonLinear::Size;
+
+    template <typename IsMissing>
+    static bool correct_row( const Scalar* weights, Size N, const IsMissing& is_missing, Scalar* corrected,
+                             bool& zeros ) {
+        // count missing values, accumulate weights (disregarding missing values) and find maximum weight in row
+        Size i_missing           = 0;
+        Size N_missing           = 0;
+        Scalar sum               = 0.;
+        Scalar heaviest          = -1.;
+        bool heaviest_is_missing = false;
+
+        for ( Size j = 0; j < N; ++j ) {
+            const bool miss = is_missing( j );
+
+            if ( miss ) {
+                ++N_missing;
+                i_missing = j;
+            }
+            else {
+                sum += weights[j];
+            }
 
-                if ( heaviest < data[i] ) {
-                    heaviest            = data[i];
-                    heaviest_is_missing = miss;
-                }
+            if ( heaviest < weights[j] ) {
+                heaviest            = weights[j];
+                heaviest_is_missing = miss;
             }
+        }
 
-            // weights redistribution: zero-weight all missing values, linear re-weighting for the others;
-            // if all values are missing, or the closest value is missing, force missing value
-            if ( N_missing > 0 ) {
-                if ( N_missing == N_entries || heaviest_is_missing ||
-                     eckit::types::is_approximately_equal( sum, 0. ) ) {
-                    for ( Size j = k; j < k + N_entries; ++j ) {
-                        data[j] = j == i_missing ? 1. : 0.;
-                    }
+        if ( N_missing == 0 ) {
+            return false;
+        }
+
+        // weights redistribution: zero-weight all missing values, linear re-weighting for the others;
+        // if all values are missing, or the closest value is missing, force missing value
+        if ( N_missing == N || heaviest_is_missing || eckit::types::is_approximately_equal( sum, 0. ) ) {
+            for ( Size j = 0; j < N; ++j ) {
+                corrected[j] = j == i_missing ? 1. : 0.;
+            }
+        }
+        else {
+            const Scalar factor = 1. / sum;
+            for ( Size j = 0; j < N; ++j ) {
+                if ( is_missing( j ) ) {
+                    corrected[j] = 0.;
+                    zeros        = true;
                 }
                 else {
-                    const Scalar factor = 1. / sum;
-                    for ( Size j = k; j < k + N_entries; ++j, ++kt ) {
-                        if ( missingValue( values[kt.col()] ) ) {
-                            data[j] = 0.;
-                            zeros   = true;
-                        }
-                        else {
-                            data[j] *= factor;
-                        }
-                    }
+                    corrected[j] = weights[j] * factor;
                 }
-                modif = true;
             }
         }
-
-        if ( zeros && missingValue.isnan() ) {
-            W.prune( 0. );
-        }
-
-        return modif;
+        return true;
     }
 
     static std::string static_type() { return "missing-if-heaviest-missing"; }
@@ -38,6 +38,7 @@ public:
     using Matrix = eckit::linalg::SparseMatrix;
     using Scalar = eckit::linalg::Scalar;
     using Size   = eckit::linalg::Size;
+    using Index  = eckit::linalg::Index;
 
     /**
      * @brief ctor
@@ -64,6 +65,15 @@ public:
      */
     virtual bool execute( Matrix& W, const Field& f ) const = 0;
 
+    /**
+     * @brief Interpolate, applying the non-linear corrections to each row of the interpolation matrix on the fly
+     * @param [in] W interpolation matrix, not modified
+     * @param [in] src field with missing values information
+     * @param [out] tgt interpolated field
+     * @return if supported, otherwise execute() should be applied to a copy of W
+     */
+    virtual bool interpolate( const Matrix& /*W*/, const Field& /*src*/, Field& /*tgt*/ ) const { return false; }
+
 protected:
     template <typename Value, int Rank>
     static array::ArrayView<typename std::add_const<Value>::type, Rank> make_view_field_values( const Field& field ) {
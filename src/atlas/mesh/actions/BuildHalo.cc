@@ -8,9 +8,12 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <numeric>
 #include <stdexcept>
@@ -26,8 +29,11 @@
 #include "atlas/mesh/actions/BuildHalo.h"
 #include "atlas/mesh/actions/BuildParallelFields.h"
 #include "atlas/mesh/detail/AccumulateFacets.h"
+#include "atlas/mesh/detail/RenumberGlobalIndex.h"
 #include "atlas/parallel/mpi/Buffer.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/parallel/omp/sort.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
@@ -48,6 +54,7 @@
 // #define ATLAS_103_SORT
 
 using atlas::mesh::detail::accumulate_facets;
+using atlas::mesh::detail::renumber_global_index;
 using atlas::util::LonLatMicroDeg;
 using atlas::util::microdeg;
 using atlas::util::PeriodicTransform;
@@ -58,16 +65,6 @@ namespace atlas {
 namespace mesh {
 namespace actions {
 
-struct Entity {
-    Entity( gidx_t gid, idx_t idx ) {
-        g = gid;
-        i = idx;
-    }
-    gidx_t g;
-    idx_t i;
-    bool operator<( const Entity& other ) const { return ( g < other.g ); }
-};
-
 void make_nodes_global_index_human_readable( const mesh::actions::BuildHalo& build_halo, mesh::Nodes& nodes,
                                              bool do_all ) {
     ATLAS_TRACE();
@@ -76,10 +73,6 @@ void make_nodes_global_index_human_readable( const mesh::actions::BuildHalo& bui
     // uid,
     //     and could receive different gidx for different tasks
 
-    // unused // int mypart = mpi::rank();
-    int nparts  = mpi::size();
-    size_t root = 0;
-
     array::ArrayView<gidx_t, 1> nodes_glb_idx = array::make_view<gidx_t, 1>( nodes.global_index() );
     // nodes_glb_idx.dump( Log::info() );
     //  ATLAS_DEBUG( "min = " << nodes.global_index().metadata().getLong("min") );
@@ -129,50 +122,8 @@ void make_nodes_global_index_human_readable( const mesh::actions::BuildHalo& bui
     //    }
     //  }
 
-    // 1) Gather all global indices, together with location
-
-    std::vector<int> recvcounts( mpi::size() );
-    std::vector<int> recvdispls( mpi::size() );
-
-    ATLAS_TRACE_MPI( GATHER ) { mpi::comm().gather( nb_nodes, recvcounts, root ); }
-    idx_t glb_nb_nodes = std::accumulate( recvcounts.begin(), recvcounts.end(), 0 );
-
-    recvdispls[0] = 0;
-    for ( int jpart = 1; jpart < nparts; ++jpart ) {  // start at 1
-        recvdispls[jpart] = recvcounts[jpart - 1] + recvdispls[jpart - 1];
-    }
-
-    std::vector<gidx_t> glb_idx_gathered( glb_nb_nodes );
-    ATLAS_TRACE_MPI( GATHER ) {
-        mpi::comm().gatherv( glb_idx.data(), glb_idx.size(), glb_idx_gathered.data(), recvcounts.data(),
-                             recvdispls.data(), root );
-    }
-
-    // 2) Sort all global indices, and renumber from 1 to glb_nb_edges
-    std::vector<Entity> node_sort;
-    node_sort.reserve( glb_nb_nodes );
-    const idx_t nb_glb_idx_gathered = static_cast<idx_t>( glb_idx_gathered.size() );
-    for ( idx_t jnode = 0; jnode < nb_glb_idx_gathered; ++jnode ) {
-        node_sort.emplace_back( glb_idx_gathered[jnode], jnode );
-    }
-
-    ATLAS_TRACE_SCOPE( "sort on rank 0" ) { std::sort( node_sort.begin(), node_sort.end() ); }
-
-    gidx_t gid               = glb_idx_max + 1;
-    const idx_t nb_node_sort = static_cast<idx_t>( node_sort.size() );
-    for ( idx_t jnode = 0; jnode < nb_node_sort; ++jnode ) {
-        if ( jnode > 0 && node_sort[jnode].g != node_sort[jnode - 1].g ) {
-            ++gid;
-        }
-        int inode               = node_sort[jnode].i;
-        glb_idx_gathered[inode] = gid;
-    }
-
-    // 3) Scatter renumbered back
-    ATLAS_TRACE_MPI( SCATTER ) {
-        mpi::comm().scatterv( glb_idx_gathered.data(), recvcounts.data(), recvdispls.data(), glb_idx.data(),
-                              static_cast<int>( glb_idx.size() ), root );
-    }
+    // Renumber all global indices from glb_idx_max+1, distributed over all tasks
+    renumber_global_index( glb_idx.data(), glb_idx.size(), glb_idx_max );
 
     for ( int jnode = 0; jnode < nb_nodes; ++jnode ) {
         nodes_glb_idx( points_to_edit[jnode] ) = glb_idx[jnode];
@@ -189,9 +140,6 @@ void make_cells_global_index_human_readable( const mesh::actions::BuildHalo& bui
                                              bool do_all ) {
     ATLAS_TRACE();
 
-    int nparts = static_cast<idx_t>( mpi::size() );
-    idx_t root = 0;
-
     array::ArrayView<gidx_t, 1> cells_glb_idx = array::make_view<gidx_t, 1>( cells.global_index() );
     //  ATLAS_DEBUG( "min = " << cells.global_index().metadata().getLong("min") );
     //  ATLAS_DEBUG( "max = " << cells.global_index().metadata().getLong("max") );
@@ -230,48 +178,8 @@ void make_cells_global_index_human_readable( const mesh::actions::BuildHalo& bui
         glb_idx[i] = cells_glb_idx( cells_to_edit[i] );
     }
 
-    // 1) Gather all global indices, together with location
-
-    std::vector<int> recvcounts( mpi::size() );
-    std::vector<int> recvdispls( mpi::size() );
-
-    ATLAS_TRACE_MPI( GATHER ) { mpi::comm().gather( nb_cells, recvcounts, root ); }
-    idx_t glb_nb_cells = std::accumulate( recvcounts.begin(), recvcounts.end(), 0 );
-
-    recvdispls[0] = 0;
-    for ( int jpart = 1; jpart < nparts; ++jpart ) {  // start at 1
-        recvdispls[jpart] = recvcounts[jpart - 1] + recvdispls[jpart - 1];
-    }
-
-    std::vector<gidx_t> glb_idx_gathered( glb_nb_cells );
-    ATLAS_TRACE_MPI( GATHER ) {
-        mpi::comm().gatherv( glb_idx.data(), glb_idx.size(), glb_idx_gathered.data(), recvcounts.data(),
-                             recvdispls.data(), root );
-    }
-
-    // 2) Sort all global indices, and renumber from 1 to glb_nb_edges
-    std::vector<Entity> cell_sort;
-    cell_sort.reserve( glb_nb_cells );
-    for ( idx_t jcell = 0; jcell < glb_nb_cells; ++jcell ) {
-        cell_sort.emplace_back( glb_idx_gathered[jcell], jcell );
-    }
-
-    ATLAS_TRACE_SCOPE( "sort on rank 0" ) { std::sort( cell_sort.begin(), cell_sort.end() ); }
-
-    gidx_t gid = glb_idx_max + 1;
-    for ( idx_t jcell = 0; jcell < glb_nb_cells; ++jcell ) {
-        if ( jcell > 0 && cell_sort[jcell].g != cell_sort[jcell - 1].g ) {
-            ++gid;
-        }
-        idx_t icell             = cell_sort[jcell].i;
-        glb_idx_gathered[icell] = gid;
-    }
-
-    // 3) Scatter renumbered back
-    ATLAS_TRACE_MPI( SCATTER ) {
-        mpi::comm().scatterv( glb_idx_gathered.data(), recvcounts.data(), recvdispls.data(), glb_idx.data(),
-                              static_cast<int>( glb_idx.size() ), root );
-    }
+    // Renumber all global indices from glb_idx_max+1, distributed over all tasks
+    renumber_global_index( glb_idx.data(), glb_idx.size(), glb_idx_max );
 
     for ( int jcell = 0; jcell < nb_cells; ++jcell ) {
         cells_glb_idx( cells_to_edit[jcell] ) = glb_idx[jcell];
@@ -336,8 +244,6 @@ void build_lookup_node2elem( const Mesh& mesh, Node2Elem& node2elem ) {
 void accumulate_partition_bdry_nodes_old( Mesh& mesh, std::vector<idx_t>& bdry_nodes ) {
     ATLAS_TRACE();
 
-    std::set<idx_t> bdry_nodes_set;
-
     std::vector<idx_t> facet_nodes;
     std::vector<idx_t> connectivity_facet_to_elem;
 
@@ -356,15 +262,17 @@ void accumulate_partition_bdry_nodes_old( Mesh& mesh, std::vector<idx_t>& bdry_n
         /*out*/ nb_inner_facets,
         /*out*/ missing_value );
 
+    bdry_nodes.clear();
     for ( idx_t jface = 0; jface < nb_facets; ++jface ) {
         if ( connectivity_facet_to_elem[jface * 2 + 1] == missing_value ) {
             for ( idx_t jnode = 0; jnode < 2; ++jnode )  // 2 nodes per face
             {
-                bdry_nodes_set.insert( facet_nodes[jface * 2 + jnode] );
+                bdry_nodes.push_back( facet_nodes[jface * 2 + jnode] );
             }
         }
     }
-    bdry_nodes = std::vector<idx_t>( bdry_nodes_set.begin(), bdry_nodes_set.end() );
+    omp::sort( bdry_nodes.begin(), bdry_nodes.end() );
+    bdry_nodes.erase( std::unique( bdry_nodes.begin(), bdry_nodes.end() ), bdry_nodes.end() );
 }
 
 void accumulate_partition_bdry_nodes( Mesh& mesh, idx_t halo, std::vector<idx_t>& bdry_nodes ) {
@@ -428,7 +336,92 @@ private:
     std::vector<std::string> notes;
 };
 
-using Uid2Node = std::map<uid_t, idx_t>;
+/// @brief Hash map from uid to a non-negative local index
+///
+/// Open addressing with linear probing in a power-of-two table that is kept at most half full. Compared to a
+/// std::map this avoids an allocation per entry, and a lookup mostly touches a single cache line.
+class UidHashMap {
+public:
+    size_t size() const { return size_; }
+
+    void clear() {
+        keys_.clear();
+        values_.clear();
+        size_ = 0;
+    }
+
+    void reserve( size_t n ) {
+        size_t capacity = 16;
+        while ( capacity < 2 * n ) {
+            capacity *= 2;
+        }
+        if ( capacity > values_.size() ) {
+            rehash( capacity );
+        }
+    }
+
+    /// Insert uid with given index, unless uid is present already
+    /// @return false if uid was present already, in which case its index is unchanged
+    bool insert( uid_t uid, idx_t index ) {
+        if ( 2 * ( size_ + 1 ) > values_.size() ) {
+            rehash( std::max<size_t>( 16, 2 * values_.size() ) );
+        }
+        const size_t slot = probe( uid );
+        if ( values_[slot] != -1 ) {
+            return false;
+        }
+        keys_[slot]   = uid;
+        values_[slot] = index;
+        ++size_;
+        return true;
+    }
+
+    /// @return index of uid, or -1 if uid is not present
+    idx_t find( uid_t uid ) const { return size_ ? values_[probe( uid )] : -1; }
+
+private:
+    /// Slot holding uid, or the empty slot where it would be inserted
+    size_t probe( uid_t uid ) const {
+        const size_t mask = values_.size() - 1;
+        size_t slot       = hash( uid ) & mask;
+        while ( values_[slot] != -1 && keys_[slot] != uid ) {
+            slot = ( slot + 1 ) & mask;
+        }
+        return slot;
+    }
+
+    /// Finaliser of MurmurHash3, which spreads the packed longitude and latitude bits of a uid over the table
+    static size_t hash( uid_t uid ) {
+        uint64_t h = static_cast<uint64_t>( uid );
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return static_cast<size_t>( h );
+    }
+
+    void rehash( size_t capacity ) {
+        std::vector<uid_t> keys( capacity );
+        std::vector<idx_t> values( capacity, -1 );
+        keys_.swap( keys );
+        values_.swap( values );
+        for ( size_t j = 0; j < values.size(); ++j ) {
+            if ( values[j] != -1 ) {
+                const size_t slot = probe( keys[j] );
+                keys_[slot]       = keys[j];
+                values_[slot]     = values[j];
+            }
+        }
+    }
+
+private:
+    std::vector<uid_t> keys_;
+    std::vector<idx_t> values_;  // -1 marks an empty slot
+    size_t size_{0};
+};
+
+using Uid2Node = UidHashMap;
 void build_lookup_uid2node( Mesh& mesh, Uid2Node& uid2node ) {
     ATLAS_TRACE();
     Notification notes;
@@ -439,12 +432,16 @@ void build_lookup_uid2node( Mesh& mesh, Uid2Node& uid2node ) {
 
     UniqueLonLat compute_uid( mesh );
 
+    std::vector<uid_t> node_uid( nb_nodes );
+    atlas_omp_parallel_for( idx_t jnode = 0; jnode < nb_nodes; ++jnode ) { node_uid[jnode] = compute_uid( jnode ); }
+
     uid2node.clear();
+    uid2node.reserve( nb_nodes );
     for ( idx_t jnode = 0; jnode < nb_nodes; ++jnode ) {
-        uid_t uid     = compute_uid( jnode );
-        bool inserted = uid2node.insert( std::make_pair( uid, jnode ) ).second;
+        uid_t uid     = node_uid[jnode];
+        bool inserted = uid2node.insert( uid, jnode );
         if ( not inserted ) {
-            int other = uid2node[uid];
+            int other = uid2node.find( uid );
             std::stringstream msg;
             msg << "Node uid: " << uid << "   " << glb_idx( jnode ) << " (" << xy( jnode, XX ) << "," << xy( jnode, YY )
                 << ")  has already been added as node " << glb_idx( other ) << " (" << xy( other, XX ) << ","
@@ -457,9 +454,11 @@ void build_lookup_uid2node( Mesh& mesh, Uid2Node& uid2node ) {
     }
 }
 
+/// Find the elements of this partition containing any of the requested nodes, sorted by index, and the uids of
+/// their nodes that were not requested, sorted by uid.
 void accumulate_elements( const Mesh& mesh, const mpi::BufferView<uid_t>& request_node_uid, const Uid2Node& uid2node,
                           const Node2Elem& node2elem, std::vector<idx_t>& found_elements,
-                          std::set<uid_t>& new_nodes_uid ) {
+                          std::vector<uid_t>& new_nodes_uid ) {
     // ATLAS_TRACE();
     const mesh::HybridElements::Connectivity& elem_nodes = mesh.cells().node_connectivity();
     const auto elem_part                                 = array::make_view<int, 1>( mesh.cells().partition() );
@@ -468,44 +467,56 @@ void accumulate_elements( const Mesh& mesh, const mpi::BufferView<uid_t>& reques
     const idx_t nb_request_nodes = static_cast<idx_t>( request_node_uid.size() );
     const int mpi_rank           = static_cast<int>( mpi::rank() );
 
-    std::set<idx_t> found_elements_set;
-
-    for ( idx_t jnode = 0; jnode < nb_request_nodes; ++jnode ) {
-        uid_t uid = request_node_uid( jnode );
-
-        idx_t inode = -1;
-        // search and get node index for uid
-        Uid2Node::const_iterator found = uid2node.find( uid );
-        if ( found != uid2node.end() ) {
-            inode = found->second;
-        }
-        if ( inode != -1 && inode < nb_nodes ) {
-            for ( const idx_t e : node2elem[inode] ) {
-                if ( elem_part( e ) == mpi_rank ) {
-                    found_elements_set.insert( e );
+    found_elements.clear();
+    atlas_omp_parallel {
+        std::vector<idx_t> found_by_thread;
+        atlas_omp_for( idx_t jnode = 0; jnode < nb_request_nodes; ++jnode ) {
+            // search and get node index for uid
+            const idx_t inode = uid2node.find( request_node_uid( jnode ) );
+            if ( inode != -1 && inode < nb_nodes ) {
+                for ( const idx_t e : node2elem[inode] ) {
+                    if ( elem_part( e ) == mpi_rank ) {
+                        found_by_thread.push_back( e );
+                    }
                 }
             }
         }
+        atlas_omp_critical {
+            found_elements.insert( found_elements.end(), found_by_thread.begin(), found_by_thread.end() );
+        }
     }
-
-    // found_bdry_elements_set now contains elements for the nodes
-    found_elements = std::vector<idx_t>( found_elements_set.begin(), found_elements_set.end() );
+    omp::sort( found_elements.begin(), found_elements.end() );
+    found_elements.erase( std::unique( found_elements.begin(), found_elements.end() ), found_elements.end() );
+    const idx_t nb_found_elements = static_cast<idx_t>( found_elements.size() );
 
     UniqueLonLat compute_uid( mesh );
 
     // Collect all nodes
-    new_nodes_uid.clear();
-    for ( const idx_t e : found_elements ) {
-        idx_t nb_elem_nodes = elem_nodes.cols( e );
+    std::vector<idx_t> displs( nb_found_elements + 1, 0 );
+    for ( idx_t jelem = 0; jelem < nb_found_elements; ++jelem ) {
+        displs[jelem + 1] = displs[jelem] + elem_nodes.cols( found_elements[jelem] );
+    }
+    std::vector<uid_t> elem_nodes_uid( displs[nb_found_elements] );
+    atlas_omp_parallel_for( idx_t jelem = 0; jelem < nb_found_elements; ++jelem ) {
+        const idx_t e             = found_elements[jelem];
+        const idx_t nb_elem_nodes = elem_nodes.cols( e );
         for ( idx_t n = 0; n < nb_elem_nodes; ++n ) {
-            new_nodes_uid.insert( compute_uid( elem_nodes( e, n ) ) );
+            elem_nodes_uid[displs[jelem] + n] = compute_uid( elem_nodes( e, n ) );
         }
     }
+    omp::sort( elem_nodes_uid.begin(), elem_nodes_uid.end() );
+    elem_nodes_uid.erase( std::unique( elem_nodes_uid.begin(), elem_nodes_uid.end() ), elem_nodes_uid.end() );
 
     // Remove nodes we already have in the request-buffer
+    std::vector<uid_t> request_uid( nb_request_nodes );
     for ( idx_t jnode = 0; jnode < nb_request_nodes; ++jnode ) {
-        new_nodes_uid.erase( request_node_uid( jnode ) );
+        request_uid[jnode] = request_node_uid( jnode );
     }
+    omp::sort( request_uid.begin(), request_uid.end() );
+    new_nodes_uid.clear();
+    new_nodes_uid.reserve( elem_nodes_uid.size() );
+    std::set_difference( elem_nodes_uid.begin(), elem_nodes_uid.end(), request_uid.begin(), request_uid.end(),
+                         std::back_inserter( new_nodes_uid ) );
 }
 
 class BuildHaloHelper {
@@ -683,14 +694,13 @@ public:
         buf.node_xy[p].resize( 2 * nb_nodes );
 
         idx_t jnode = 0;
-        typename NodeContainer::iterator it;
+        typename NodeContainer::const_iterator it;
         for ( it = nodes_uid.begin(); it != nodes_uid.end(); ++it, ++jnode ) {
             uid_t uid = *it;
 
-            Uid2Node::iterator found = uid2node.find( uid );
-            if ( found != uid2node.end() )  // Point exists inside domain
+            idx_t node = uid2node.find( uid );
+            if ( node != -1 )  // Point exists inside domain
             {
-                idx_t node                     = found->second;
                 buf.node_glb_idx[p][jnode]     = glb_idx( node );
                 buf.node_part[p][jnode]        = part( node );
                 buf.node_ridx[p][jnode]        = ridx( node );
@@ -749,14 +759,13 @@ public:
         buf.node_xy[p].resize( 2 * nb_nodes );
 
         int jnode = 0;
-        typename NodeContainer::iterator it;
+        typename NodeContainer::const_iterator it;
         for ( it = nodes_uid.begin(); it != nodes_uid.end(); ++it, ++jnode ) {
             uid_t uid = *it;
 
-            Uid2Node::iterator found = uid2node.find( uid );
-            if ( found != uid2node.end() )  // Point exists inside domain
+            int node = uid2node.find( uid );
+            if ( node != -1 )  // Point exists inside domain
             {
-                int node                       = found->second;
                 buf.node_part[p][jnode]        = part( node );
                 buf.node_ridx[p][jnode]        = ridx( node );
                 buf.node_xy[p][jnode * 2 + XX] = xy( node, XX );
@@ -821,19 +830,19 @@ public:
         // Nodes might be duplicated from different Tasks. We need to identify
         // unique entries
         std::vector<uid_t> node_uid( nb_nodes );
-        std::set<uid_t> new_node_uid;
+        UidHashMap new_node_uid;
         {
             ATLAS_TRACE( "compute node_uid" );
-            for ( int jnode = 0; jnode < nb_nodes; ++jnode ) {
+            atlas_omp_parallel_for( int jnode = 0; jnode < nb_nodes; ++jnode ) {
                 node_uid[jnode] = compute_uid( jnode );
             }
-            std::sort( node_uid.begin(), node_uid.end() );
+            omp::sort( node_uid.begin(), node_uid.end() );
         }
         auto node_already_exists = [&node_uid, &new_node_uid]( uid_t uid ) {
             std::vector<uid_t>::iterator it = std::lower_bound( node_uid.begin(), node_uid.end(), uid );
             bool not_found                  = ( it == node_uid.end() || uid < *it );
             if ( not_found ) {
-                bool inserted = new_node_uid.insert( uid ).second;
+                bool inserted = new_node_uid.insert( uid, 0 );
                 return not inserted;
             }
             else {
@@ -898,10 +907,9 @@ public:
 
                 // make sure new node was not already there
                 {
-                    uid_t uid                = compute_uid( loc_idx );
-                    Uid2Node::iterator found = uid2node.find( uid );
-                    if ( found != uid2node.end() ) {
-                        int other = found->second;
+                    uid_t uid = compute_uid( loc_idx );
+                    int other = uid2node.find( uid );
+                    if ( other != -1 ) {
                         std::stringstream msg;
                         msg << "New node with uid " << uid << ":\n"
                             << glb_idx( loc_idx ) << "(" << xy( loc_idx, XX ) << "," << xy( loc_idx, YY ) << ")\n";
@@ -909,7 +917,7 @@ public:
                             << "," << xy( other, YY ) << ")\n";
                         throw_Exception( msg.str(), Here() );
                     }
-                    uid2node[uid] = nb_nodes + new_node;
+                    uid2node.insert( uid, nb_nodes + new_node );
                 }
                 ++new_node;
             }
@@ -926,20 +934,20 @@ public:
         int nb_elems = mesh.cells().size();
         //    std::set<uid_t> elem_uid;
         std::vector<uid_t> elem_uid( 2 * nb_elems );
-        std::set<uid_t> new_elem_uid;
+        UidHashMap new_elem_uid;
         {
             ATLAS_TRACE( "compute elem_uid" );
-            for ( int jelem = 0; jelem < nb_elems; ++jelem ) {
+            atlas_omp_parallel_for( int jelem = 0; jelem < nb_elems; ++jelem ) {
                 elem_uid[jelem * 2 + 0] = -compute_uid( elem_nodes->row( jelem ) );
                 elem_uid[jelem * 2 + 1] = cell_gidx( jelem );
             }
-            std::sort( elem_uid.begin(), elem_uid.end() );
+            omp::sort( elem_uid.begin(), elem_uid.end() );
         }
         auto element_already_exists = [&elem_uid, &new_elem_uid]( uid_t uid ) -> bool {
             std::vector<uid_t>::iterator it = std::lower_bound( elem_uid.begin(), elem_uid.end(), uid );
             bool not_found                  = ( it == elem_uid.end() || uid < *it );
             if ( not_found ) {
-                bool inserted = new_elem_uid.insert( uid ).second;
+                bool inserted = new_elem_uid.insert( uid, 0 );
                 return not inserted;
             }
             else {
@@ -1009,7 +1017,8 @@ public:
                     elem_type_flags( loc_idx )   = buf.elem_flags[jpart][jelem];
                     for ( idx_t n = 0; n < node_connectivity.cols(); ++n ) {
                         node_connectivity.set(
-                            loc_idx, n, uid2node[buf.elem_nodes_id[jpart][buf.elem_nodes_displs[jpart][jelem] + n]] );
+                            loc_idx, n,
+                            uid2node.find( buf.elem_nodes_id[jpart][buf.elem_nodes_displs[jpart][jelem] + n] ) );
                     }
 
                     if ( Topology::check( elem_type_flags( loc_idx ), Topology::PERIODIC ) ) {
@@ -1131,7 +1140,7 @@ void increase_halo_interior( BuildHaloHelper& helper ) {
     // 2) Communicate uid of these boundary nodes to other partitions
 
     std::vector<uid_t> send_bdry_nodes_uid( bdry_nodes.size() );
-    for ( idx_t jnode = 0; jnode < nb_bdry_nodes; ++jnode ) {
+    atlas_omp_parallel_for( idx_t jnode = 0; jnode < nb_bdry_nodes; ++jnode ) {
         send_bdry_nodes_uid[jnode] = helper.compute_uid( bdry_nodes[jnode] );
     }
 
@@ -1155,7 +1164,7 @@ void increase_halo_interior( BuildHaloHelper& helper ) {
         mpi::BufferView<uid_t> recv_bdry_nodes_uid = recv_bdry_nodes_uid_from_parts[jpart];
 
         std::vector<idx_t> found_bdry_elems;
-        std::set<uid_t> found_bdry_nodes_uid;
+        std::vector<uid_t> found_bdry_nodes_uid;
 
         accumulate_elements( helper.mesh, recv_bdry_nodes_uid, helper.uid2node, helper.node_to_elem, found_bdry_elems,
                              found_bdry_nodes_uid );
@@ -1267,7 +1276,7 @@ void increase_halo_periodic( BuildHaloHelper& helper, const PeriodicPoints& peri
         atlas::mpi::BufferView<uid_t> recv_bdry_nodes_uid = recv_bdry_nodes_uid_from_parts[jpart];
 
         std::vector<idx_t> found_bdry_elems;
-        std::set<uid_t> found_bdry_nodes_uid;
+        std::vector<uid_t> found_bdry_nodes_uid;
 
         accumulate_elements( helper.mesh, recv_bdry_nodes_uid, helper.uid2node, helper.node_to_elem, found_bdry_elems,
                              found_bdry_nodes_uid );
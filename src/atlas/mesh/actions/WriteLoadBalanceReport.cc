@@ -14,6 +14,9 @@
 
 #include "eckit/filesystem/PathName.h"
 
+#include "atlas/array/ArrayView.h"
+#include "atlas/array/MakeView.h"
+#include "atlas/field/Field.h"
 #include "atlas/mesh/HybridElements.h"
 #include "atlas/mesh/IsGhostNode.h"
 #include "atlas/mesh/Mesh.h"
@@ -28,21 +31,9 @@ namespace atlas {
 namespace mesh {
 namespace actions {
 
-void write_load_balance_report( const Mesh& mesh, const std::string& filename ) {
-    std::ofstream ofs;
-    if ( mpi::rank() == 0 ) {
-        eckit::PathName path( filename );
-        ofs.open( path.localPath(), std::ofstream::out );
-    }
-
-    write_load_balance_report( mesh, ofs );
-
-    if ( mpi::rank() == 0 ) {
-        ofs.close();
-    }
-}
+namespace {
 
-void write_load_balance_report( const Mesh& mesh, std::ostream& ofs ) {
+void write_report( const Mesh& mesh, const Field* weights, std::ostream& ofs ) {
     idx_t npart = mpi::size();
     idx_t root  = 0;
 
@@ -56,6 +47,9 @@ void write_load_balance_report( const Mesh& mesh, std::ostream& ofs ) {
     std::vector<idx_t> nb_ghost_edges( npart, 0 );
     std::vector<double> nb_ghost_ratio_edges( npart, 0 );
 
+    std::vector<double> owned_weight( npart, 0 );
+    bool has_weights = ( weights != nullptr );
+
     {
         const mesh::Nodes& nodes = mesh.nodes();
         IsGhostNode is_ghost( nodes );
@@ -89,6 +83,23 @@ void write_load_balance_report( const Mesh& mesh, std::ostream& ofs ) {
                 ghost_ratio_nodes[p] = -1;
             }
         }
+
+        if ( has_weights ) {
+            ATLAS_ASSERT( weights->rank() == 1 );
+            auto weight   = array::make_view<double, 1>( *weights );
+            auto glb_idx  = array::make_view<gidx_t, 1>( nodes.global_index() );
+            gidx_t nb_glb = weights->shape( 0 );
+            double wowned( 0 );
+            for ( idx_t n = 0; n < nb_nodes; ++n ) {
+                if ( not is_ghost( n ) ) {
+                    // weights are indexed by grid point, as given to the partitioner
+                    const gidx_t g = glb_idx( n ) - 1;
+                    ATLAS_ASSERT( g >= 0 && g < nb_glb );
+                    wowned += weight( g );
+                }
+            }
+            ATLAS_TRACE_MPI( GATHER ) { mpi::comm().gather( wowned, owned_weight, root ); }
+        }
     }
 
     bool has_edges = mesh.edges().size();
@@ -125,6 +136,9 @@ void write_load_balance_report( const Mesh& mesh, std::ostream& ofs ) {
         ofs << std::setw( idt ) << "owned";
         ofs << std::setw( idt ) << "ghost";
         ofs << std::setw( idt ) << "ratio(%)";
+        if ( has_weights ) {
+            ofs << std::setw( idt + 4 ) << "weight";
+        }
         if ( has_edges ) {
             ofs << std::setw( idt ) << "edges";
             ofs << std::setw( idt ) << "oedges";
@@ -136,6 +150,10 @@ void write_load_balance_report( const Mesh& mesh, std::ostream& ofs ) {
         ofs << std::setw( idt ) << std::accumulate( nb_owned_nodes.data(), nb_owned_nodes.data() + npart, 0 );
         ofs << std::setw( idt ) << std::accumulate( nb_ghost_nodes.data(), nb_ghost_nodes.data() + npart, 0 );
         ofs << std::setw( idt ) << "/";
+        if ( has_weights ) {
+            ofs << std::setw( idt + 4 ) << std::fixed << std::setprecision( 2 )
+                << std::accumulate( owned_weight.data(), owned_weight.data() + npart, 0. );
+        }
         if ( has_edges ) {
             ofs << std::setw( idt ) << std::accumulate( nb_total_edges.data(), nb_total_edges.data() + npart, 0 );
             ofs << std::setw( idt ) << std::accumulate( nb_owned_edges.data(), nb_owned_edges.data() + npart, 0 );
@@ -148,6 +166,9 @@ void write_load_balance_report( const Mesh& mesh, std::ostream& ofs ) {
         ofs << std::setw( idt ) << *std::max_element( nb_ghost_nodes.data(), nb_ghost_nodes.data() + npart );
         ofs << std::setw( idt ) << std::setw( idt ) << std::fixed << std::setprecision( 2 )
             << *std::max_element( ghost_ratio_nodes.data(), ghost_ratio_nodes.data() + npart ) * 100.;
+        if ( has_weights ) {
+            ofs << std::setw( idt + 4 ) << *std::max_element( owned_weight.data(), owned_weight.data() + npart );
+        }
         if ( has_edges ) {
             ofs << std::setw( idt ) << *std::max_element( nb_total_edges.data(), nb_total_edges.data() + npart );
             ofs << std::setw( idt ) << *std::max_element( nb_owned_edges.data(), nb_owned_edges.data() + npart );
@@ -160,6 +181,9 @@ void write_load_balance_report( const Mesh& mesh, std::ostream& ofs ) {
         ofs << std::setw( idt ) << *std::min_element( nb_ghost_nodes.data(), nb_ghost_nodes.data() + npart );
         ofs << std::setw( idt ) << std::fixed << std::setprecision( 2 )
             << *std::min_element( ghost_ratio_nodes.data(), ghost_ratio_nodes.data() + npart ) * 100.;
+        if ( has_weights ) {
+            ofs << std::setw( idt + 4 ) << *std::min_element( owned_weight.data(), owned_weight.data() + npart );
+        }
         if ( has_edges ) {
             ofs << std::setw( idt ) << *std::min_element( nb_total_edges.data(), nb_total_edges.data() + npart );
             ofs << std::setw( idt ) << *std::min_element( nb_owned_edges.data(), nb_owned_edges.data() + npart );
@@ -173,6 +197,11 @@ void write_load_balance_report( const Mesh& mesh, std::ostream& ofs ) {
         ofs << std::setw( idt ) << std::fixed << std::setprecision( 2 )
             << std::accumulate( ghost_ratio_nodes.data(), ghost_ratio_nodes.data() + npart, 0. ) /
                    static_cast<double>( npart ) * 100.;
+        if ( has_weights ) {
+            ofs << std::setw( idt + 4 )
+                << std::accumulate( owned_weight.data(), owned_weight.data() + npart, 0. ) /
+                       static_cast<double>( npart );
+        }
         if ( has_edges ) {
             ofs << std::setw( idt )
                 << std::accumulate( nb_total_edges.data(), nb_total_edges.data() + npart, 0 ) / npart;
@@ -182,6 +211,14 @@ void write_load_balance_report( const Mesh& mesh, std::ostream& ofs ) {
                 << std::accumulate( nb_ghost_edges.data(), nb_ghost_edges.data() + npart, 0 ) / npart;
         }
         ofs << "\n";
+        if ( has_weights ) {
+            // Weighted imbalance: the slowest task determines the cost, relative to a perfect balance
+            double avg_weight =
+                std::accumulate( owned_weight.data(), owned_weight.data() + npart, 0. ) / static_cast<double>( npart );
+            double max_weight = *std::max_element( owned_weight.data(), owned_weight.data() + npart );
+            ofs << "# weighted imbalance (max/avg) : " << std::fixed << std::setprecision( 4 )
+                << ( avg_weight > 0. ? max_weight / avg_weight : 1. ) << "\n";
+        }
         ofs << "#----------------------------------------------------\n";
         ofs << "# PER TASK\n";
         ofs << std::setw( 6 ) << "# part";
@@ -189,6 +226,9 @@ void write_load_balance_report( const Mesh& mesh, std::ostream& ofs ) {
         ofs << std::setw( idt ) << "owned";
         ofs << std::setw( idt ) << "ghost";
         ofs << std::setw( idt ) << "ratio(%)";
+        if ( has_weights ) {
+            ofs << std::setw( idt + 4 ) << "weight";
+        }
         if ( has_edges ) {
             ofs << std::setw( idt ) << "edges";
             ofs << std::setw( idt ) << "oedges";
@@ -201,6 +241,9 @@ void write_load_balance_report( const Mesh& mesh, std::ostream& ofs ) {
             ofs << std::setw( idt ) << nb_owned_nodes[jpart];
             ofs << std::setw( idt ) << nb_ghost_nodes[jpart];
             ofs << std::setw( idt ) << std::fixed << std::setprecision( 2 ) << ghost_ratio_nodes[jpart] * 100.;
+            if ( has_weights ) {
+                ofs << std::setw( idt + 4 ) << owned_weight[jpart];
+            }
             if ( has_edges ) {
                 ofs << std::setw( idt ) << nb_total_edges[jpart];
                 ofs << std::setw( idt ) << nb_owned_edges[jpart];
@@ -211,6 +254,38 @@ void write_load_balance_report( const Mesh& mesh, std::ostream& ofs ) {
     }
 }
 
+void write_report( const Mesh& mesh, const Field* weights, const std::string& filename ) {
+    std::ofstream ofs;
+    if ( mpi::rank() == 0 ) {
+        eckit::PathName path( filename );
+        ofs.open( path.localPath(), std::ofstream::out );
+    }
+
+    write_report( mesh, weights, ofs );
+
+    if ( mpi::rank() == 0 ) {
+        ofs.close();
+    }
+}
+
+}  // namespace
+
+void write_load_balance_report( const Mesh& mesh, const std::string& filename ) {
+    write_report( mesh, nullptr, filename );
+}
+
+void write_load_balance_report( const Mesh& mesh, std::ostream& ofs ) {
+    write_report( mesh, nullptr, ofs );
+}
+
+void write_load_balance_report( const Mesh& mesh, const Field& weights, const std::string& filename ) {
+    write_report( mesh, &weights, filename );
+}
+
+void write_load_balance_report( const Mesh& mesh, const Field& weights, std::ostream& ofs ) {
+    write_report( mesh, &weights, ofs );
+}
+
 // ------------------------------------------------------------------
 
 // C wrapper interfaces to C++ routines
@@ -11,6 +11,7 @@
 #pragma once
 
 namespace atlas {
+class Field;
 class Mesh;
 namespace mesh {
 namespace actions {
@@ -18,6 +19,12 @@ namespace actions {
 void write_load_balance_report( const Mesh& mesh, std::ostream& ofs );
 void write_load_balance_report( const Mesh& mesh, const std::string& filename );
 
+/// Also report the owned weight per task, and the weighted imbalance (max/avg owned weight).
+/// @param weights  field of rank 1 with the cost of every grid point, indexed by global index - 1, i.e. the
+///                 weights field given to the partitioner
+void write_load_balance_report( const Mesh& mesh, const Field& weights, std::ostream& ofs );
+void write_load_balance_report( const Mesh& mesh, const Field& weights, const std::string& filename );
+
 // ------------------------------------------------------------------
 // C wrapper interfaces to C++ routines
 
@@ -0,0 +1,118 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/mesh/detail/RenumberGlobalIndex.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "atlas/parallel/mpi/Buffer.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/parallel/omp/sort.h"
+#include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Trace.h"
+
+namespace atlas {
+namespace mesh {
+namespace detail {
+
+void renumber_global_index( gidx_t glb_idx[], size_t size, gidx_t base ) {
+    ATLAS_TRACE();
+
+    const auto& comm   = mpi::comm();
+    const idx_t nparts = static_cast<idx_t>( comm.size() );
+    const idx_t mypart = static_cast<idx_t>( comm.rank() );
+
+    // 1) Sort the distinct local indices
+    std::vector<gidx_t> keys( glb_idx, glb_idx + size );
+    omp::sort( keys.begin(), keys.end() );
+    keys.erase( std::unique( keys.begin(), keys.end() ), keys.end() );
+    const size_t nb_keys = keys.size();
+
+    // 2) Choose splitters of the value ranges of every task, from regular samples of the indices of every task
+    std::vector<gidx_t> samples;
+    if ( nb_keys > 0 ) {
+        samples.reserve( nparts - 1 );
+        for ( idx_t jpart = 1; jpart < nparts; ++jpart ) {
+            samples.emplace_back( keys[( jpart * nb_keys ) / nparts] );
+        }
+    }
+    mpi::Buffer<gidx_t, 1> all_samples( nparts );
+    ATLAS_TRACE_MPI( ALLGATHER ) { comm.allGatherv( samples.begin(), samples.end(), all_samples ); }
+    std::sort( all_samples.buffer.begin(), all_samples.buffer.end() );
+
+    const size_t nb_samples = all_samples.buffer.size();
+    std::vector<gidx_t> splitters;
+    if ( nb_samples > 0 ) {
+        splitters.reserve( nparts - 1 );
+        for ( idx_t jpart = 1; jpart < nparts; ++jpart ) {
+            splitters.emplace_back( all_samples.buffer[( jpart * nb_samples ) / nparts] );
+        }
+    }
+
+    // 3) Send every distinct index to the task of its range: task p receives the indices below splitters[p]
+    std::vector<std::vector<gidx_t>> send( nparts );
+    std::vector<std::vector<gidx_t>> recv( nparts );
+    {
+        auto first = keys.begin();
+        for ( idx_t jpart = 0; jpart < nparts; ++jpart ) {
+            auto last = ( jpart < static_cast<idx_t>( splitters.size() ) )
+                            ? std::lower_bound( first, keys.end(), splitters[jpart] )
+                            : keys.end();
+            send[jpart].assign( first, last );
+            first = last;
+        }
+    }
+    ATLAS_TRACE_MPI( ALLTOALL ) { comm.allToAll( send, recv ); }
+
+    // 4) Number the distinct indices of this range, following those of the ranges of all previous tasks
+    std::vector<gidx_t> range;
+    for ( idx_t jpart = 0; jpart < nparts; ++jpart ) {
+        range.insert( range.end(), recv[jpart].begin(), recv[jpart].end() );
+    }
+    omp::sort( range.begin(), range.end() );
+    range.erase( std::unique( range.begin(), range.end() ), range.end() );
+
+    gidx_t nb_range = static_cast<gidx_t>( range.size() );
+    std::vector<gidx_t> nb_range_per_part( nparts );
+    ATLAS_TRACE_MPI( ALLGATHER ) { comm.allGather( nb_range, nb_range_per_part.begin(), nb_range_per_part.end() ); }
+    const gidx_t first_gid =
+        base + 1 + std::accumulate( nb_range_per_part.begin(), nb_range_per_part.begin() + mypart, gidx_t( 0 ) );
+
+    // 5) Return the new index of every received index to the task it came from, in the order it was sent
+    for ( idx_t jpart = 0; jpart < nparts; ++jpart ) {
+        std::vector<gidx_t>& received = recv[jpart];
+        const size_t nb_received      = received.size();
+        atlas_omp_parallel_for( size_t j = 0; j < nb_received; ++j ) {
+            received[j] = first_gid + ( std::lower_bound( range.begin(), range.end(), received[j] ) - range.begin() );
+        }
+    }
+    std::vector<std::vector<gidx_t>> renumbered( nparts );
+    ATLAS_TRACE_MPI( ALLTOALL ) { comm.allToAll( recv, renumbered ); }
+
+    // The ranges of consecutive tasks follow each other, so the returned indices follow the order of keys
+    std::vector<gidx_t> new_keys;
+    new_keys.reserve( nb_keys );
+    for ( idx_t jpart = 0; jpart < nparts; ++jpart ) {
+        new_keys.insert( new_keys.end(), renumbered[jpart].begin(), renumbered[jpart].end() );
+    }
+    ATLAS_ASSERT( new_keys.size() == nb_keys );
+
+    // 6) Replace every local index with its new index
+    atlas_omp_parallel_for( size_t j = 0; j < size; ++j ) {
+        glb_idx[j] = new_keys[std::lower_bound( keys.begin(), keys.end(), glb_idx[j] ) - keys.begin()];
+    }
+}
+
+}  // namespace detail
+}  // namespace mesh
+}  // namespace atlas
@@ -0,0 +1,35 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "atlas/library/config.h"
+
+namespace atlas {
+namespace mesh {
+namespace detail {
+
+/// @brief Renumber global indices held by all MPI tasks to base+1, base+2, ... in increasing order
+///
+/// Equal indices, also on different tasks, get the same new index, so that the result is the dense rank of every
+/// index among all distinct indices of all tasks. This is the same numbering as gathering all indices on one task
+/// and sorting them there, but the indices are sorted in a distributed way instead: the distinct indices are
+/// redistributed over tasks by value ranges chosen from regular samples, and each task numbers its range after an
+/// exclusive prefix sum of the number of distinct indices per task. Apart from nb_tasks^2 samples, no task holds
+/// more than its own indices and its range of distinct indices.
+///
+/// Collective over mpi::comm()
+void renumber_global_index( gidx_t glb_idx[], size_t size, gidx_t base = 0 );
+
+}  // namespace detail
+}  // namespace mesh
+}  // namespace atlas
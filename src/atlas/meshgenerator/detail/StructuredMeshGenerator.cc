@@ -9,6 +9,7 @@
  */
 #include <algorithm>
 #include <cmath>
+#include <exception>
 #include <iomanip>
 #include <limits>
 #include <memory>
@@ -34,6 +35,7 @@
 #include "atlas/meshgenerator/detail/MeshGeneratorFactory.h"
 #include "atlas/meshgenerator/detail/StructuredMeshGenerator.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
 #include "atlas/util/CoordinateEnums.h"
@@ -278,31 +280,41 @@ void StructuredMeshGenerator::generate_region( const StructuredGrid& rg, const g
     /*
 Find min and max latitudes used by this part.
 */
-    n               = 0;
     idx_t lat_north = -1;
-    for ( idx_t jlat = 0; jlat < rg.ny(); ++jlat ) {
-        for ( idx_t jlon = 0; jlon < rg.nx( jlat ); ++jlon ) {
-            if ( distribution.partition( n ) == mypart ) {
-                lat_north = jlat;
-                goto end_north;
-            }
-            ++n;
+    idx_t lat_south = -1;
+    grid::Distribution::ranges_t owned_ranges;
+    if ( distribution.ranges( mypart, owned_ranges ) ) {
+        if ( not owned_ranges.empty() ) {
+            idx_t i;
+            rg.index2ij( owned_ranges.front().begin, i, lat_north );
+            rg.index2ij( owned_ranges.back().end - 1, i, lat_south );
         }
     }
-end_north:
-
-    n               = rg.size() - 1;
-    idx_t lat_south = -1;
-    for ( idx_t jlat = rg.ny() - 1; jlat >= 0; --jlat ) {
-        for ( idx_t jlon = rg.nx( jlat ) - 1; jlon >= 0; --jlon ) {
-            if ( distribution.partition( n ) == mypart ) {
-                lat_south = jlat;
-                goto end_south;
+    else {
+        n = 0;
+        for ( idx_t jlat = 0; jlat < rg.ny(); ++jlat ) {
+            for ( idx_t jlon = 0; jlon < rg.nx( jlat ); ++jlon ) {
+                if ( distribution.partition( n ) == mypart ) {
+                    lat_north = jlat;
+                    goto end_north;
+                }
+                ++n;
+            }
+        }
+    end_north:
+
+        n = rg.size() - 1;
+        for ( idx_t jlat = rg.ny() - 1; jlat >= 0; --jlat ) {
+            for ( idx_t jlon = rg.nx( jlat ) - 1; jlon >= 0; --jlon ) {
+                if ( distribution.partition( n ) == mypart ) {
+                    lat_south = jlat;
+                    goto end_south;
+                }
+                --n;
             }
-            --n;
         }
+    end_south:;
     }
-end_south:
 
     std::vector<idx_t> offset( rg.ny(), 0 );
 
@@ -331,396 +343,420 @@ We need to connect to next region
 
     region.elems.reset( array::Array::create<int>( shape ) );
 
-    int nelems     = 0;
     region.nquads  = 0;
     region.ntriags = 0;
 
     array::ArrayView<int, 3> elemview = array::make_view<int, 3>( *region.elems );
     elemview.assign( -1 );
 
-    for ( idx_t jlat = lat_north; jlat < lat_south; ++jlat ) {
-        //    std::stringstream filename; filename << "/tmp/debug/"<<jlat;
+    // Every pair of latitudes is generated independently, in parallel. Each pair fills its own slice of the
+    // elements array and records which longitudes its elements use. These are merged into the region afterwards in
+    // latitude order, so that the result is identical to a serial generation.
+    struct LatitudePair {
+        idx_t nquads{0};
+        idx_t ntriags{0};
+        idx_t beginN{-1};
+        idx_t endN{-1};
+        idx_t beginS{-1};
+        idx_t endS{-1};
+        void add( idx_t ipN_begin, idx_t ipN_end, idx_t ipS_begin, idx_t ipS_end ) {
+            beginN = ( beginN == -1 ) ? ipN_begin : std::min( beginN, ipN_begin );
+            beginS = ( beginS == -1 ) ? ipS_begin : std::min( beginS, ipS_begin );
+            endN   = std::max( endN, ipN_end );
+            endS   = std::max( endS, ipS_end );
+        }
+    };
+    const idx_t nb_pairs = std::max<idx_t>( lat_south - lat_north, 0 );
+    std::vector<LatitudePair> pairs( nb_pairs );
+    std::exception_ptr error;
 
-        idx_t ilat, latN, latS;
-        idx_t ipN1, ipN2, ipS1, ipS2;
-        double xN1, xN2, yN, xS1, xS2, yS;
-        double dN1S2, dS1N2;  // dN2S2;
-        bool try_make_triangle_up, try_make_triangle_down, try_make_quad;
-        bool add_triag, add_quad;
+    atlas_omp_parallel_for( idx_t jlat = lat_north; jlat < lat_south; ++jlat ) {
+        try {
+            //    std::stringstream filename; filename << "/tmp/debug/"<<jlat;
 
-        ilat = jlat - region.north;
+            idx_t ilat, latN, latS;
+            idx_t ipN1, ipN2, ipS1, ipS2;
+            double xN1, xN2, yN, xS1, xS2, yS;
+            double dN1S2, dS1N2;  // dN2S2;
+            bool try_make_triangle_up, try_make_triangle_down, try_make_quad;
+            bool add_triag, add_quad;
 
-        auto lat_elems_view = elemview.slice( ilat, Range::all(), Range::all() );
+            ilat = jlat - lat_north;
 
-        latN = jlat;
-        latS = jlat + 1;
-        yN   = rg.y( latN );
-        yS   = rg.y( latS );
+            auto lat_elems_view = elemview.slice( ilat, Range::all(), Range::all() );
 
-        idx_t beginN, beginS, endN, endS;
+            latN = jlat;
+            latS = jlat + 1;
+            yN   = rg.y( latN );
+            yS   = rg.y( latS );
 
-        beginN = 0;
-        endN   = rg.nx( latN ) - ( periodic_east_west ? 0 : 1 );
-        if ( eckit::types::is_approximately_equal( yN, 90. ) && unique_pole ) {
-            endN = beginN;
-        }
+            idx_t beginN, beginS, endN, endS;
 
-        beginS = 0;
-        endS   = rg.nx( latS ) - ( periodic_east_west ? 0 : 1 );
-        if ( eckit::types::is_approximately_equal( yS, -90. ) && unique_pole ) {
-            endS = beginS;
-        }
+            beginN = 0;
+            endN   = rg.nx( latN ) - ( periodic_east_west ? 0 : 1 );
+            if ( eckit::types::is_approximately_equal( yN, 90. ) && unique_pole ) {
+                endN = beginN;
+            }
 
-        ipN1 = beginN;
-        ipS1 = beginS;
-        ipN2 = std::min( ipN1 + 1, endN );
-        ipS2 = std::min( ipS1 + 1, endS );
+            beginS = 0;
+            endS   = rg.nx( latS ) - ( periodic_east_west ? 0 : 1 );
+            if ( eckit::types::is_approximately_equal( yS, -90. ) && unique_pole ) {
+                endS = beginS;
+            }
+
+            ipN1 = beginN;
+            ipS1 = beginS;
+            ipN2 = std::min( ipN1 + 1, endN );
+            ipS2 = std::min( ipS1 + 1, endS );
 
-        idx_t jelem = 0;
-        int pE      = distribution.partition( offset.at( latN ) );
+            LatitudePair& pair = pairs[ilat];
+            idx_t jelem        = 0;
+            int pE             = distribution.partition( offset.at( latN ) );
 
 #if DEBUG_OUTPUT
-        Log::info() << "=================\n";
-        Log::info() << "latN, latS : " << latN << ", " << latS << '\n';
+            Log::info() << "=================\n";
+            Log::info() << "latN, latS : " << latN << ", " << latS << '\n';
 #endif
 
-        while ( true ) {
-            if ( ipN1 == endN && ipS1 == endS ) {
-                break;
-            }
+            while ( true ) {
+                if ( ipN1 == endN && ipS1 == endS ) {
+                    break;
+                }
 
 #if DEBUG_OUTPUT
-            Log::info() << "-------\n";
+                Log::info() << "-------\n";
 #endif
 
-            // ATLAS_ASSERT(offset.at(latN)+ipN1 < parts.size());
-            // ATLAS_ASSERT(offset.at(latS)+ipS1 < parts.size());
+                // ATLAS_ASSERT(offset.at(latN)+ipN1 < parts.size());
+                // ATLAS_ASSERT(offset.at(latS)+ipS1 < parts.size());
 
-            int pN1, pS1, pN2, pS2;
-            if ( ipN1 != rg.nx( latN ) ) {
-                pN1 = distribution.partition( offset.at( latN ) + ipN1 );
-            }
-            else {
-                pN1 = distribution.partition( offset.at( latN ) );
-            }
-            if ( ipS1 != rg.nx( latS ) ) {
-                pS1 = distribution.partition( offset.at( latS ) + ipS1 );
-            }
-            else {
-                pS1 = distribution.partition( offset.at( latS ) );
-            }
+                int pN1, pS1, pN2, pS2;
+                if ( ipN1 != rg.nx( latN ) ) {
+                    pN1 = distribution.partition( offset.at( latN ) + ipN1 );
+                }
+                else {
+                    pN1 = distribution.partition( offset.at( latN ) );
+                }
+                if ( ipS1 != rg.nx( latS ) ) {
+                    pS1 = distribution.partition( offset.at( latS ) + ipS1 );
+                }
+                else {
+                    pS1 = distribution.partition( offset.at( latS ) );
+                }
 
-            if ( ipN2 == rg.nx( latN ) ) {
-                pN2 = distribution.partition( offset.at( latN ) );
-            }
-            else {
-                pN2 = distribution.partition( offset.at( latN ) + ipN2 );
-            }
-            if ( ipS2 == rg.nx( latS ) ) {
-                pS2 = distribution.partition( offset.at( latS ) );
-            }
-            else {
-                pS2 = distribution.partition( offset.at( latS ) + ipS2 );
-            }
+                if ( ipN2 == rg.nx( latN ) ) {
+                    pN2 = distribution.partition( offset.at( latN ) );
+                }
+                else {
+                    pN2 = distribution.partition( offset.at( latN ) + ipN2 );
+                }
+                if ( ipS2 == rg.nx( latS ) ) {
+                    pS2 = distribution.partition( offset.at( latS ) );
+                }
+                else {
+                    pS2 = distribution.partition( offset.at( latS ) + ipS2 );
+                }
 
-            // Log::info()  << ipN1 << "("<<pN1<<") " << ipN2 <<"("<<pN2<<")" <<  std::endl;
-            // Log::info()  << ipS1 << "("<<pS2<<") " << ipS2 <<"("<<pS2<<")" <<  std::endl;
+                // Log::info()  << ipN1 << "("<<pN1<<") " << ipN2 <<"("<<pN2<<")" <<  std::endl;
+                // Log::info()  << ipS1 << "("<<pS2<<") " << ipS2 <<"("<<pS2<<")" <<  std::endl;
 
 #if DEBUG_OUTPUT
-            Log::info() << ipN1 << "(" << pN1 << ") " << ipN2 << "(" << pN2 << ")" << std::endl;
-            Log::info() << ipS1 << "(" << pS2 << ") " << ipS2 << "(" << pS2 << ")" << std::endl;
+                Log::info() << ipN1 << "(" << pN1 << ") " << ipN2 << "(" << pN2 << ")" << std::endl;
+                Log::info() << ipS1 << "(" << pS2 << ") " << ipS2 << "(" << pS2 << ")" << std::endl;
 #endif
 
-            xN1 = rg.x( ipN1, latN ) * to_rad;
-            xN2 = rg.x( ipN2, latN ) * to_rad;
-            xS1 = rg.x( ipS1, latS ) * to_rad;
-            xS2 = rg.x( ipS2, latS ) * to_rad;
+                xN1 = rg.x( ipN1, latN ) * to_rad;
+                xN2 = rg.x( ipN2, latN ) * to_rad;
+                xS1 = rg.x( ipS1, latS ) * to_rad;
+                xS2 = rg.x( ipS2, latS ) * to_rad;
 
 #if DEBUG_OUTPUT
-            Log::info() << "-------\n";
+                Log::info() << "-------\n";
 #endif
-            // Log::info()  << "  access  " <<
-            // region.elems.stride(0)*(jlat-region.north) +
-            // region.elems.stride(1)*jelem + 5 << std::endl;
-            //      Log::info()  << ipN1 << "("<< xN1 << ")  " << ipN2 <<  "("<< xN2
-            //      << ")  " << std::endl;
-            //      Log::info()  << ipS1 << "("<< xS1 << ")  " << ipS2 <<  "("<< xS2
-            //      << ")  " << std::endl;
-            try_make_triangle_up   = false;
-            try_make_triangle_down = false;
-            try_make_quad          = false;
-
-            // ------------------------------------------------
-            // START RULES
-            // ------------------------------------------------
-
-            const double dxN    = std::abs( xN2 - xN1 );
-            const double dxS    = std::abs( xS2 - xS1 );
-            const double dx     = std::min( dxN, dxS );
-            const double alpha1 = ( dx == 0. ? 0. : std::atan2( ( xN1 - xS1 ), dx ) * to_deg );
-            const double alpha2 = ( dx == 0. ? 0. : std::atan2( ( xN2 - xS2 ), dx ) * to_deg );
-            if ( std::abs( alpha1 ) <= max_angle && std::abs( alpha2 ) <= max_angle ) {
-                if ( triangulate_quads ) {
-                    if ( false )  // std::abs(alpha1) < 1 && std::abs(alpha2) < 1)
-                    {
-                        try_make_triangle_up   = ( jlat + ipN1 ) % 2;
-                        try_make_triangle_down = ( jlat + ipN1 + 1 ) % 2;
-                    }
-                    else {
-                        dN1S2 = std::abs( xN1 - xS2 );
-                        dS1N2 = std::abs( xS1 - xN2 );
-                        // dN2S2 = std::abs(xN2-xS2);
-                        // Log::info()  << "  dN1S2 " << dN1S2 << "   dS1N2 " << dS1N2 << "
-                        // dN2S2 " << dN2S2 << std::endl;
-                        if ( dN1S2 == dS1N2 ) {
+                // Log::info()  << "  access  " <<
+                // region.elems.stride(0)*(jlat-region.north) +
+                // region.elems.stride(1)*jelem + 5 << std::endl;
+                //      Log::info()  << ipN1 << "("<< xN1 << ")  " << ipN2 <<  "("<< xN2
+                //      << ")  " << std::endl;
+                //      Log::info()  << ipS1 << "("<< xS1 << ")  " << ipS2 <<  "("<< xS2
+                //      << ")  " << std::endl;
+                try_make_triangle_up   = false;
+                try_make_triangle_down = false;
+                try_make_quad          = false;
+
+                // ------------------------------------------------
+                // START RULES
+                // ------------------------------------------------
+
+                const double dxN    = std::abs( xN2 - xN1 );
+                const double dxS    = std::abs( xS2 - xS1 );
+                const double dx     = std::min( dxN, dxS );
+                const double alpha1 = ( dx == 0. ? 0. : std::atan2( ( xN1 - xS1 ), dx ) * to_deg );
+                const double alpha2 = ( dx == 0. ? 0. : std::atan2( ( xN2 - xS2 ), dx ) * to_deg );
+                if ( std::abs( alpha1 ) <= max_angle && std::abs( alpha2 ) <= max_angle ) {
+                    if ( triangulate_quads ) {
+                        if ( false )  // std::abs(alpha1) < 1 && std::abs(alpha2) < 1)
+                        {
                             try_make_triangle_up   = ( jlat + ipN1 ) % 2;
                             try_make_triangle_down = ( jlat + ipN1 + 1 ) % 2;
                         }
-                        else if ( dN1S2 < dS1N2 ) {
-                            if ( ipS1 != ipS2 ) {
-                                try_make_triangle_up = true;
+                        else {
+                            dN1S2 = std::abs( xN1 - xS2 );
+                            dS1N2 = std::abs( xS1 - xN2 );
+                            // dN2S2 = std::abs(xN2-xS2);
+                            // Log::info()  << "  dN1S2 " << dN1S2 << "   dS1N2 " << dS1N2 << "
+                            // dN2S2 " << dN2S2 << std::endl;
+                            if ( dN1S2 == dS1N2 ) {
+                                try_make_triangle_up   = ( jlat + ipN1 ) % 2;
+                                try_make_triangle_down = ( jlat + ipN1 + 1 ) % 2;
                             }
-                            else {
-                                try_make_triangle_down = true;
+                            else if ( dN1S2 < dS1N2 ) {
+                                if ( ipS1 != ipS2 ) {
+                                    try_make_triangle_up = true;
+                                }
+                                else {
+                                    try_make_triangle_down = true;
+                                }
                             }
-                        }
-                        else if ( dN1S2 > dS1N2 ) {
-                            if ( ipN1 != ipN2 ) {
-                                try_make_triangle_down = true;
+                            else if ( dN1S2 > dS1N2 ) {
+                                if ( ipN1 != ipN2 ) {
+                                    try_make_triangle_down = true;
+                                }
+                                else {
+                                    try_make_triangle_up = true;
+                                }
                             }
                             else {
-                                try_make_triangle_up = true;
+                                throw_Exception( "Should not be here", Here() );
                             }
                         }
-                        else {
-                            throw_Exception( "Should not be here", Here() );
-                        }
-                    }
-                }
-                else {
-                    if ( ipN1 == ipN2 ) {
-                        try_make_triangle_up = true;
-                    }
-                    else if ( ipS1 == ipS2 ) {
-                        try_make_triangle_down = true;
                     }
                     else {
-                        try_make_quad = true;
-                    }
+                        if ( ipN1 == ipN2 ) {
+                            try_make_triangle_up = true;
+                        }
+                        else if ( ipS1 == ipS2 ) {
+                            try_make_triangle_down = true;
+                        }
+                        else {
+                            try_make_quad = true;
+                        }
 
-                    //          try_make_quad          = true;
-                }
-            }
-            else {
-                dN1S2 = std::abs( xN1 - xS2 );
-                dS1N2 = std::abs( xS1 - xN2 );
-                // dN2S2 = std::abs(xN2-xS2);
-                // Log::info()  << "  dN1S2 " << dN1S2 << "   dS1N2 " << dS1N2 << "
-                // dN2S2 " << dN2S2 << std::endl;
-                if ( ( dN1S2 <= dS1N2 ) && ( ipS1 != ipS2 ) ) {
-                    try_make_triangle_up = true;
-                }
-                else if ( ( dN1S2 >= dS1N2 ) && ( ipN1 != ipN2 ) ) {
-                    try_make_triangle_down = true;
+                        //          try_make_quad          = true;
+                    }
                 }
                 else {
-                    if ( ipN1 == ipN2 ) {
+                    dN1S2 = std::abs( xN1 - xS2 );
+                    dS1N2 = std::abs( xS1 - xN2 );
+                    // dN2S2 = std::abs(xN2-xS2);
+                    // Log::info()  << "  dN1S2 " << dN1S2 << "   dS1N2 " << dS1N2 << "
+                    // dN2S2 " << dN2S2 << std::endl;
+                    if ( ( dN1S2 <= dS1N2 ) && ( ipS1 != ipS2 ) ) {
                         try_make_triangle_up = true;
                     }
-                    else if ( ipS1 == ipS2 ) {
+                    else if ( ( dN1S2 >= dS1N2 ) && ( ipN1 != ipN2 ) ) {
                         try_make_triangle_down = true;
                     }
                     else {
-                        ATLAS_DEBUG_VAR( dN1S2 );
-                        ATLAS_DEBUG_VAR( dS1N2 );
-                        ATLAS_DEBUG_VAR( jlat );
-                        Log::info() << ipN1 << "(" << xN1 << ")  " << ipN2 << "(" << xN2 << ")  " << std::endl;
-                        Log::info() << ipS1 << "(" << xS1 << ")  " << ipS2 << "(" << xS2 << ")  " << std::endl;
-                        throw_Exception( "Should not try to make a quadrilateral!", Here() );
+                        if ( ipN1 == ipN2 ) {
+                            try_make_triangle_up = true;
+                        }
+                        else if ( ipS1 == ipS2 ) {
+                            try_make_triangle_down = true;
+                        }
+                        else {
+                            ATLAS_DEBUG_VAR( dN1S2 );
+                            ATLAS_DEBUG_VAR( dS1N2 );
+                            ATLAS_DEBUG_VAR( jlat );
+                            Log::info() << ipN1 << "(" << xN1 << ")  " << ipN2 << "(" << xN2 << ")  " << std::endl;
+                            Log::info() << ipS1 << "(" << xS1 << ")  " << ipS2 << "(" << xS2 << ")  " << std::endl;
+                            throw_Exception( "Should not try to make a quadrilateral!", Here() );
+                        }
                     }
                 }
-            }
-            // ------------------------------------------------
-            // END RULES
-            // ------------------------------------------------
+                // ------------------------------------------------
+                // END RULES
+                // ------------------------------------------------
 
 #if DEBUG_OUTPUT
-            ATLAS_DEBUG_VAR( jelem );
+                ATLAS_DEBUG_VAR( jelem );
 #endif
 
-            auto elem = lat_elems_view.slice( jelem, Range::all() );
+                auto elem = lat_elems_view.slice( jelem, Range::all() );
 
-            if ( try_make_quad ) {
-// add quadrilateral
+                if ( try_make_quad ) {
+    // add quadrilateral
 #if DEBUG_OUTPUT
-                Log::info() << "          " << ipN1 << "  " << ipN2 << '\n';
-                Log::info() << "          " << ipS1 << "  " << ipS2 << '\n';
+                    Log::info() << "          " << ipN1 << "  " << ipN2 << '\n';
+                    Log::info() << "          " << ipS1 << "  " << ipS2 << '\n';
 #endif
-                elem( 0 ) = ipN1;
-                elem( 1 ) = ipS1;
-                elem( 2 ) = ipS2;
-                elem( 3 ) = ipN2;
-                add_quad  = false;
-                std::array<int, 4> np{pN1, pN2, pS1, pS2};
-                std::array<int, 4> pcnts;
-                for ( int j = 0; j < 4; ++j ) {
-                    pcnts[j] = static_cast<int>( std::count( np.begin(), np.end(), np[j] ) );
-                }
-                if ( pcnts[0] > 2 ) {  // 3 or more of pN1
-                    pE = pN1;
-                    if ( latS == rg.ny() - 1 ) {
-                        pE = pS1;
-                    }
-                }
-                else if ( pcnts[2] > 2 ) {  // 3 or more of pS1
-                    pE = pS1;
-                    if ( latN == 0 ) {
-                        pE = pN1;
+                    elem( 0 ) = ipN1;
+                    elem( 1 ) = ipS1;
+                    elem( 2 ) = ipS2;
+                    elem( 3 ) = ipN2;
+                    add_quad  = false;
+                    std::array<int, 4> np{pN1, pN2, pS1, pS2};
+                    std::array<int, 4> pcnts;
+                    for ( int j = 0; j < 4; ++j ) {
+                        pcnts[j] = static_cast<int>( std::count( np.begin(), np.end(), np[j] ) );
                     }
-                }
-                else {
-                    std::array<int, 4>::iterator p_max = std::max_element( pcnts.begin(), pcnts.end() );
-                    if ( *p_max > 2 ) {  // 3 or 4 points belong to same part
-                        pE = np[std::distance( np.begin(), p_max )];
-                    }
-                    else {  // 3 or 4 points don't belong to mypart
+                    if ( pcnts[0] > 2 ) {  // 3 or more of pN1
                         pE = pN1;
                         if ( latS == rg.ny() - 1 ) {
                             pE = pS1;
                         }
                     }
-                }
-                add_quad = ( pE == mypart );
-                if ( add_quad ) {
-                    ++region.nquads;
-                    ++jelem;
-                    ++nelems;
-
-                    if ( region.lat_begin.at( latN ) == -1 ) {
-                        region.lat_begin.at( latN ) = ipN1;
+                    else if ( pcnts[2] > 2 ) {  // 3 or more of pS1
+                        pE = pS1;
+                        if ( latN == 0 ) {
+                            pE = pN1;
+                        }
                     }
-                    if ( region.lat_begin.at( latS ) == -1 ) {
-                        region.lat_begin.at( latS ) = ipS1;
+                    else {
+                        std::array<int, 4>::iterator p_max = std::max_element( pcnts.begin(), pcnts.end() );
+                        if ( *p_max > 2 ) {  // 3 or 4 points belong to same part
+                            pE = np[std::distance( np.begin(), p_max )];
+                        }
+                        else {  // 3 or 4 points don't belong to mypart
+                            pE = pN1;
+                            if ( latS == rg.ny() - 1 ) {
+                                pE = pS1;
+                            }
+                        }
                     }
-                    region.lat_begin.at( latN ) = std::min<int>( region.lat_begin.at( latN ), ipN1 );
-                    region.lat_begin.at( latS ) = std::min<int>( region.lat_begin.at( latS ), ipS1 );
-                    region.lat_end.at( latN )   = std::max<int>( region.lat_end.at( latN ), ipN2 );
-                    region.lat_end.at( latS )   = std::max<int>( region.lat_end.at( latS ), ipS2 );
-                }
-                else {
+                    add_quad = ( pE == mypart );
+                    if ( add_quad ) {
+                        ++pair.nquads;
+                        ++jelem;
+                        pair.add( ipN1, ipN2, ipS1, ipS2 );
+                    }
+                    else {
 #if DEBUG_OUTPUT
-                    Log::info() << "Quad belongs to other partition" << std::endl;
+                        Log::info() << "Quad belongs to other partition" << std::endl;
 #endif
+                    }
+                    ipN1 = ipN2;
+                    ipS1 = ipS2;
                 }
-                ipN1 = ipN2;
-                ipS1 = ipS2;
-            }
-            else if ( try_make_triangle_down )  // make triangle down
-            {
-// triangle without ip3
+                else if ( try_make_triangle_down )  // make triangle down
+                {
+    // triangle without ip3
 #if DEBUG_OUTPUT
-                Log::info() << "          " << ipN1 << "  " << ipN2 << '\n';
-                Log::info() << "          " << ipS1 << '\n';
+                    Log::info() << "          " << ipN1 << "  " << ipN2 << '\n';
+                    Log::info() << "          " << ipS1 << '\n';
 #endif
-                elem( 0 ) = ipN1;
-                elem( 1 ) = ipS1;
-                elem( 2 ) = -1;
-                elem( 3 ) = ipN2;
-
-                pE = pN1;
-                if ( latS == rg.ny() - 1 ) {
-                    pE = pS1;
-                }
-                add_triag = ( mypart == pE );
+                    elem( 0 ) = ipN1;
+                    elem( 1 ) = ipS1;
+                    elem( 2 ) = -1;
+                    elem( 3 ) = ipN2;
 
-                if ( add_triag ) {
-                    ++region.ntriags;
-                    ++jelem;
-                    ++nelems;
-
-                    if ( region.lat_begin.at( latN ) == -1 ) {
-                        region.lat_begin.at( latN ) = ipN1;
+                    pE = pN1;
+                    if ( latS == rg.ny() - 1 ) {
+                        pE = pS1;
                     }
-                    if ( region.lat_begin.at( latS ) == -1 ) {
-                        region.lat_begin.at( latS ) = ipS1;
+                    add_triag = ( mypart == pE );
+
+                    if ( add_triag ) {
+                        ++pair.ntriags;
+                        ++jelem;
+                        pair.add( ipN1, ipN2, ipS1, ipS1 );
                     }
-                    region.lat_begin.at( latN ) = std::min<int>( region.lat_begin.at( latN ), ipN1 );
-                    region.lat_begin.at( latS ) = std::min<int>( region.lat_begin.at( latS ), ipS1 );
-                    region.lat_end.at( latN )   = std::max<int>( region.lat_end.at( latN ), ipN2 );
-                    region.lat_end.at( latS )   = std::max<int>( region.lat_end.at( latS ), ipS1 );
-                }
-                else {
+                    else {
 #if DEBUG_OUTPUT
-                    Log::info() << "Downward Triag belongs to other partition" << std::endl;
+                        Log::info() << "Downward Triag belongs to other partition" << std::endl;
 #endif
+                    }
+                    ipN1 = ipN2;
+                    // and ipS1=ipS1;
                 }
-                ipN1 = ipN2;
-                // and ipS1=ipS1;
-            }
-            else if ( try_make_triangle_up )  // make triangle up
-            {
-// triangle without ip4
+                else if ( try_make_triangle_up )  // make triangle up
+                {
+    // triangle without ip4
 #if DEBUG_OUTPUT
-                Log::info() << "          " << ipN1 << " (" << pN1 << ")" << '\n';
-                Log::info() << "          " << ipS1 << " (" << pS1 << ")"
-                            << "  " << ipS2 << " (" << pS2 << ")" << '\n';
+                    Log::info() << "          " << ipN1 << " (" << pN1 << ")" << '\n';
+                    Log::info() << "          " << ipS1 << " (" << pS1 << ")"
+                                << "  " << ipS2 << " (" << pS2 << ")" << '\n';
 #endif
-                elem( 0 ) = ipN1;
-                elem( 1 ) = ipS1;
-                elem( 2 ) = ipS2;
-                elem( 3 ) = -1;
-
-                if ( pS1 == pE && pN1 != pE ) {
-                    if ( xN1 < 0.5 * ( xS1 + xS2 ) ) {
+                    elem( 0 ) = ipN1;
+                    elem( 1 ) = ipS1;
+                    elem( 2 ) = ipS2;
+                    elem( 3 ) = -1;
+
+                    if ( pS1 == pE && pN1 != pE ) {
+                        if ( xN1 < 0.5 * ( xS1 + xS2 ) ) {
+                            pE = pN1;
+                        }  // else pE of previous element
+                    }
+                    else {
                         pE = pN1;
-                    }  // else pE of previous element
-                }
-                else {
-                    pE = pN1;
-                }
-                if ( ipN1 == rg.nx( latN ) ) {
-                    pE = pS1;
-                }
-                if ( latS == rg.ny() - 1 ) {
-                    pE = pS1;
-                }
-
-                add_triag = ( mypart == pE );
+                    }
+                    if ( ipN1 == rg.nx( latN ) ) {
+                        pE = pS1;
+                    }
+                    if ( latS == rg.ny() - 1 ) {
+                        pE = pS1;
+                    }
 
-                if ( add_triag ) {
-                    ++region.ntriags;
-                    ++jelem;
-                    ++nelems;
+                    add_triag = ( mypart == pE );
 
-                    if ( region.lat_begin.at( latN ) == -1 ) {
-                        region.lat_begin.at( latN ) = ipN1;
+                    if ( add_triag ) {
+                        ++pair.ntriags;
+                        ++jelem;
+                        pair.add( ipN1, ipN1, ipS1, ipS2 );
                     }
-                    if ( region.lat_begin.at( latS ) == -1 ) {
-                        region.lat_begin.at( latS ) = ipS1;
+                    else {
+#if DEBUG_OUTPUT
+                        Log::info() << "Upward Triag belongs to other partition" << std::endl;
+#endif
                     }
-                    region.lat_begin.at( latN ) = std::min( region.lat_begin.at( latN ), ipN1 );
-                    region.lat_begin.at( latS ) = std::min( region.lat_begin.at( latS ), ipS1 );
-                    region.lat_end.at( latN )   = std::max( region.lat_end.at( latN ), ipN1 );
-                    region.lat_end.at( latS )   = std::max( region.lat_end.at( latS ), ipS2 );
+                    ipS1 = ipS2;
+                    // and ipN1=ipN1;
                 }
                 else {
+                    throw_Exception( "Could not detect which element to create", Here() );
+                }
+                ipN2 = std::min( endN, ipN1 + 1 );
+                ipS2 = std::min( endS, ipS1 + 1 );
+            }
+            region.nb_lat_elems.at( jlat ) = jelem;
 #if DEBUG_OUTPUT
-                    Log::info() << "Upward Triag belongs to other partition" << std::endl;
+            ATLAS_DEBUG_VAR( region.nb_lat_elems.at( jlat ) );
 #endif
+        }
+        catch ( ... ) {
+            atlas_omp_critical {
+                if ( not error ) {
+                    error = std::current_exception();
                 }
-                ipS1 = ipS2;
-                // and ipN1=ipN1;
             }
-            else {
-                throw_Exception( "Could not detect which element to create", Here() );
+        }
+    }
+    if ( error ) {
+        std::rethrow_exception( error );
+    }
+
+    for ( idx_t jlat = lat_north; jlat < lat_south; ++jlat ) {
+        const LatitudePair& pair = pairs[jlat - lat_north];
+        const idx_t latN         = jlat;
+        const idx_t latS         = jlat + 1;
+        const double yN          = rg.y( latN );
+        const double yS          = rg.y( latS );
+
+        region.nquads += pair.nquads;
+        region.ntriags += pair.ntriags;
+        if ( region.nb_lat_elems.at( jlat ) > 0 ) {
+            if ( region.lat_begin.at( latN ) == -1 ) {
+                region.lat_begin.at( latN ) = pair.beginN;
+            }
+            if ( region.lat_begin.at( latS ) == -1 ) {
+                region.lat_begin.at( latS ) = pair.beginS;
             }
-            ipN2 = std::min( endN, ipN1 + 1 );
-            ipS2 = std::min( endS, ipS1 + 1 );
+            region.lat_begin.at( latN ) = std::min( region.lat_begin.at( latN ), pair.beginN );
+            region.lat_begin.at( latS ) = std::min( region.lat_begin.at( latS ), pair.beginS );
+            region.lat_end.at( latN )   = std::max( region.lat_end.at( latN ), pair.endN );
+            region.lat_end.at( latS )   = std::max( region.lat_end.at( latS ), pair.endS );
         }
-        region.nb_lat_elems.at( jlat ) = jelem;
-#if DEBUG_OUTPUT
-        ATLAS_DEBUG_VAR( region.nb_lat_elems.at( jlat ) );
-#endif
+
         if ( region.nb_lat_elems.at( jlat ) == 0 && latN == region.north ) {
             ++region.north;
         }
@@ -744,13 +780,25 @@ We need to connect to next region
         }
     }  // for jlat
 
+    // Elements of the pair of latitudes jlat are expected at index jlat - region.north, which moved south when the
+    // northernmost pairs have no elements
+    const idx_t shift = region.north - lat_north;
+    if ( shift > 0 ) {
+        for ( idx_t ilat = 0; ilat + shift < nb_pairs; ++ilat ) {
+            for ( idx_t jelem = 0; jelem < elemview.shape( 1 ); ++jelem ) {
+                for ( idx_t k = 0; k < 4; ++k ) {
+                    elemview( ilat, jelem, k ) = elemview( ilat + shift, jelem, k );
+                }
+            }
+        }
+    }
+
     //  Log::info()  << "nb_triags = " << region.ntriags << std::endl;
     //  Log::info()  << "nb_quads = " << region.nquads << std::endl;
-    //  Log::info()  << "nb_elems = " << nelems << std::endl;
+    //  Log::info()  << "nb_elems = " << region.ntriags + region.nquads << std::endl;
 
-    int nb_region_nodes = 0;
-    for ( int jlat = region.north; jlat <= region.south; ++jlat ) {
-        n                           = offset.at( jlat );
+    atlas_omp_parallel_for( idx_t jlat = region.north; jlat <= region.south; ++jlat ) {
+        gidx_t n                    = offset.at( jlat );
         region.lat_begin.at( jlat ) = std::max<idx_t>( 0, region.lat_begin.at( jlat ) );
         for ( idx_t jlon = 0; jlon < rg.nx( jlat ); ++jlon ) {
             if ( distribution.partition( n ) == mypart ) {
@@ -759,6 +807,10 @@ We need to connect to next region
             }
             ++n;
         }
+    }
+
+    int nb_region_nodes = 0;
+    for ( idx_t jlat = region.north; jlat <= region.south; ++jlat ) {
         nb_region_nodes += region.lat_end.at( jlat ) - region.lat_begin.at( jlat ) + 1;
 
         // Count extra periodic node
@@ -1005,18 +1057,26 @@ void StructuredMeshGenerator::generate_mesh( const StructuredGrid& rg, const gri
         }
     }
 
-    idx_t jnode = 0;
-    l           = 0;
+    // First node of every latitude, so that the latitudes can be filled in parallel
+    l = 0;
     for ( idx_t jlat = region.north; jlat <= region.south; ++jlat ) {
         idx_t ilat            = jlat - region.north;
         offset_loc.at( ilat ) = l;
         l += region.lat_end.at( jlat ) - region.lat_begin.at( jlat ) + 1;
+        if ( not include_periodic_ghost_points && region.lat_end.at( jlat ) >= rg.nx( jlat ) ) {
+            l -= region.lat_end.at( jlat ) - std::max( region.lat_begin.at( jlat ), rg.nx( jlat ) ) + 1;
+        }
+    }
+
+    atlas_omp_parallel_for( idx_t jlat = region.north; jlat <= region.south; ++jlat ) {
+        idx_t ilat  = jlat - region.north;
+        idx_t jnode = offset_loc.at( ilat );
 
         double y = rg.y( jlat );
         for ( idx_t jlon = region.lat_begin.at( jlat ); jlon <= region.lat_end.at( jlat ); ++jlon ) {
             if ( jlon < rg.nx( jlat ) ) {
                 idx_t inode = node_numbering.at( jnode );
-                n           = offset_glb.at( jlat ) + jlon;
+                gidx_t n    = offset_glb.at( jlat ) + jlon;
 
                 double x = rg.x( jlon, jlat );
                 // std::cout << "jlat = " << jlat << "; jlon = " << jlon << "; x = " <<
@@ -1104,11 +1164,9 @@ void StructuredMeshGenerator::generate_mesh( const StructuredGrid& rg, const gri
                 }
                 ++jnode;
             }
-            else {
-                --l;
-            }
         }
     }
+    idx_t jnode = l;
 
     idx_t jnorth = -1;
     if ( include_north_pole ) {
@@ -1184,13 +1242,8 @@ void StructuredMeshGenerator::generate_mesh( const StructuredGrid& rg, const gri
     /*
      * Fill in connectivity tables with global node indices first
      */
-    idx_t jcell;
-    idx_t jquad       = 0;
-    idx_t jtriag      = 0;
     idx_t quad_begin  = mesh.cells().elements( 0 ).begin();
     idx_t triag_begin = mesh.cells().elements( 1 ).begin();
-    idx_t quad_nodes[4];
-    idx_t triag_nodes[3];
 
     auto fix_quad_orientation = []( idx_t nodes[] ) {
         idx_t tmp;
@@ -1209,14 +1262,40 @@ void StructuredMeshGenerator::generate_mesh( const StructuredGrid& rg, const gri
     };
 
 
-    for ( idx_t jlat = region.north; jlat < region.south; ++jlat ) {
-        idx_t ilat  = jlat - region.north;
-        idx_t jlatN = jlat;
-        idx_t jlatS = jlat + 1;
-        idx_t ilatN = ilat;
-        idx_t ilatS = ilat + 1;
+    // Count quadrilaterals and triangles per pair of latitudes first, so that every pair fills its own range of
+    // cells in parallel, in the same order as a serial loop
+    auto elems           = array::make_view<int, 3>( *region.elems );
+    const idx_t nb_pairs = std::max<idx_t>( region.south - region.north, 0 );
+    std::vector<idx_t> jquad_begin( nb_pairs + 1, 0 );
+    std::vector<idx_t> jtriag_begin( nb_pairs + 1, 0 );
+    atlas_omp_parallel_for( idx_t ilat = 0; ilat < nb_pairs; ++ilat ) {
+        idx_t nquads_pair = 0;
+        for ( idx_t jelem = 0; jelem < region.nb_lat_elems.at( region.north + ilat ); ++jelem ) {
+            if ( elems( ilat, jelem, 2 ) >= 0 && elems( ilat, jelem, 3 ) >= 0 ) {
+                ++nquads_pair;
+            }
+        }
+        jquad_begin[ilat + 1]  = nquads_pair;
+        jtriag_begin[ilat + 1] = region.nb_lat_elems.at( region.north + ilat ) - nquads_pair;
+    }
+    for ( idx_t ilat = 0; ilat < nb_pairs; ++ilat ) {
+        jquad_begin[ilat + 1] += jquad_begin[ilat];
+        jtriag_begin[ilat + 1] += jtriag_begin[ilat];
+    }
+
+    atlas_omp_parallel_for( idx_t jlat = region.north; jlat < region.south; ++jlat ) {
+        idx_t ilat   = jlat - region.north;
+        idx_t jlatN  = jlat;
+        idx_t jlatS  = jlat + 1;
+        idx_t ilatN  = ilat;
+        idx_t ilatS  = ilat + 1;
+        idx_t jquad  = jquad_begin[ilat];
+        idx_t jtriag = jtriag_begin[ilat];
+        idx_t jcell;
+        idx_t quad_nodes[4];
+        idx_t triag_nodes[3];
         for ( idx_t jelem = 0; jelem < region.nb_lat_elems.at( jlat ); ++jelem ) {
-            const auto elem = array::make_view<int, 3>( *region.elems ).slice( ilat, jelem, Range::all() );
+            const auto elem = elems.slice( ilat, jelem, Range::all() );
 
             if ( elem( 2 ) >= 0 && elem( 3 ) >= 0 )  // This is a quad
             {
@@ -1293,6 +1372,12 @@ void StructuredMeshGenerator::generate_mesh( const StructuredGrid& rg, const gri
         }
     }
 
+    idx_t jcell;
+    idx_t jquad  = jquad_begin[nb_pairs];
+    idx_t jtriag = jtriag_begin[nb_pairs];
+    idx_t quad_nodes[4];
+    idx_t triag_nodes[3];
+
     if ( include_north_pole ) {
         idx_t ilat = 0;
         idx_t ip1  = 0;
@@ -10,6 +10,10 @@
 
 #pragma once
 
+#include <string>
+
+#include "eckit/config/Configuration.h"
+
 #include "atlas/util/Geometry.h"
 #include "atlas/util/ObjectHandle.h"
 #include "atlas/util/detail/KDTree.h"
@@ -21,7 +25,9 @@ namespace util {
 
 /// @brief k-dimensional tree constructable both with 2D (lon,lat) points as with 3D (x,y,z) points
 ///
-/// The implementation is based on eckit::KDTreeMemory with 3D (x,y,z) points.
+/// The default implementation is based on eckit::KDTreeMemory with 3D (x,y,z) points. Alternatively, with the
+/// option type="flat", points and payloads are stored in contiguous arrays (detail::FlatKDTree); this tree is
+/// built in parallel, uses less memory, and its searches are thread-safe. It must always be built with build().
 /// 2D points (lon,lat) are converted when needed to 3D during insertion, and during search, so that
 /// a search always happens with 3D cartesian points.
 ///
@@ -71,6 +77,14 @@ public:
     /// @brief Construct an empty kd-tree with custom geometry
     KDTree( const Geometry& geometry ) : Handle( new detail::KDTreeMemory<Payload, Point>( geometry ) ) {}
 
+    /// @brief Construct an empty kd-tree of given implementation, with default geometry (Earth)
+    /// The implementation is selected with the "type" option: "eckit" (default) or "flat"
+    KDTree( const eckit::Configuration& config ) : Handle( create( Geometry(), config ) ) {}
+
+    /// @brief Construct an empty kd-tree of given implementation, with custom geometry
+    /// The implementation is selected with the "type" option: "eckit" (default) or "flat"
+    KDTree( const Geometry& geometry, const eckit::Configuration& config ) : Handle( create( geometry, config ) ) {}
+
     /// @brief Construct a shared kd-tree with default geometry (Earth)
     template <typename Tree>
     KDTree( const std::shared_ptr<Tree>& kdtree ) :
@@ -142,6 +156,15 @@ public:
     /// @post The KDTree is ready to be used
     void build( const std::vector<Value>& values ) { get()->build( values ); }
 
+    /// @brief Store the built kd-tree in a file, with a key identifying its content (e.g. a hash of the mesh)
+    /// Only implemented for type="flat"
+    void write( const std::string& path, const std::string& key ) const { get()->write( path, key ); }
+
+    /// @brief Use a kd-tree stored with write() and the same key, memory-mapped read-only, instead of building it
+    /// Only implemented for type="flat"
+    /// @return false if the file does not exist or does not match, in which case the kd-tree must be built
+    bool open( const std::string& path, const std::string& key ) { return get()->open( path, key ); }
+
     //--------------------------------------------------------------------------------------
     // Methods to access the KDTree
 
@@ -164,8 +187,48 @@ public:
         return get()->closestPointsWithinRadius( p, radius );
     }
 
+    //--------------------------------------------------------------------------------------
+    // Batched searches for arrays of n points (x,y,z) or (lon,lat), run in parallel with OpenMP by the "flat"
+    // implementation, and serially by the "eckit" implementation, whose searches are not thread-safe.
+    // Results are written without allocation to preallocated arrays in CSR format: the results of point i are
+    // payloads[offsets[i]:offsets[i+1]] and distances[offsets[i]:offsets[i+1]], sorted by shortest distance.
+
+    /// @brief Find closest point of each of n points; payloads and distances have size n
+    template <typename Point>
+    void closestPoint( size_t n, const Point points[], Payload payloads[], double distances[] ) const {
+        get()->closestPoint( n, points, payloads, distances );
+    }
+
+    /// @brief Find k closest points of each of n points; offsets has size n+1, payloads and distances size n*k
+    template <typename Point>
+    void closestPoints( size_t n, const Point points[], size_t k, size_t offsets[], Payload payloads[],
+                        double distances[] ) const {
+        get()->closestPoints( n, points, k, offsets, payloads, distances );
+    }
+
+    /// @brief Find the at most k closest points within a distance of given radius of each of n points;
+    /// offsets has size n+1, payloads and distances size n*k
+    template <typename Point>
+    void closestPointsWithinRadius( size_t n, const Point points[], double radius, size_t k, size_t offsets[],
+                                    Payload payloads[], double distances[] ) const {
+        get()->closestPointsWithinRadius( n, points, radius, k, offsets, payloads, distances );
+    }
+
     /// @brief Return geometry used to convert (lon,lat) to (x,y,z) coordinates
     const Geometry& geometry() const { return get()->geometry(); }
+
+private:
+    static Implementation* create( const Geometry& geometry, const eckit::Configuration& config ) {
+        std::string type = "eckit";
+        config.get( "type", type );
+        if ( type == "eckit" ) {
+            return new detail::KDTreeMemory<Payload, Point>( geometry );
+        }
+        if ( type == "flat" ) {
+            return new detail::KDTree_flat<Payload, Point>( geometry );
+        }
+        throw_Exception( "KDTree type \"" + type + "\" not recognised, expected \"eckit\" or \"flat\"", Here() );
+    }
 };
 
 //------------------------------------------------------------------------------------------------------
@@ -18,6 +18,7 @@
 #include "atlas/array.h"
 #include "atlas/domain/Domain.h"
 #include "atlas/field/Field.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/projection/Projection.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/util/CoordinateEnums.h"
@@ -231,6 +232,10 @@ template PolygonCoordinates::PolygonCoordinates( const std::vector<PointLonLat>&
 
 PolygonCoordinates::~PolygonCoordinates() = default;
 
+void PolygonCoordinates::contains( size_t n, const Point2 points[], bool inside[] ) const {
+    atlas_omp_parallel_for( size_t i = 0; i < n; ++i ) { inside[i] = contains( points[i] ); }
+}
+
 const Point2& PolygonCoordinates::coordinatesMax() const {
     return coordinatesMax_;
 }
@@ -176,6 +176,11 @@ public:
     /// @return if point is in polygon
     virtual bool contains( const Point2& P ) const = 0;
 
+    /// @brief Point-in-partition test of n points, in parallel
+    /// @param[in] points given points
+    /// @param[out] inside if points[i] is in polygon, for i in [0,n)
+    void contains( size_t n, const Point2 points[], bool inside[] ) const;
+
     const Point2& coordinatesMax() const;
     const Point2& coordinatesMin() const;
     const Point2& centroid() const;
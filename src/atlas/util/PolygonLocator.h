@@ -11,13 +11,22 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 #include "atlas/library/config.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/projection/Projection.h"
 #include "atlas/runtime/Exception.h"
-#include "atlas/util/KDTree.h"
+#include "atlas/util/CoordinateEnums.h"
+#include "atlas/util/Geometry.h"
+#include "atlas/util/Point.h"
 #include "atlas/util/Polygon.h"
 
 #ifdef POLYGONLOCATOR_DEBUGGING
@@ -32,17 +41,16 @@ namespace util {
 ///@brief Find polygon that contains a point
 ///
 /// Construction requires a list of polygons.
-/// The implementation makes use of a KDTree that holds centroids of all polygons.
-/// Once the nearest polygon-centroids (default=4) are found, the corresponding polygons are
-/// visited in order of shortest distance, to check if the point is contained within.
+/// The implementation buckets the polygons on a uniform grid over the (x,y) bounding box of all polygons:
+/// each bucket lists the polygons whose bounding box overlaps it. The candidate polygons of the bucket of
+/// a point are visited in order of shortest distance of their centroid, to check if the point is contained within.
 class PolygonLocator {
 public:
     /// @brief Construct PolygonLocator from shared_ptr of polygons
     PolygonLocator( const std::shared_ptr<const PolygonCoordinates::Vector> polygons,
                     const Projection& projection = Projection() ) :
         shared_polygons_( polygons ), polygons_( *shared_polygons_ ), projection_( projection ) {
-        k_ = std::min( k_, polygons_.size() );
-        buildKDTree();
+        buildBuckets();
     }
 
     /// @brief Construct PolygonLocator and move polygons inside.
@@ -50,75 +58,147 @@ public:
         shared_polygons_( std::make_shared<PolygonCoordinates::Vector>( std::move( polygons ) ) ),
         polygons_( *shared_polygons_ ),
         projection_( projection ) {
-        k_ = std::min( k_, polygons_.size() );
-        buildKDTree();
+        buildBuckets();
     }
 
     /// @brief Construct PolygonLocator using reference to polygons.
     /// !WARNING! polygons should not go out of scope before PolygonLocator
     PolygonLocator( const PolygonCoordinates::Vector& polygons, const Projection& projection = Projection() ) :
         polygons_( polygons ), projection_( projection ) {
-        k_ = std::min( k_, polygons_.size() );
-        buildKDTree();
+        buildBuckets();
     }
 
+    /// @brief find the polygons that hold the points (lon,lat), in parallel
     template <typename PointContainer, typename PolygonIndexContainer>
-    void operator()( const PointContainer& points, PolygonIndexContainer& index ) {
+    void operator()( const PointContainer& points, PolygonIndexContainer& index ) const {
         ATLAS_ASSERT( points.size() == index.size() );
-        typename PointContainer::const_iterator p     = points.begin();
-        typename PointContainer::const_iterator p_end = points.end();
-        typename PolygonIndexContainer::iterator i    = index.begin();
-        for ( ; p != p_end; ++p, ++i ) {
-            *i = this->operator()( *p );
+        const size_t size = points.size();
+        atlas_omp_parallel_for( size_t i = 0; i < size; ++i ) { index[i] = find( points[i] ); }
+        for ( size_t i = 0; i < size; ++i ) {
+            if ( index[i] < 0 ) {
+                throw_not_found( points[i] );
+            }
         }
     }
 
     /// @brief find the polygon that holds the point (lon,lat)
     idx_t operator()( const Point2& point ) const {
-        const auto found = kdtree_.closestPoints( point, k_ );
-        idx_t partition{-1};
-        for ( size_t i = 0; i < found.size(); ++i ) {
-            idx_t ii = found[i].payload();
+        const idx_t partition = find( point );
+        if ( partition < 0 ) {
+            throw_not_found( point );
+        }
+        return partition;
+    }
+
+private:
+    /// @return polygon that holds the point (lon,lat), or -1
+    idx_t find( const Point2& point ) const {
+        const Point2 xy = lonlat2xy( point );
+        const idx_t b   = bucket( xy );
+
+        // Candidates in order of shortest distance of their centroid; no allocation for typical bucket sizes
+        using Candidate = std::pair<double, idx_t>;
+        std::array<Candidate, 32> small;
+        std::vector<Candidate> large;
+        const idx_t nb_candidates = bucket_offsets_[b + 1] - bucket_offsets_[b];
+        if ( nb_candidates > static_cast<idx_t>( small.size() ) ) {
+            large.resize( nb_candidates );
+        }
+        Candidate* candidates = large.empty() ? small.data() : large.data();
+
+        const Point3 p = geometry_.xyz( point );
+        for ( idx_t c = 0; c < nb_candidates; ++c ) {
+            const idx_t ii = bucket_polygons_[bucket_offsets_[b] + c];
+            candidates[c]  = Candidate( Point3::distance2( p, centroids_[ii] ), ii );
+        }
+        std::sort( candidates, candidates + nb_candidates );
+
+        for ( idx_t c = 0; c < nb_candidates; ++c ) {
+            const idx_t ii = candidates[c].second;
 #ifdef POLYGONLOCATOR_DEBUGGING
-            Log::info() << "Search point " << lonlat2xy( point ) << " in polygon " << ii << ": ";
+            Log::info() << "Search point " << xy << " in polygon " << ii << ": ";
             polygons_[ii].print( Log::info() );
             Log::info() << " ... ";
 #endif
-            if ( polygons_[ii].contains( lonlat2xy( point ) ) ) {
-                partition = ii;
+            if ( polygons_[ii].contains( xy ) ) {
 #ifdef POLYGONLOCATOR_DEBUGGING
                 Log::info() << "FOUND" << std::endl;
 #endif
-                break;
+                return ii;
             }
 #ifdef POLYGONLOCATOR_DEBUGGING
             Log::info() << "NOT_FOUND" << std::endl;
 #endif
         }
-        if ( partition < 0 ) {
-            std::stringstream out;
-            out << "Could not find find point {lon,lat} = " << point << " in `k=" << k_ << "` \"nearest\" polygons [";
-            for ( size_t i = 0; i < found.size(); ++i ) {
-                if ( i > 0 ) {
-                    out << ", ";
-                }
-                out << found[i].payload();
+        return -1;
+    }
+
+    [[noreturn]] void throw_not_found( const Point2& point ) const {
+        const idx_t b = bucket( lonlat2xy( point ) );
+        std::stringstream out;
+        out << "Could not find find point {lon,lat} = " << point << " in candidate polygons [";
+        for ( idx_t c = bucket_offsets_[b]; c < bucket_offsets_[b + 1]; ++c ) {
+            if ( c > bucket_offsets_[b] ) {
+                out << ", ";
             }
-            out << "]. Increase `k`?";
-            throw_AssertionFailed( out.str(), Here() );
+            out << bucket_polygons_[c];
         }
-        return partition;
+        out << "]";
+        throw_AssertionFailed( out.str(), Here() );
     }
 
-private:
-    void buildKDTree() {
-        kdtree_.reserve( polygons_.size() );
-        for ( idx_t p = 0; p < polygons_.size(); ++p ) {
-            kdtree_.insert( xy2lonlat( polygons_[p].centroid() ), p );
+    void buildBuckets() {
+        const idx_t nb_polygons = polygons_.size();
+
+        // Uniform buckets over the bounding box of all polygons, about as many as there are polygons
+        min_ = Point2{std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+        max_ = Point2{std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+        centroids_.resize( nb_polygons );
+        for ( idx_t p = 0; p < nb_polygons; ++p ) {
+            min_          = Point2::componentsMin( min_, polygons_[p].coordinatesMin() );
+            max_          = Point2::componentsMax( max_, polygons_[p].coordinatesMax() );
+            centroids_[p] = geometry_.xyz( xy2lonlat( polygons_[p].centroid() ) );
+        }
+        const double dx = std::max( max_[XX] - min_[XX], std::numeric_limits<double>::epsilon() );
+        const double dy = std::max( max_[YY] - min_[YY], std::numeric_limits<double>::epsilon() );
+        const double nb = std::max<double>( nb_polygons, 1. );
+        const double nx = std::min( nb, std::round( std::sqrt( nb * dx / dy ) ) );
+        nx_             = std::max<idx_t>( 1, static_cast<idx_t>( nx ) );
+        ny_             = std::max<idx_t>( 1, static_cast<idx_t>( std::round( nb / nx_ ) ) );
+        inv_dx_         = nx_ / dx;
+        inv_dy_         = ny_ / dy;
+
+        // Polygons of each bucket, in CSR format
+        auto for_each_bucket = [&]( idx_t p, const std::function<void( idx_t )>& f ) {
+            const idx_t i0 = bucket_i( polygons_[p].coordinatesMin()[XX] );
+            const idx_t i1 = bucket_i( polygons_[p].coordinatesMax()[XX] );
+            const idx_t j0 = bucket_j( polygons_[p].coordinatesMin()[YY] );
+            const idx_t j1 = bucket_j( polygons_[p].coordinatesMax()[YY] );
+            for ( idx_t j = j0; j <= j1; ++j ) {
+                for ( idx_t i = i0; i <= i1; ++i ) {
+                    f( j * nx_ + i );
+                }
+            }
+        };
+        bucket_offsets_.assign( nx_ * ny_ + 1, 0 );
+        for ( idx_t p = 0; p < nb_polygons; ++p ) {
+            for_each_bucket( p, [&]( idx_t b ) { ++bucket_offsets_[b + 1]; } );
+        }
+        for ( idx_t b = 0; b < nx_ * ny_; ++b ) {
+            bucket_offsets_[b + 1] += bucket_offsets_[b];
+        }
+        bucket_polygons_.resize( bucket_offsets_.back() );
+        std::vector<idx_t> position( bucket_offsets_.begin(), bucket_offsets_.end() - 1 );
+        for ( idx_t p = 0; p < nb_polygons; ++p ) {
+            for_each_bucket( p, [&]( idx_t b ) { bucket_polygons_[position[b]++] = p; } );
         }
-        kdtree_.build();
     }
 
+    idx_t bucket_i( double x ) const { return clamp( ( x - min_[XX] ) * inv_dx_, nx_ ); }
+    idx_t bucket_j( double y ) const { return clamp( ( y - min_[YY] ) * inv_dy_, ny_ ); }
+    static idx_t clamp( double i, idx_t n ) { return i <= 0. ? 0 : i >= n - 1 ? n - 1 : static_cast<idx_t>( i ); }
+    idx_t bucket( const Point2& xy ) const { return bucket_j( xy[YY] ) * nx_ + bucket_i( xy[XX] ); }
+
     Point2 lonlat2xy( const Point2& lonlat ) const {
         Point2 xy{lonlat};
         projection_.lonlat2xy( xy.data() );
@@ -134,8 +214,17 @@ private:
     std::shared_ptr<const PolygonCoordinates::Vector> shared_polygons_;
     const PolygonCoordinates::Vector& polygons_;
     Projection projection_;
-    idx_t k_{4};
-    IndexKDTree kdtree_;
+    Geometry geometry_;
+    std::vector<Point3> centroids_;  // centroids (x,y,z), giving the order in which candidates are visited
+    Point2 min_;
+    Point2 max_;
+    idx_t nx_;
+    idx_t ny_;
+    double inv_dx_;
+    double inv_dy_;
+    // polygons overlapping bucket b: bucket_polygons_[bucket_offsets_[b]:bucket_offsets_[b+1]]
+    std::vector<idx_t> bucket_offsets_;
+    std::vector<idx_t> bucket_polygons_;
 };
 
 //------------------------------------------------------------------------------------------------------
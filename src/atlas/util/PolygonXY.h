@@ -36,6 +36,8 @@ public:
     /// @return if point (x,y) is in polygon
     bool contains( const Point2& Pxy ) const override;
 
+    using PolygonCoordinates::contains;
+
 private:
     PointLonLat centroid_;
     double inner_radius_squared_{0};
@@ -35,6 +35,8 @@ public:
    * @return if point is in polygon
    */
     bool contains( const Point2& lonlat ) const override;
+
+    using PolygonCoordinates::contains;
 };
 
 //------------------------------------------------------------------------------------------------------
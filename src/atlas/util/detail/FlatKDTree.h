@@ -0,0 +1,438 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "atlas/library/config.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Exception.h"
+#include "atlas/util/detail/MappedFile.h"
+
+namespace atlas {
+namespace util {
+namespace detail {
+
+//------------------------------------------------------------------------------------------------------
+
+/// @brief Static kd-tree, stored as contiguous arrays of points and payloads
+///
+/// The tree is implicit: the node of an index range [begin,end) is its middle element,
+/// with the left subtree in [begin,middle) and the right subtree in [middle+1,end).
+/// Only the split axis of each node is stored in addition to the points and payloads.
+///
+/// Values are added with insert() and the tree is then built once with build(), in parallel with OpenMP tasks
+/// for large trees. Searches do not modify the tree, and can be called concurrently from multiple threads.
+///
+/// A built tree can be stored with write() in a file that is later reopened with open() instead of building the
+/// tree again. The file is then memory-mapped read-only, so that processes using the same file share its pages.
+template <typename PayloadT, typename PointT>
+class FlatKDTree {
+public:
+    using Payload = PayloadT;
+    using Point   = PointT;
+
+    /// Search result: position of the value in the tree, and squared distance to the searched point
+    struct Neighbour {
+        size_t index;
+        double distance2;
+    };
+
+    /// Order of search results: by increasing distance, and values at the same distance by their position in the
+    /// tree, which is fixed by build(), so that equidistant values are always returned in the same order
+    static bool closer( const Neighbour& a, const Neighbour& b ) {
+        return a.distance2 < b.distance2 || ( a.distance2 == b.distance2 && a.index < b.index );
+    }
+
+    FlatKDTree() = default;
+
+    // Not copyable, as searches access the values through pointers into the storage
+    FlatKDTree( const FlatKDTree& ) = delete;
+    FlatKDTree& operator=( const FlatKDTree& ) = delete;
+
+    void reserve( size_t size ) {
+        points_.reserve( size );
+        payloads_.reserve( size );
+    }
+
+    /// @brief Add a value; build() must be called before searching
+    void insert( const Point& point, const Payload& payload ) {
+        ATLAS_ASSERT( not file_, "FlatKDTree opened from a file cannot be modified" );
+        points_.emplace_back( point );
+        payloads_.emplace_back( payload );
+        size_  = points_.size();
+        built_ = false;
+    }
+
+    /// @brief Arrange the inserted values as a balanced kd-tree
+    void build();
+
+    /// @brief Store the built tree in a file, together with a key identifying its content (e.g. a hash of the
+    /// inserted values), which open() compares
+    void write( const std::string& path, const std::string& key ) const;
+
+    /// @brief Replace this tree with the tree stored in a file by write(), memory-mapped read-only
+    /// @return false, leaving this tree unchanged, if the file does not exist, or was written for another key
+    /// or for other Point or Payload types
+    bool open( const std::string& path, const std::string& key );
+
+    size_t size() const { return size_; }
+
+    bool empty() const { return size_ == 0; }
+
+    /// @brief Access to the values; valid after build() or open()
+    const Point& point( size_t index ) const { return point_data_[index]; }
+
+    const Payload& payload( size_t index ) const { return payload_data_[index]; }
+
+    /// @brief Find the k closest values to p, sorted with closer()
+    /// The capacity of the result vector is reused, so that repeated searches do not allocate.
+    void closestPoints( const Point& p, size_t k, std::vector<Neighbour>& result ) const;
+
+    /// @brief Find the closest value to p, the first one with closer() if several are at the same distance
+    Neighbour closestPoint( const Point& p ) const;
+
+    /// @brief Find all values within radius of p, sorted with closer()
+    void closestPointsWithinRadius( const Point& p, double radius, std::vector<Neighbour>& result ) const;
+
+private:
+    struct Range {
+        size_t begin;
+        size_t end;
+        double bound;  // lower bound of the squared distance of p to any point in the range
+    };
+
+    /// Depth-first traversal stack; a balanced tree needs at most one entry per level
+    class Stack {
+    public:
+        void push( size_t begin, size_t end, double bound ) {
+            if ( begin < end ) {
+                ATLAS_ASSERT( size_ < max_size_ );
+                ranges_[size_++] = Range{begin, end, bound};
+            }
+        }
+        Range pop() { return ranges_[--size_]; }
+        bool empty() const { return size_ == 0; }
+
+    private:
+        static constexpr size_t max_size_ = 128;
+        std::array<Range, max_size_> ranges_;
+        size_t size_{0};
+    };
+
+    static double distance2( const Point& a, const Point& b ) {
+        double d2 = 0.;
+        for ( size_t d = 0; d < Point::DIMS; ++d ) {
+            const double dx = a[d] - b[d];
+            d2 += dx * dx;
+        }
+        return d2;
+    }
+
+    void build( std::vector<size_t>& order, size_t begin, size_t end );
+
+    /// Header of the file written by write()
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t dims;
+        std::uint64_t point_size;
+        std::uint64_t payload_size;
+        std::uint64_t size;
+        char key[128];
+    };
+
+    static FileHeader file_header( const std::string& key, size_t size );
+
+    static constexpr size_t file_alignment_ = 64;
+
+    /// Visit the nodes that may be closer to p than bound(), in order of likely proximity
+    template <typename Visitor>
+    void search( const Point& p, Visitor& visitor ) const;
+
+    /// Ranges smaller than this are built by a single thread
+    static constexpr size_t parallel_build_size_ = 1 << 15;
+
+    // Storage of a tree built in memory
+    std::vector<Point> points_;
+    std::vector<Payload> payloads_;
+    std::vector<std::uint8_t> axis_;
+
+    // Storage of a tree opened from a file
+    std::unique_ptr<MappedFile> file_;
+
+    // Values in either storage, as accessed by the searches
+    const Point* point_data_{nullptr};
+    const Payload* payload_data_{nullptr};
+    const std::uint8_t* axis_data_{nullptr};
+    size_t size_{0};
+    bool built_{true};
+};
+
+//------------------------------------------------------------------------------------------------------
+
+template <typename PayloadT, typename PointT>
+void FlatKDTree<PayloadT, PointT>::build() {
+    ATLAS_ASSERT( not file_, "FlatKDTree opened from a file cannot be modified" );
+    const size_t n = size();
+    std::vector<size_t> order( n );
+    std::iota( order.begin(), order.end(), 0 );
+    axis_.assign( n, 0 );
+#if ATLAS_HAVE_OMP
+    if ( atlas_omp_get_max_threads() > 1 && n >= parallel_build_size_ ) {
+#pragma omp parallel
+#pragma omp single
+        build( order, 0, n );
+    }
+    else {
+        build( order, 0, n );
+    }
+#else
+    build( order, 0, n );
+#endif
+
+    std::vector<Point> points( n );
+    std::vector<Payload> payloads( n );
+    atlas_omp_parallel_for( size_t i = 0; i < n; ++i ) {
+        points[i]   = points_[order[i]];
+        payloads[i] = payloads_[order[i]];
+    }
+    points_.swap( points );
+    payloads_.swap( payloads );
+    point_data_   = points_.data();
+    payload_data_ = payloads_.data();
+    axis_data_    = axis_.data();
+    built_        = true;
+}
+
+template <typename PayloadT, typename PointT>
+typename FlatKDTree<PayloadT, PointT>::FileHeader FlatKDTree<PayloadT, PointT>::file_header( const std::string& key,
+                                                                                            size_t size ) {
+    static_assert( std::is_trivially_copyable<Point>::value && std::is_trivially_copyable<Payload>::value,
+                   "FlatKDTree files require trivially copyable Point and Payload types" );
+    FileHeader header;
+    std::memset( &header, 0, sizeof( header ) );
+    std::memcpy( header.magic, "atlaskdt", sizeof( header.magic ) );
+    header.version      = 1;
+    header.dims         = Point::DIMS;
+    header.point_size   = sizeof( Point );
+    header.payload_size = sizeof( Payload );
+    header.size         = size;
+    ATLAS_ASSERT( key.size() < sizeof( header.key ), "FlatKDTree file key is too long" );
+    std::memcpy( header.key, key.data(), key.size() );
+    return header;
+}
+
+template <typename PayloadT, typename PointT>
+void FlatKDTree<PayloadT, PointT>::write( const std::string& path, const std::string& key ) const {
+    ATLAS_ASSERT( built_, "FlatKDTree::build() must be called before write()" );
+    const FileHeader header = file_header( key, size() );
+    MappedFile::write( path,
+                       {{&header, sizeof( header )},
+                        {point_data_, size() * sizeof( Point )},
+                        {payload_data_, size() * sizeof( Payload )},
+                        {axis_data_, size() * sizeof( std::uint8_t )}},
+                       file_alignment_ );
+}
+
+template <typename PayloadT, typename PointT>
+bool FlatKDTree<PayloadT, PointT>::open( const std::string& path, const std::string& key ) {
+    if ( not MappedFile::exists( path ) ) {
+        return false;
+    }
+    std::unique_ptr<MappedFile> file( new MappedFile( path ) );
+    if ( file->size() < sizeof( FileHeader ) ) {
+        return false;
+    }
+    FileHeader header;
+    std::memcpy( &header, file->data(), sizeof( header ) );
+    const size_t n = header.size;
+    const FileHeader expected = file_header( key, n );
+    if ( std::memcmp( &header, &expected, sizeof( header ) ) != 0 ) {
+        return false;
+    }
+
+    const size_t points_offset   = MappedFile::align( sizeof( FileHeader ), file_alignment_ );
+    const size_t payloads_offset = MappedFile::align( points_offset + n * sizeof( Point ), file_alignment_ );
+    const size_t axis_offset     = MappedFile::align( payloads_offset + n * sizeof( Payload ), file_alignment_ );
+    if ( file->size() < axis_offset + n * sizeof( std::uint8_t ) ) {
+        return false;
+    }
+
+    std::vector<Point>().swap( points_ );
+    std::vector<Payload>().swap( payloads_ );
+    std::vector<std::uint8_t>().swap( axis_ );
+    point_data_   = reinterpret_cast<const Point*>( file->data() + points_offset );
+    payload_data_ = reinterpret_cast<const Payload*>( file->data() + payloads_offset );
+    axis_data_    = reinterpret_cast<const std::uint8_t*>( file->data() + axis_offset );
+    size_         = n;
+    built_        = true;
+    file_         = std::move( file );
+    return true;
+}
+
+template <typename PayloadT, typename PointT>
+void FlatKDTree<PayloadT, PointT>::build( std::vector<size_t>& order, size_t begin, size_t end ) {
+    if ( end - begin < 2 ) {
+        return;
+    }
+
+    // Split along the axis of largest extent
+    std::array<double, Point::DIMS> min, max;
+    for ( size_t d = 0; d < Point::DIMS; ++d ) {
+        min[d] = max[d] = points_[order[begin]][d];
+    }
+    for ( size_t i = begin + 1; i < end; ++i ) {
+        const Point& p = points_[order[i]];
+        for ( size_t d = 0; d < Point::DIMS; ++d ) {
+            min[d] = std::min( min[d], p[d] );
+            max[d] = std::max( max[d], p[d] );
+        }
+    }
+    size_t axis = 0;
+    for ( size_t d = 1; d < Point::DIMS; ++d ) {
+        if ( max[d] - min[d] > max[axis] - min[axis] ) {
+            axis = d;
+        }
+    }
+
+    const size_t middle = begin + ( end - begin ) / 2;
+    std::nth_element( order.begin() + begin, order.begin() + middle, order.begin() + end,
+                      [&]( size_t a, size_t b ) { return points_[a][axis] < points_[b][axis]; } );
+    axis_[middle] = static_cast<std::uint8_t>( axis );
+
+    // Both subtrees are independent ranges of order and axis_
+#if ATLAS_HAVE_OMP
+    if ( end - begin >= parallel_build_size_ ) {
+#pragma omp task shared( order )
+        build( order, begin, middle );
+#pragma omp task shared( order )
+        build( order, middle + 1, end );
+#pragma omp taskwait
+        return;
+    }
+#endif
+    build( order, begin, middle );
+    build( order, middle + 1, end );
+}
+
+template <typename PayloadT, typename PointT>
+template <typename Visitor>
+void FlatKDTree<PayloadT, PointT>::search( const Point& p, Visitor& visitor ) const {
+    ATLAS_ASSERT( built_, "FlatKDTree::build() must be called before searching" );
+    Stack stack;
+    stack.push( 0, size(), 0. );
+    while ( not stack.empty() ) {
+        const Range range = stack.pop();
+        if ( range.bound > visitor.bound() ) {
+            continue;
+        }
+        const size_t middle = range.begin + ( range.end - range.begin ) / 2;
+        visitor.visit( middle, distance2( p, point_data_[middle] ) );
+
+        const size_t axis = axis_data_[middle];
+        const double dx   = p[axis] - point_data_[middle][axis];
+        // Push the far side first, so that the near side is searched first
+        if ( dx < 0. ) {
+            stack.push( middle + 1, range.end, dx * dx );
+            stack.push( range.begin, middle, range.bound );
+        }
+        else {
+            stack.push( range.begin, middle, dx * dx );
+            stack.push( middle + 1, range.end, range.bound );
+        }
+    }
+}
+
+template <typename PayloadT, typename PointT>
+void FlatKDTree<PayloadT, PointT>::closestPoints( const Point& p, size_t k, std::vector<Neighbour>& result ) const {
+    result.clear();
+    k = std::min( k, size() );
+    if ( k == 0 ) {
+        return;
+    }
+    // result is kept as a max-heap on distance while searching
+    struct Visitor {
+        std::vector<Neighbour>& heap;
+        size_t k;
+        double worst;
+        double bound() const { return worst; }
+        void visit( size_t index, double d2 ) {
+            if ( heap.size() < k ) {
+                heap.push_back( Neighbour{index, d2} );
+                std::push_heap( heap.begin(), heap.end(), closer );
+                if ( heap.size() == k ) {
+                    worst = heap.front().distance2;
+                }
+            }
+            else if ( closer( Neighbour{index, d2}, heap.front() ) ) {
+                std::pop_heap( heap.begin(), heap.end(), closer );
+                heap.back() = Neighbour{index, d2};
+                std::push_heap( heap.begin(), heap.end(), closer );
+                worst = heap.front().distance2;
+            }
+        }
+    } visitor{result, k, std::numeric_limits<double>::max()};
+    search( p, visitor );
+    std::sort_heap( result.begin(), result.end(), closer );
+}
+
+template <typename PayloadT, typename PointT>
+typename FlatKDTree<PayloadT, PointT>::Neighbour FlatKDTree<PayloadT, PointT>::closestPoint( const Point& p ) const {
+    ATLAS_ASSERT( not empty() );
+    struct Visitor {
+        Neighbour nearest;
+        double bound() const { return nearest.distance2; }
+        void visit( size_t index, double d2 ) {
+            if ( closer( Neighbour{index, d2}, nearest ) ) {
+                nearest = Neighbour{index, d2};
+            }
+        }
+    } visitor{Neighbour{0, std::numeric_limits<double>::max()}};
+    search( p, visitor );
+    return visitor.nearest;
+}
+
+template <typename PayloadT, typename PointT>
+void FlatKDTree<PayloadT, PointT>::closestPointsWithinRadius( const Point& p, double radius,
+                                                              std::vector<Neighbour>& result ) const {
+    result.clear();
+    if ( empty() ) {
+        return;
+    }
+    struct Visitor {
+        std::vector<Neighbour>& list;
+        double radius2;
+        double bound() const { return radius2; }
+        void visit( size_t index, double d2 ) {
+            if ( d2 <= radius2 ) {
+                list.push_back( Neighbour{index, d2} );
+            }
+        }
+    } visitor{result, radius * radius};
+    search( p, visitor );
+    std::sort( result.begin(), result.end(), closer );
+}
+
+//------------------------------------------------------------------------------------------------------
+
+}  // namespace detail
+}  // namespace util
+}  // namespace atlas
@@ -10,17 +10,23 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <iosfwd>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "eckit/container/KDTree.h"
 
 #include "atlas/library/config.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/util/Geometry.h"
 #include "atlas/util/Object.h"
 #include "atlas/util/Point.h"
+#include "atlas/util/detail/FlatKDTree.h"
 
 namespace atlas {
 namespace util {
@@ -73,6 +79,7 @@ public:
     class ValueList : public std::vector<Value> {
     public:
         using std::vector<Value>::vector;
+        ValueList() = default;
         PayloadList payloads() const {
             PayloadList list;
             list.reserve( this->size() );
@@ -140,6 +147,13 @@ public:
     /// @brief Build the kd-tree in one shot
     virtual void build( std::vector<Value>& values ) = 0;
 
+    /// @brief Store the built kd-tree in a file, with a key identifying its content, to be reopened with open()
+    virtual void write( const std::string& /*path*/, const std::string& /*key*/ ) const { ATLAS_NOTIMPLEMENTED; }
+
+    /// @brief Replace the kd-tree with one stored by write() with the same key, memory-mapped read-only
+    /// @return false if there is no such file, in which case the kd-tree needs to be built
+    virtual bool open( const std::string& /*path*/, const std::string& /*key*/ ) { ATLAS_NOTIMPLEMENTED; }
+
     /// @brief Build with spherical points (lon,lat) where longitudes, latitudes, and payloads are separate containers.
     /// Memory will be reserved with reserve() to match the size
     template <typename Longitudes, typename Latitudes, typename Payloads>
@@ -209,6 +223,43 @@ public:
         return do_closestPointsWithinRadius( p, radius );
     }
 
+    //--------------------------------------------------------------------------------------
+    // Batched searches, for arrays of n points (x,y,z) or (lon,lat). These run in parallel with OpenMP if the
+    // implementation supports concurrent searches (type "flat"), and serially otherwise (type "eckit").
+    // Results are written to preallocated arrays in CSR format: the results of point i are stored in
+    // payloads[offsets[i]:offsets[i+1]] and distances[offsets[i]:offsets[i+1]], sorted by shortest distance.
+
+    /// @brief Find the nearest neighbour of each of n points
+    /// @param payloads, distances  arrays of size n
+    template <typename Point>
+    void closestPoint( size_t n, const Point points[], Payload payloads[], double distances[] ) const {
+        std::vector<typename KDTreeTraits::Point> xyz;
+        do_closestPoint( n, make_Points( n, points, xyz ), payloads, distances );
+    }
+
+    /// @brief Find the k nearest neighbours of each of n points
+    /// @param offsets              array of size n+1
+    /// @param payloads, distances  arrays of size n*k
+    template <typename Point>
+    void closestPoints( size_t n, const Point points[], size_t k, size_t offsets[], Payload payloads[],
+                        double distances[] ) const {
+        std::vector<typename KDTreeTraits::Point> xyz;
+        do_closestPoints( n, make_Points( n, points, xyz ), k, offsets + 1, payloads, distances );
+        compress( n, k, offsets, payloads, distances );
+    }
+
+    /// @brief Find, for each of n points, the points within a distance of given radius, keeping at most the
+    /// k closest ones
+    /// @param offsets              array of size n+1
+    /// @param payloads, distances  arrays of size n*k
+    template <typename Point>
+    void closestPointsWithinRadius( size_t n, const Point points[], double radius, size_t k, size_t offsets[],
+                                    Payload payloads[], double distances[] ) const {
+        std::vector<typename KDTreeTraits::Point> xyz;
+        do_closestPointsWithinRadius( n, make_Points( n, points, xyz ), radius, k, offsets + 1, payloads, distances );
+        compress( n, k, offsets, payloads, distances );
+    }
+
 private:
     /// @brief Insert spherical point (lon,lat)
     /// If memory has been reserved with reserve(), insertion will be delayed until build() is called.
@@ -232,6 +283,46 @@ private:
     virtual ValueList do_closestPointsWithinRadius( const Point&, double radius ) const = 0;
 
 
+    /// @brief Find the nearest neighbour of each of n points (x,y,z), see closestPoint()
+    virtual void do_closestPoint( size_t n, const Point points[], Payload payloads[], double distances[] ) const = 0;
+
+    /// @brief Find the k nearest neighbours of each of n points (x,y,z), see closestPoints()
+    /// The results of point i are stored from position i*k, and their number in counts[i]
+    virtual void do_closestPoints( size_t n, const Point points[], size_t k, size_t counts[], Payload payloads[],
+                                   double distances[] ) const = 0;
+
+    /// @brief Find the at most k nearest points within radius of each of n points (x,y,z), see
+    /// closestPointsWithinRadius(). The results of point i are stored from position i*k, and their number in counts[i]
+    virtual void do_closestPointsWithinRadius( size_t n, const Point points[], double radius, size_t k, size_t counts[],
+                                               Payload payloads[], double distances[] ) const = 0;
+
+    /// @brief Pack the results of point i, stored from position i*k, behind those of point i-1.
+    /// On input offsets[i+1] holds the number of results of point i, on output the CSR offsets.
+    static void compress( size_t n, size_t k, size_t offsets[], Payload payloads[], double distances[] ) {
+        offsets[0] = 0;
+        for ( size_t i = 0; i < n; ++i ) {
+            const size_t count = offsets[i + 1];
+            const size_t from = i * k;
+            const size_t to   = offsets[i];
+            if ( to != from ) {
+                std::copy( payloads + from, payloads + from + count, payloads + to );
+                std::copy( distances + from, distances + from + count, distances + to );
+            }
+            offsets[i + 1] = offsets[i] + count;
+        }
+    }
+
+    /// @brief Points (x,y,z) are searched as given
+    const Point* make_Points( size_t, const Point points[], std::vector<Point>& ) const { return points; }
+
+    /// @brief Points (lon,lat) are converted to (x,y,z) once for the whole batch
+    template <typename LonLat, ENABLE_IF_3D_AND_IS_LONLAT( LonLat )>
+    const Point* make_Points( size_t n, const LonLat points[], std::vector<Point>& xyz ) const {
+        xyz.resize( n );
+        atlas_omp_parallel_for( size_t i = 0; i < n; ++i ) { xyz[i] = make_Point( points[i] ); }
+        return xyz.data();
+    }
+
     /// @brief Find k nearest neighbour given a 2D lonlat point (lon,lat)
     template <typename LonLat, ENABLE_IF_3D_AND_IS_LONLAT( LonLat )>
     ValueList do_closestPoints( const LonLat& p, size_t k ) const {
@@ -323,11 +414,33 @@ public:
     /// @brief Find all points within a distance of given radius from a given point (x,y,z)
     ValueList do_closestPointsWithinRadius( const Point&, double radius ) const override;
 
+    /// @brief Find the nearest neighbour of each of n points (x,y,z)
+    void do_closestPoint( size_t n, const Point points[], Payload payloads[], double distances[] ) const override;
+
+    /// @brief Find the k nearest neighbours of each of n points (x,y,z)
+    void do_closestPoints( size_t n, const Point points[], size_t k, size_t counts[], Payload payloads[],
+                           double distances[] ) const override;
+
+    /// @brief Find the at most k nearest points within radius of each of n points (x,y,z)
+    void do_closestPointsWithinRadius( size_t n, const Point points[], double radius, size_t k, size_t counts[],
+                                       Payload payloads[], double distances[] ) const override;
+
     const Tree& tree() const { return *tree_; }
 
 private:
     void assert_built() const;
 
+    /// Copy the at most k first nodes of list, return their number
+    template <typename NodeList>
+    static size_t copy( const NodeList& list, size_t k, Payload payloads[], double distances[] ) {
+        const size_t count = std::min( list.size(), k );
+        for ( size_t j = 0; j < count; ++j ) {
+            payloads[j]  = list[j].payload();
+            distances[j] = list[j].distance();
+        }
+        return count;
+    }
+
     static void static_asserts() {
         static_assert( std::is_convertible<typename Tree::Payload, Payload>::value,
                        "Tree::Payload must be convertible this Payload type" );
@@ -399,6 +512,42 @@ KDTree_eckit<TreeT, PayloadT, PointT>::do_closestPointsWithinRadius( const Point
     return tree_->findInSphere( p, radius );
 }
 
+// The eckit kd-tree searches update statistics shared by all searches, and are not thread-safe.
+// The batched searches of this implementation therefore run serially; the "flat" implementation runs them in
+// parallel.
+
+template <typename TreeT, typename PayloadT, typename PointT>
+void KDTree_eckit<TreeT, PayloadT, PointT>::do_closestPoint( size_t n, const Point points[], Payload payloads[],
+                                                             double distances[] ) const {
+    assert_built();
+    for ( size_t i = 0; i < n; ++i ) {
+        const auto nearest = tree_->nearestNeighbour( points[i] );
+        payloads[i]        = nearest.payload();
+        distances[i]       = nearest.distance();
+    }
+}
+
+template <typename TreeT, typename PayloadT, typename PointT>
+void KDTree_eckit<TreeT, PayloadT, PointT>::do_closestPoints( size_t n, const Point points[], size_t k,
+                                                              size_t counts[], Payload payloads[],
+                                                              double distances[] ) const {
+    assert_built();
+    for ( size_t i = 0; i < n; ++i ) {
+        counts[i] = copy( tree_->kNearestNeighbours( points[i], k ), k, payloads + i * k, distances + i * k );
+    }
+}
+
+template <typename TreeT, typename PayloadT, typename PointT>
+void KDTree_eckit<TreeT, PayloadT, PointT>::do_closestPointsWithinRadius( size_t n, const Point points[],
+                                                                          double radius, size_t k, size_t counts[],
+                                                                          Payload payloads[],
+                                                                          double distances[] ) const {
+    assert_built();
+    for ( size_t i = 0; i < n; ++i ) {
+        counts[i] = copy( tree_->findInSphere( points[i], radius ), k, payloads + i * k, distances + i * k );
+    }
+}
+
 template <typename TreeT, typename PayloadT, typename PointT>
 void KDTree_eckit<TreeT, PayloadT, PointT>::assert_built() const {
     if ( tmp_.capacity() ) {
@@ -406,6 +555,135 @@ void KDTree_eckit<TreeT, PayloadT, PointT>::assert_built() const {
     }
 }
 
+//------------------------------------------------------------------------------------------------------
+// Concrete implementation with a flat tree stored in contiguous arrays
+
+template <typename PayloadT, typename PointT>
+class KDTree_flat : public KDTreeBase<PayloadT, PointT> {
+    using Tree      = FlatKDTree<PayloadT, PointT>;
+    using Base      = KDTreeBase<PayloadT, PointT>;
+    using Neighbour = typename Tree::Neighbour;
+
+public:
+    using Point       = typename Base::Point;
+    using Payload     = typename Base::Payload;
+    using PayloadList = typename Base::PayloadList;
+    using Value       = typename Base::Value;
+    using ValueList   = typename Base::ValueList;
+
+    using Base::build;
+    using Base::closestPoint;
+    using Base::closestPoints;
+    using Base::closestPointsWithinRadius;
+    using Base::insert;
+    using Base::reserve;
+
+public:
+    KDTree_flat() = default;
+
+    KDTree_flat( const Geometry& geometry ) : Base( geometry ) {}
+
+    void reserve( idx_t size ) override { tree_.reserve( size ); }
+
+    /// @brief Build the tree; unlike the eckit implementation, this is always required after insertions
+    void build() override { tree_.build(); }
+
+    void build( std::vector<Value>& values ) override {
+        tree_.reserve( values.size() );
+        for ( const auto& value : values ) {
+            tree_.insert( value.point(), value.payload() );
+        }
+        tree_.build();
+    }
+
+    void insert( const Value& value ) override { tree_.insert( value.point(), value.payload() ); }
+
+    void write( const std::string& path, const std::string& key ) const override { tree_.write( path, key ); }
+
+    bool open( const std::string& path, const std::string& key ) override { return tree_.open( path, key ); }
+
+    /// @brief Find k nearest neighbours given a 3D cartesian point (x,y,z)
+    ValueList do_closestPoints( const Point& p, size_t k ) const override {
+        std::vector<Neighbour> neighbours;
+        tree_.closestPoints( p, k, neighbours );
+        return values( neighbours );
+    }
+
+    /// @brief Find nearest neighbour given a 3D cartesian point (x,y,z)
+    Value do_closestPoint( const Point& p ) const override { return value( tree_.closestPoint( p ) ); }
+
+    /// @brief Find all points within a distance of given radius from a given point (x,y,z)
+    ValueList do_closestPointsWithinRadius( const Point& p, double radius ) const override {
+        std::vector<Neighbour> neighbours;
+        tree_.closestPointsWithinRadius( p, radius, neighbours );
+        return values( neighbours );
+    }
+
+    /// @brief Find the nearest neighbour of each of n points (x,y,z)
+    void do_closestPoint( size_t n, const Point points[], Payload payloads[], double distances[] ) const override {
+        atlas_omp_parallel_for( size_t i = 0; i < n; ++i ) {
+            const Neighbour nearest = tree_.closestPoint( points[i] );
+            payloads[i]             = tree_.payload( nearest.index );
+            distances[i]            = std::sqrt( nearest.distance2 );
+        }
+    }
+
+    /// @brief Find the k nearest neighbours of each of n points (x,y,z)
+    void do_closestPoints( size_t n, const Point points[], size_t k, size_t counts[], Payload payloads[],
+                           double distances[] ) const override {
+        atlas_omp_parallel {
+            std::vector<Neighbour> neighbours;  // reused by all searches of a thread
+            neighbours.reserve( k );
+            atlas_omp_for( size_t i = 0; i < n; ++i ) {
+                tree_.closestPoints( points[i], k, neighbours );
+                counts[i] = copy( neighbours, k, payloads + i * k, distances + i * k );
+            }
+        }
+    }
+
+    /// @brief Find the at most k nearest points within radius of each of n points (x,y,z)
+    void do_closestPointsWithinRadius( size_t n, const Point points[], double radius, size_t k, size_t counts[],
+                                       Payload payloads[], double distances[] ) const override {
+        atlas_omp_parallel {
+            std::vector<Neighbour> neighbours;  // reused by all searches of a thread
+            atlas_omp_for( size_t i = 0; i < n; ++i ) {
+                tree_.closestPointsWithinRadius( points[i], radius, neighbours );
+                counts[i] = copy( neighbours, k, payloads + i * k, distances + i * k );
+            }
+        }
+    }
+
+    const Tree& tree() const { return tree_; }
+
+private:
+    Value value( const Neighbour& neighbour ) const {
+        return Value( tree_.point( neighbour.index ), tree_.payload( neighbour.index ),
+                      std::sqrt( neighbour.distance2 ) );
+    }
+
+    ValueList values( const std::vector<Neighbour>& neighbours ) const {
+        ValueList list;
+        list.reserve( neighbours.size() );
+        for ( const auto& neighbour : neighbours ) {
+            list.emplace_back( value( neighbour ) );
+        }
+        return list;
+    }
+
+    /// Copy the at most k first neighbours, return their number
+    size_t copy( const std::vector<Neighbour>& neighbours, size_t k, Payload payloads[], double distances[] ) const {
+        const size_t count = std::min( neighbours.size(), k );
+        for ( size_t j = 0; j < count; ++j ) {
+            payloads[j]  = tree_.payload( neighbours[j].index );
+            distances[j] = std::sqrt( neighbours[j].distance2 );
+        }
+        return count;
+    }
+
+private:
+    Tree tree_;
+};
+
 //------------------------------------------------------------------------------------------------------
 
 }  // namespace detail
@@ -0,0 +1,95 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/util/detail/MappedFile.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace util {
+namespace detail {
+
+//------------------------------------------------------------------------------------------------------
+
+MappedFile::MappedFile( const std::string& path ) {
+    int fd = ::open( path.c_str(), O_RDONLY );
+    if ( fd < 0 ) {
+        throw_CantOpenFile( path, Here() );
+    }
+    struct stat st;
+    if ( ::fstat( fd, &st ) != 0 ) {
+        ::close( fd );
+        throw_CantOpenFile( path, Here() );
+    }
+    size_ = static_cast<size_t>( st.st_size );
+    if ( size_ ) {
+        void* address = ::mmap( nullptr, size_, PROT_READ, MAP_SHARED, fd, 0 );
+        if ( address == MAP_FAILED ) {
+            ::close( fd );
+            throw_Exception( "Could not map file " + path + ": " + std::strerror( errno ), Here() );
+        }
+        data_ = static_cast<const char*>( address );
+    }
+    // The mapping stays valid after closing the file descriptor
+    ::close( fd );
+}
+
+MappedFile::~MappedFile() {
+    if ( data_ ) {
+        ::munmap( const_cast<char*>( data_ ), size_ );
+    }
+}
+
+bool MappedFile::exists( const std::string& path ) {
+    struct stat st;
+    return ::stat( path.c_str(), &st ) == 0;
+}
+
+void MappedFile::write( const std::string& path, const std::vector<Block>& blocks, size_t alignment ) {
+    const std::string tmp = path + ".tmp." + std::to_string( ::getpid() );
+    {
+        std::ofstream file( tmp, std::ios::binary | std::ios::trunc );
+        if ( not file ) {
+            throw_CantOpenFile( tmp, Here() );
+        }
+        const std::vector<char> padding( alignment, 0 );
+        size_t offset = 0;
+        for ( const auto& block : blocks ) {
+            const size_t begin = align( offset, alignment );
+            file.write( padding.data(), begin - offset );
+            file.write( static_cast<const char*>( block.data ), block.size );
+            offset = begin + block.size;
+        }
+        if ( not file ) {
+            std::remove( tmp.c_str() );
+            throw_Exception( "Could not write file " + tmp, Here() );
+        }
+    }
+    if ( std::rename( tmp.c_str(), path.c_str() ) != 0 ) {
+        std::remove( tmp.c_str() );
+        throw_Exception( "Could not rename " + tmp + " to " + path + ": " + std::strerror( errno ), Here() );
+    }
+}
+
+//------------------------------------------------------------------------------------------------------
+
+}  // namespace detail
+}  // namespace util
+}  // namespace atlas
@@ -0,0 +1,68 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace atlas {
+namespace util {
+namespace detail {
+
+//------------------------------------------------------------------------------------------------------
+
+/// @brief Read-only memory mapping of a whole file
+///
+/// The mapping is shared, so that processes mapping the same file on a node share its pages.
+class MappedFile {
+public:
+    /// A contiguous range of bytes to write
+    struct Block {
+        const void* data;
+        size_t size;
+    };
+
+    /// @brief Map the file at path; throws if it cannot be opened
+    MappedFile( const std::string& path );
+
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+    ~MappedFile();
+
+    const char* data() const { return data_; }
+
+    size_t size() const { return size_; }
+
+    /// @brief True if a file exists at path
+    static bool exists( const std::string& path );
+
+    /// @brief Write the blocks one after the other to the file at path, each starting at a multiple of alignment.
+    /// The file is written under a temporary name and then renamed, so that other processes mapping the same path
+    /// never see a partially written file.
+    static void write( const std::string& path, const std::vector<Block>& blocks, size_t alignment );
+
+    /// @brief Offset of the next multiple of alignment
+    static size_t align( size_t offset, size_t alignment ) {
+        return ( ( offset + alignment - 1 ) / alignment ) * alignment;
+    }
+
+private:
+    const char* data_{nullptr};
+    size_t size_{0};
+};
+
+//------------------------------------------------------------------------------------------------------
+
+}  // namespace detail
+}  // namespace util
+}  // namespace atlas
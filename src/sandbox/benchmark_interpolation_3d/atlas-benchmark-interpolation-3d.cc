@@ -0,0 +1,170 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+// Benchmark of the matrix-free 3D structured interpolation of many fields at semi-Lagrangian departure points:
+// fields interpolated one by one, or fused with stencils and weights computed once per departure point
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "atlas/array.h"
+#include "atlas/field/Field.h"
+#include "atlas/field/FieldSet.h"
+#include "atlas/functionspace/StructuredColumns.h"
+#include "atlas/grid.h"
+#include "atlas/grid/Vertical.h"
+#include "atlas/interpolation.h"
+#include "atlas/option.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/AtlasTool.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/Config.h"
+#include "atlas/util/CoordinateEnums.h"
+
+//------------------------------------------------------------------------------
+
+using namespace atlas;
+using atlas::functionspace::StructuredColumns;
+using atlas::util::Config;
+
+//------------------------------------------------------------------------------
+
+class Tool : public AtlasTool {
+    int execute( const Args& args ) override;
+    std::string briefDescription() override {
+        return "Benchmark the matrix-free 3D interpolation of many fields at departure points";
+    }
+    std::string usage() override { return name() + " [--grid=name] [OPTION]... [--help]"; }
+
+public:
+    Tool( int argc, char** argv );
+};
+
+//-----------------------------------------------------------------------------
+
+Tool::Tool( int argc, char** argv ) : AtlasTool( argc, argv ) {
+    add_option( new SimpleOption<std::string>( "grid", "Grid (default=O48)" ) );
+    add_option( new SimpleOption<long>( "levels", "Number of levels (default=137)" ) );
+    add_option( new SimpleOption<long>( "fields", "Number of fields (default=10)" ) );
+    add_option( new SimpleOption<bool>( "packed", "Pack the fields as variables of a single rank-3 field" ) );
+    add_option( new SimpleOption<long>( "iterations", "Number of interpolations per method (default=5)" ) );
+}
+
+//-----------------------------------------------------------------------------
+
+int Tool::execute( const Args& args ) {
+    if ( mpi::size() > 1 ) {
+        Log::error() << "This benchmark runs on a single MPI task" << std::endl;
+        return failed();
+    }
+
+    const std::string gridname = args.getString( "grid", "O48" );
+    const idx_t nlev           = args.getLong( "levels", 137 );
+    const idx_t nfields        = args.getLong( "fields", 10 );
+    const bool packed          = args.getBool( "packed", false );
+    const long iterations      = args.getLong( "iterations", 5 );
+
+    Log::info() << "Configuration" << std::endl;
+    Log::info() << "~~~~~~~~~~~~~" << std::endl;
+    Log::info() << "  Grid       : " << gridname << std::endl;
+    Log::info() << "  Levels     : " << nlev << std::endl;
+    Log::info() << "  Fields     : " << nfields << ( packed ? " (packed)" : "" ) << std::endl;
+    Log::info() << "  Iterations : " << iterations << std::endl;
+    Log::info() << "  OpenMP     : " << atlas_omp_get_max_threads() << std::endl;
+
+    std::vector<double> z( nlev );
+    for ( idx_t k = 0; k < nlev; ++k ) {
+        z[k] = ( k + 0.5 ) / nlev;
+    }
+    StructuredColumns fs( Grid( gridname ), Vertical( nlev, z ), option::halo( 2 ) );
+
+    // Departure points: grid points displaced by a smooth wind, halo points unused
+    Field departure_points = fs.createField<double>( option::variables( 3 ) );
+    {
+        auto xy = array::make_view<double, 2>( fs.xy() );
+        auto dp = array::make_view<double, 3>( departure_points );
+        for ( idx_t n = 0; n < dp.shape( 0 ); ++n ) {
+            const idx_t m = n < fs.sizeOwned() ? n : 0;
+            for ( idx_t k = 0; k < nlev; ++k ) {
+                dp( n, k, LON ) = xy( m, XX ) + 0.5 * std::sin( 0.01 * m + 0.1 * k );
+                dp( n, k, LAT ) = std::max( -90., std::min( 90., xy( m, YY ) + 0.5 * std::cos( 0.02 * m ) ) );
+                dp( n, k, ZZ )  = std::max( 0., std::min( 1., z[k] + 0.2 / nlev * std::sin( 0.03 * m + k ) ) );
+            }
+        }
+    }
+
+    FieldSet src;
+    FieldSet tgt;
+    for ( idx_t i = 0; i < ( packed ? 1 : nfields ); ++i ) {
+        const Config config = option::name( "f" + std::to_string( i ) ) | option::variables( packed ? nfields : 0 );
+        Field field         = src.add( fs.createField<double>( config ) );
+        tgt.add( fs.createField<double>( config ) );
+        double* values = field.array().data<double>();
+        for ( idx_t j = 0; j < field.size(); ++j ) {
+            values[j] = std::sin( 0.37 * j + i ) + 0.1 * std::cos( 1.3 * j );
+        }
+        field.set_dirty( false );
+    }
+
+    struct Mode {
+        std::string name;
+        Config config;
+    };
+    const std::vector<Mode> modes{
+        {"per-field", Config( "fused", false )},
+        {"fused", Config( "fused", true )},
+    };
+    const std::vector<std::string> methods{"trilinear", "tricubic", "triquasicubic"};
+
+    Log::info() << std::endl;
+    Log::info() << std::setw( 16 ) << std::left << "method" << std::setw( 12 ) << "mode" << std::right
+                << std::setw( 14 ) << "time/iter [s]" << std::setw( 14 ) << "checksum" << std::endl;
+
+    for ( const auto& method : methods ) {
+        for ( const auto& mode : modes ) {
+            Interpolation interpolation( option::type( method ) | Config( "matrix_free", true ) | mode.config, fs,
+                                         departure_points );
+
+            interpolation.execute( src, tgt );  // warm-up
+
+            Trace timer( Here(), method + " " + mode.name );
+            for ( long i = 0; i < iterations; ++i ) {
+                interpolation.execute( src, tgt );
+            }
+            timer.stop();
+
+            double checksum = 0.;
+            for ( idx_t i = 0; i < tgt.size(); ++i ) {
+                const double* values = tgt[i].array().data<double>();
+                const idx_t size     = fs.sizeOwned() * tgt[i].size() / tgt[i].shape( 0 );
+                for ( idx_t j = 0; j < size; ++j ) {
+                    checksum += values[j];
+                }
+            }
+
+            Log::info() << std::setw( 16 ) << std::left << method << std::setw( 12 ) << mode.name << std::right
+                        << std::setw( 14 ) << std::setprecision( 6 ) << std::fixed << timer.elapsed() / iterations
+                        << std::setw( 14 ) << std::setprecision( 4 ) << checksum << std::endl;
+        }
+    }
+    return success();
+}
+
+//------------------------------------------------------------------------------
+
+int main( int argc, char** argv ) {
+    Tool tool( argc, argv );
+    return tool.start();
+}
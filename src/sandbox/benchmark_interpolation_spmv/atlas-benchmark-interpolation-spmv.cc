@@ -0,0 +1,162 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+// Benchmark of the sparse matrix-vector products of the matrix-based interpolation methods:
+// CSR kernel, eckit linear algebra backend, and SELL-C-sigma kernel
+
+#include <cmath>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "atlas/array.h"
+#include "atlas/field/Field.h"
+#include "atlas/functionspace/FunctionSpace.h"
+#include "atlas/grid.h"
+#include "atlas/interpolation.h"
+#include "atlas/option.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/AtlasTool.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/Config.h"
+
+//------------------------------------------------------------------------------
+
+using namespace atlas;
+using atlas::util::Config;
+
+//------------------------------------------------------------------------------
+
+class Tool : public AtlasTool {
+    int execute( const Args& args ) override;
+    std::string briefDescription() override {
+        return "Benchmark the sparse matrix-vector products of the interpolation methods";
+    }
+    std::string usage() override { return name() + " [--source=name] [--target=name] [OPTION]... [--help]"; }
+
+public:
+    Tool( int argc, char** argv );
+};
+
+//-----------------------------------------------------------------------------
+
+Tool::Tool( int argc, char** argv ) : AtlasTool( argc, argv ) {
+    add_option( new SimpleOption<std::string>( "source", "Source grid (default=O320)" ) );
+    add_option( new SimpleOption<std::string>( "target", "Target grid (default=O160)" ) );
+    add_option( new SimpleOption<long>( "levels", "Number of levels, 0 for rank-1 fields (default=0)" ) );
+    add_option( new SimpleOption<long>( "iterations", "Number of interpolations per kernel (default=20)" ) );
+}
+
+//-----------------------------------------------------------------------------
+
+int Tool::execute( const Args& args ) {
+    if ( mpi::size() > 1 ) {
+        Log::error() << "This benchmark runs on a single MPI task" << std::endl;
+        return failed();
+    }
+
+    const std::string source_grid = args.getString( "source", "O320" );
+    const std::string target_grid = args.getString( "target", "O160" );
+    const idx_t nlev              = args.getLong( "levels", 0 );
+    const long iterations         = args.getLong( "iterations", 20 );
+
+    Log::info() << "Configuration" << std::endl;
+    Log::info() << "~~~~~~~~~~~~~" << std::endl;
+    Log::info() << "  Source     : " << source_grid << std::endl;
+    Log::info() << "  Target     : " << target_grid << std::endl;
+    Log::info() << "  Levels     : " << nlev << std::endl;
+    Log::info() << "  Iterations : " << iterations << std::endl;
+    Log::info() << "  OpenMP     : " << atlas_omp_get_max_threads() << std::endl;
+
+    struct Kernel {
+        std::string name;
+        Config config;
+    };
+    const std::vector<Kernel> kernels{
+        {"csr", Config( "sell_matrix", false )},
+        {"eckit", Config( "sell_matrix", false ) | Config( "spmv", "eckit" )},
+        {"sell", Config( "sell_matrix", true )},
+    };
+    const std::vector<std::string> methods{"finite-element", "structured-linear2D", "structured-bicubic"};
+
+    Log::info() << std::endl;
+    Log::info() << std::setw( 22 ) << std::left << "method" << std::setw( 8 ) << "kernel" << std::right
+                << std::setw( 14 ) << "time/iter [s]" << std::setw( 14 ) << "checksum" << std::endl;
+
+    for ( const auto& method : methods ) {
+        for ( const auto& kernel : kernels ) {
+            if ( kernel.name == "eckit" && nlev > 0 ) {
+                continue;  // eckit backend is only used for rank-1 fields
+            }
+
+            Interpolation interpolation( option::type( method ) | kernel.config, Grid( source_grid ),
+                                         Grid( target_grid ) );
+
+            Field src = nlev ? interpolation.source().createField<double>( option::levels( nlev ) )
+                             : interpolation.source().createField<double>();
+            Field tgt = nlev ? interpolation.target().createField<double>( option::levels( nlev ) )
+                             : interpolation.target().createField<double>();
+
+            const idx_t nk = std::max<idx_t>( nlev, 1 );
+            auto fill      = [&]( double* values ) {
+                for ( idx_t n = 0; n < src.shape( 0 ); ++n ) {
+                    for ( idx_t k = 0; k < nk; ++k ) {
+                        values[n * nk + k] = std::sin( 0.37 * n ) + 0.1 * k;
+                    }
+                }
+            };
+            if ( nlev ) {
+                fill( array::make_view<double, 2>( src ).data() );
+            }
+            else {
+                fill( array::make_view<double, 1>( src ).data() );
+            }
+            src.set_dirty( false );
+
+            interpolation.execute( src, tgt );  // warm-up
+
+            Trace timer( Here(), method + " " + kernel.name );
+            for ( long i = 0; i < iterations; ++i ) {
+                interpolation.execute( src, tgt );
+            }
+            timer.stop();
+
+            double checksum = 0.;
+            if ( nlev ) {
+                auto values = array::make_view<double, 2>( tgt );
+                for ( idx_t n = 0; n < values.shape( 0 ); ++n ) {
+                    for ( idx_t k = 0; k < nlev; ++k ) {
+                        checksum += values( n, k );
+                    }
+                }
+            }
+            else {
+                auto values = array::make_view<double, 1>( tgt );
+                for ( idx_t n = 0; n < values.shape( 0 ); ++n ) {
+                    checksum += values( n );
+                }
+            }
+
+            Log::info() << std::setw( 22 ) << std::left << method << std::setw( 8 ) << kernel.name << std::right
+                        << std::setw( 14 ) << std::setprecision( 6 ) << std::fixed << timer.elapsed() / iterations
+                        << std::setw( 14 ) << std::setprecision( 4 ) << checksum << std::endl;
+        }
+    }
+    return success();
+}
+
+//------------------------------------------------------------------------------
+
+int main( int argc, char** argv ) {
+    Tool tool( argc, argv );
+    return tool.start();
+}
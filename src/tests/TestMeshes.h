@@ -8,11 +8,23 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
+
+#include "atlas/array/ArrayView.h"
+#include "atlas/array/IndexView.h"
+#include "atlas/array/MakeView.h"
 #include "atlas/grid.h"
 #include "atlas/library/config.h"
+#include "atlas/mesh/Elements.h"
+#include "atlas/mesh/HybridElements.h"
 #include "atlas/mesh/Mesh.h"
+#include "atlas/mesh/Nodes.h"
 #include "atlas/meshgenerator.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/util/CoordinateEnums.h"
+
+#include "tests/AtlasTestEnvironment.h"
 
 using namespace atlas;
 using namespace atlas::grid;
@@ -30,5 +42,70 @@ Mesh generate_mesh( std::initializer_list<long> nx ) {
     return generate_mesh( ReducedGaussianGrid( nx ) );
 }
 
+/// Build a mesh with a single thread and with several threads, and expect both to be identical.
+/// Remote indices and halo levels of nodes, and global indices and halo levels of cells, are only compared
+/// with_halo, as they are only set once parallel fields or a halo are built.
+template <typename Build>
+void expect_identical_with_threads( const Build& build, bool with_halo = false ) {
+    auto build_with_threads = [&]( int num_threads ) {
+        int max_threads = atlas_omp_get_max_threads();
+        atlas_omp_set_num_threads( num_threads );
+        Mesh mesh = build();
+        atlas_omp_set_num_threads( max_threads );
+        return mesh;
+    };
+
+    Mesh serial   = build_with_threads( 1 );
+    Mesh threaded = build_with_threads( std::max( 4, atlas_omp_get_max_threads() ) );
+
+    EXPECT_EQ( threaded.nodes().size(), serial.nodes().size() );
+    EXPECT_EQ( threaded.cells().size(), serial.cells().size() );
+    EXPECT_EQ( threaded.cells().elements( 0 ).size(), serial.cells().elements( 0 ).size() );
+
+    auto xy_s    = array::make_view<double, 2>( serial.nodes().xy() );
+    auto xy_t    = array::make_view<double, 2>( threaded.nodes().xy() );
+    auto glb_s   = array::make_view<gidx_t, 1>( serial.nodes().global_index() );
+    auto glb_t   = array::make_view<gidx_t, 1>( threaded.nodes().global_index() );
+    auto part_s  = array::make_view<int, 1>( serial.nodes().partition() );
+    auto part_t  = array::make_view<int, 1>( threaded.nodes().partition() );
+    auto ridx_s  = array::make_indexview<idx_t, 1>( serial.nodes().remote_index() );
+    auto ridx_t  = array::make_indexview<idx_t, 1>( threaded.nodes().remote_index() );
+    auto halo_s  = array::make_view<int, 1>( serial.nodes().halo() );
+    auto halo_t  = array::make_view<int, 1>( threaded.nodes().halo() );
+    auto flags_s = array::make_view<int, 1>( serial.nodes().flags() );
+    auto flags_t = array::make_view<int, 1>( threaded.nodes().flags() );
+    for ( idx_t n = 0; n < serial.nodes().size(); ++n ) {
+        EXPECT( xy_t( n, XX ) == xy_s( n, XX ) );
+        EXPECT( xy_t( n, YY ) == xy_s( n, YY ) );
+        EXPECT_EQ( glb_t( n ), glb_s( n ) );
+        EXPECT_EQ( part_t( n ), part_s( n ) );
+        EXPECT_EQ( flags_t( n ), flags_s( n ) );
+        if ( with_halo ) {
+            EXPECT_EQ( ridx_t( n ), ridx_s( n ) );
+            EXPECT_EQ( halo_t( n ), halo_s( n ) );
+        }
+    }
+
+    const auto& conn_s = serial.cells().node_connectivity();
+    const auto& conn_t = threaded.cells().node_connectivity();
+    auto cglb_s        = array::make_view<gidx_t, 1>( serial.cells().global_index() );
+    auto cglb_t        = array::make_view<gidx_t, 1>( threaded.cells().global_index() );
+    auto chalo_s       = array::make_view<int, 1>( serial.cells().halo() );
+    auto chalo_t       = array::make_view<int, 1>( threaded.cells().halo() );
+    auto cflags_s      = array::make_view<int, 1>( serial.cells().flags() );
+    auto cflags_t      = array::make_view<int, 1>( threaded.cells().flags() );
+    for ( idx_t c = 0; c < serial.cells().size(); ++c ) {
+        EXPECT_EQ( conn_t.cols( c ), conn_s.cols( c ) );
+        for ( idx_t k = 0; k < conn_s.cols( c ); ++k ) {
+            EXPECT_EQ( conn_t( c, k ), conn_s( c, k ) );
+        }
+        EXPECT_EQ( cflags_t( c ), cflags_s( c ) );
+        if ( with_halo ) {
+            EXPECT_EQ( cglb_t( c ), cglb_s( c ) );
+            EXPECT_EQ( chalo_t( c ), chalo_s( c ) );
+        }
+    }
+}
+
 }  // end namespace test
 }  // end namespace atlas
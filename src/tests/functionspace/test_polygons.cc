@@ -8,6 +8,8 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <memory>
+
 #include "atlas/array/ArrayView.h"
 #include "atlas/array/MakeView.h"
 #include "atlas/field/Field.h"
@@ -224,6 +226,25 @@ CASE( "test_polygon_locator_from_shared" ) {
     EXPECT_EQ( find_partition( PointLonLat{0., -90.} ), mpi::size() - 1 );
 }
 
+CASE( "test_polygon_locator_batched" ) {
+    auto polygons = ListPolygonXY{functionspace().polygons()};
+    PolygonLocator find_partition( polygons );
+
+    std::vector<idx_t> part( points().size() );
+    find_partition( points(), part );
+    for ( size_t n = 0; n < points().size(); ++n ) {
+        EXPECT_EQ( part[n], find_partition( points()[n] ) );
+    }
+
+    std::unique_ptr<bool[]> inside( new bool[points().size()] );
+    for ( idx_t p = 0; p < polygons.size(); ++p ) {
+        polygons[p].contains( points().size(), points().data(), inside.get() );
+        for ( size_t n = 0; n < points().size(); ++n ) {
+            EXPECT_EQ( inside[n], polygons[p].contains( points()[n] ) );
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
@@ -173,6 +173,50 @@ CASE( "test horizontal stencil linear" ) {
 }
 
 
+template <idx_t StencilWidth>
+void check_horizontal_stencil_block( const StructuredGrid& grid, const functionspace::StructuredColumns& fs ) {
+    constexpr idx_t block_size = 32;
+    std::array<double, block_size> x;
+    std::array<double, block_size> y;
+    for ( idx_t p = 0; p < block_size; ++p ) {
+        x[p] = 360. * std::fmod( 0.618034 * p, 1. );
+        y[p] = -90. + 180. * p / double( block_size - 1 );
+    }
+
+    HorizontalStencil<StencilWidth> stencil;
+    HorizontalStencilBlock<StencilWidth, block_size> stencils;
+    ComputeHorizontalStencil compute_stencil( grid, StencilWidth );
+    ComputeXY compute_xy( grid, StencilWidth );
+
+    const idx_t n = block_size - 3;  // incomplete block
+    compute_stencil( n, x.data(), y.data(), stencils );
+    for ( idx_t p = 0; p < n; ++p ) {
+        compute_stencil( x[p], y[p], stencil );
+        for ( idx_t j = 0; j < StencilWidth; ++j ) {
+            EXPECT_EQ( stencils.j( j, p ), stencil.j( j ) );
+            for ( idx_t i = 0; i < StencilWidth; ++i ) {
+                EXPECT_EQ( stencils.i( i, j, p ), stencil.i( i, j ) );
+                PointXY xy = fs.compute_xy( stencil.i( i, j ), stencil.j( j ) );
+                EXPECT( compute_xy.x( stencil.i( i, j ), stencil.j( j ) ) == xy.x() );
+                EXPECT( compute_xy.y( stencil.j( j ) ) == xy.y() );
+            }
+        }
+    }
+}
+
+CASE( "test horizontal stencil block" ) {
+    std::string gridname = eckit::Resource<std::string>( "--grid", "O8" );
+
+    StructuredGrid grid( gridname );
+    util::Config config;
+    config.set( "halo", 2 );
+    config.set( "periodic_points", true );
+    functionspace::StructuredColumns fs( grid, grid::Partitioner( "equal_regions" ), config );
+
+    SECTION( "linear" ) { check_horizontal_stencil_block<2>( grid, fs ); }
+    SECTION( "cubic" ) { check_horizontal_stencil_block<4>( grid, fs ); }
+}
+
 //-----------------------------------------------------------------------------
 
 CASE( "test vertical stencil" ) {
@@ -9,9 +9,17 @@
  */
 
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <cstdint>
 #include <iomanip>
 #include <sstream>
+#include <string>
+#include <vector>
+
+#include "eckit/filesystem/PathName.h"
+#include "eckit/io/ResizableBuffer.h"
+#include "eckit/serialisation/ResizableMemoryStream.h"
 
 #include "atlas/array.h"
 #include "atlas/field.h"
@@ -19,6 +27,7 @@
 #include "atlas/grid.h"
 #include "atlas/grid/detail/distribution/BandsDistribution.h"
 #include "atlas/grid/detail/distribution/SerialDistribution.h"
+#include "atlas/grid/detail/partitioner/EqualRegionsPartitioner.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/parallel/omp/omp.h"
 #include "atlas/util/Config.h"
@@ -139,6 +148,265 @@ CASE( "test_regular_bands" ) {
     }
 }
 
+CASE( "test_equal_regions_functional" ) {
+    std::vector<std::string> gridnames = {"O32", "N24", "L40x21", "Slat100x50", "L4x3"};
+    std::vector<int> nb_partitions     = {1, 2, 5, 16, 37};
+
+    for ( auto gridname : gridnames ) {
+        for ( int N : nb_partitions ) {
+            SECTION( gridname + " N=" + std::to_string( N ) ) {
+                auto grid = StructuredGrid( gridname );
+                grid::Partitioner partitioner( "equal_regions", N );
+
+                grid::Distribution functional( grid, partitioner );
+                EXPECT( functional.footprint() < 100 * ( N + 1 ) );
+                EXPECT_EQ( functional.nb_partitions(), N );
+
+                std::vector<int> part( grid.size() );
+                partitioner.partition( grid, part.data() );
+
+                std::vector<idx_t> nb_pts( N, 0 );
+                for ( gidx_t n = 0; n < grid.size(); ++n ) {
+                    EXPECT_EQ( functional.partition( n ), part[n] );
+                    ++nb_pts[part[n]];
+                }
+                EXPECT( functional.nb_pts() == nb_pts );
+
+                grid::Distribution::partition_t row_part( grid.nxmax() );
+                for ( idx_t j = 0, n = 0; j < grid.ny(); n += grid.nx( j++ ) ) {
+                    functional.partition( n, n + grid.nx( j ), row_part );
+                    for ( idx_t i = 0; i < grid.nx( j ); ++i ) {
+                        EXPECT_EQ( row_part[i], part[n + i] );
+                    }
+                }
+            }
+        }
+    }
+}
+
+CASE( "test_partitioner_distributed_sort" ) {
+    StructuredGrid structured( "O16" );
+    std::vector<PointXY> points( structured.xy().begin(), structured.xy().end() );
+    UnstructuredGrid unstructured( points );
+
+    // every task sorts its own slice of the grid, the result must be the same as sorting the whole grid on each task
+    for ( Grid grid : std::vector<Grid>{structured, unstructured} ) {
+        for ( int N : {5, 12, 33, int( mpi::size() )} ) {
+            SECTION( grid.name() + " N=" + std::to_string( N ) ) {
+                std::vector<int> part_legacy( grid.size() );
+                std::vector<int> part( grid.size() );
+                grid::detail::partitioner::EqualRegionsPartitioner( N, util::Config( "distributed_sort", false ) )
+                    .partition( grid, part_legacy.data() );
+                grid::detail::partitioner::EqualRegionsPartitioner( N ).partition( grid, part.data() );
+                for ( idx_t n = 0; n < grid.size(); ++n ) {
+                    EXPECT_EQ( part[n], part_legacy[n] );
+                }
+            }
+        }
+    }
+}
+
+CASE( "test_distribution_ranges" ) {
+    std::vector<std::string> gridnames  = {"L40x21", "O16"};
+    std::vector<std::string> partitions = {"serial", "bands", "regular_bands", "checkerboard", "equal_regions"};
+    std::vector<int> nb_partitions      = {1, 3, 8};
+
+    for ( auto gridname : gridnames ) {
+        for ( auto type : partitions ) {
+            for ( int N : nb_partitions ) {
+                auto grid = StructuredGrid( gridname );
+                if ( ( type == "checkerboard" || type == "regular_bands" ) && not RegularGrid( grid ) ) {
+                    continue;
+                }
+                if ( type == "serial" && N > 1 ) {
+                    continue;
+                }
+                SECTION( gridname + " " + type + " N=" + std::to_string( N ) ) {
+                    grid::Partitioner partitioner( type, N );
+                    grid::Distribution distribution( grid, partitioner );
+
+                    std::vector<int> part( grid.size() );
+                    partitioner.partition( grid, part.data() );
+
+                    grid::Distribution::ranges_t ranges;
+                    for ( int p = 0; p < N; ++p ) {
+                        EXPECT( distribution.ranges( p, ranges ) );
+                        std::vector<int> owned( grid.size(), 0 );
+                        gidx_t previous_end = -1;
+                        for ( const auto& range : ranges ) {
+                            EXPECT( range.begin > previous_end );
+                            EXPECT( range.begin < range.end );
+                            for ( gidx_t n = range.begin; n < range.end; ++n ) {
+                                owned[n] = 1;
+                            }
+                            previous_end = range.end;
+                        }
+                        idx_t count = 0;
+                        for ( gidx_t n = 0; n < grid.size(); ++n ) {
+                            EXPECT_EQ( owned[n], int( part[n] == p ) );
+                            EXPECT_EQ( distribution.partition( n ), part[n] );
+                            count += owned[n];
+                        }
+                        EXPECT_EQ( count, distribution.nb_pts()[p] );
+                    }
+                }
+            }
+        }
+    }
+}
+
+CASE( "test_hilbert" ) {
+    StructuredGrid structured( "O16" );
+    std::vector<PointXY> points( structured.xy().begin(), structured.xy().end() );
+    UnstructuredGrid unstructured( points );
+
+    for ( Grid grid : std::vector<Grid>{structured, unstructured} ) {
+        for ( int N : {1, 5, 16, 37} ) {
+            SECTION( grid.name() + " N=" + std::to_string( N ) ) {
+                grid::Partitioner partitioner( "hilbert", N );
+                grid::Distribution distribution( grid, partitioner );
+                EXPECT( distribution.footprint() < 100 * ( N + 1 ) );
+                EXPECT_EQ( distribution.nb_partitions(), N );
+
+                std::vector<int> part( grid.size() );
+                partitioner.partition( grid, part.data() );
+
+                std::vector<idx_t> nb_pts( N, 0 );
+                for ( gidx_t n = 0; n < grid.size(); ++n ) {
+                    EXPECT_EQ( distribution.partition( n ), part[n] );
+                    ++nb_pts[part[n]];
+                }
+                EXPECT( distribution.nb_pts() == nb_pts );
+                EXPECT( distribution.max_pts() - distribution.min_pts() <= 1 );
+
+                grid::Distribution::partition_t block_part( 100 );
+                for ( gidx_t n = 0; n < grid.size(); n += 100 ) {
+                    const gidx_t end = std::min<gidx_t>( n + 100, grid.size() );
+                    distribution.partition( n, end, block_part );
+                    for ( gidx_t m = n; m < end; ++m ) {
+                        EXPECT_EQ( block_part[m - n], part[m] );
+                    }
+                }
+            }
+        }
+    }
+}
+
+CASE( "test_weighted_partitioners" ) {
+    StructuredGrid grid( "O16" );
+    const gidx_t size = grid.size();
+
+    // Points in the southern half are three times as expensive
+    auto weight = [size]( gidx_t n ) { return n < size / 2 ? 1. : 3.; };
+
+    for ( std::string type : {"bands", "equal_regions", "hilbert"} ) {
+        for ( int N : {4, 7} ) {
+            SECTION( type + " N=" + std::to_string( N ) ) {
+                grid::Partitioner partitioner( type, N );
+                partitioner.weights( weight );
+                grid::Distribution distribution( grid, partitioner );
+
+                std::vector<int> part( size );
+                partitioner.partition( grid, part.data() );
+
+                std::vector<double> partition_weight( N, 0. );
+                double total = 0.;
+                for ( gidx_t n = 0; n < size; ++n ) {
+                    EXPECT_EQ( distribution.partition( n ), part[n] );
+                    partition_weight[part[n]] += weight( n );
+                    total += weight( n );
+                }
+                // Balanced within a few points
+                for ( int p = 0; p < N; ++p ) {
+                    EXPECT( std::abs( partition_weight[p] - total / N ) <= 9. );
+                }
+            }
+        }
+    }
+
+    SECTION( "not weightable" ) {
+        grid::Partitioner partitioner( "checkerboard", 4 );
+        EXPECT_THROWS( partitioner.weights( weight ) );
+    }
+}
+
+CASE( "test_distribution_encode_decode" ) {
+    StructuredGrid grid( "O32" );
+
+    for ( std::string type : {"equal_regions", "hilbert", "checkerboard"} ) {
+        SECTION( type ) {
+            util::Config config( "type", type );
+            config.set( "partitions", 7 );
+
+            grid::Distribution distribution( grid, config );
+
+            eckit::ResizableBuffer buffer{0};
+            eckit::ResizableMemoryStream s{buffer};
+            distribution.encode( s );
+            EXPECT( size_t( s.position() ) < grid.size() * sizeof( int ) );
+
+            s.rewind();
+            grid::Distribution decoded( s );
+            EXPECT_EQ( decoded.type(), distribution.type() );
+            EXPECT_EQ( decoded.nb_partitions(), distribution.nb_partitions() );
+            EXPECT_EQ( decoded.size(), distribution.size() );
+            EXPECT( decoded.nb_pts() == distribution.nb_pts() );
+            EXPECT_EQ( decoded.hash(), distribution.hash() );
+
+            grid::Distribution::ranges_t ranges;
+            for ( int p = 0; p < decoded.nb_partitions(); ++p ) {
+                EXPECT( decoded.ranges( p, ranges ) );
+                idx_t count = 0;
+                for ( const auto& range : ranges ) {
+                    for ( gidx_t n = range.begin; n < range.end; ++n ) {
+                        EXPECT_EQ( distribution.partition( n ), p );
+                    }
+                    count += range.end - range.begin;
+                }
+                EXPECT_EQ( count, distribution.nb_pts()[p] );
+            }
+
+            // Unique directory under TMPDIR, named by task 0
+            std::string directory_name;
+            if ( mpi::rank() == 0 ) {
+                const char* tmpdir = ::getenv( "TMPDIR" );
+                const eckit::PathName tmp( tmpdir ? tmpdir : "/tmp" );
+                directory_name = eckit::PathName::unique( tmp / "atlas_test_distribution_cache" ).asString();
+            }
+            int directory_name_size = static_cast<int>( directory_name.size() );
+            mpi::comm().broadcast( directory_name_size, 0 );
+            directory_name.resize( directory_name_size );
+            mpi::comm().broadcast( directory_name.begin(), directory_name.end(), 0 );
+
+            eckit::PathName directory( directory_name );
+            grid::DistributionCache cache( directory );
+            eckit::PathName file = cache.path( cache.key( grid, config ) );
+            if ( mpi::rank() == 0 && file.exists() ) {
+                file.unlink();
+            }
+            mpi::comm().barrier();
+
+            grid::Distribution created = cache.distribution( grid, config );
+            EXPECT_EQ( created.hash(), distribution.hash() );
+            mpi::comm().barrier();  // the file is written by task 0
+            EXPECT( file.exists() );
+            grid::Distribution loaded = cache.distribution( grid, config );
+            EXPECT_EQ( loaded.hash(), distribution.hash() );
+            EXPECT_EQ( loaded.type(), distribution.type() );
+
+            util::Config other( config );
+            other.set( "partitions", 8 );
+            EXPECT( cache.key( grid, other ) != cache.key( grid, config ) );
+
+            mpi::comm().barrier();
+            if ( mpi::rank() == 0 ) {
+                file.unlink();
+                directory.rmdir();
+            }
+        }
+    }
+}
+
 CASE( "test regular_bands performance test" ) {
     // auto grid = StructuredGrid( "L40000x20000" );  //-- > test takes too long( less than 15 seconds )
     // Example timings for L40000x20000:
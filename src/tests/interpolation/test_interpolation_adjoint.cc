@@ -0,0 +1,129 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <cmath>
+
+#include "atlas/array.h"
+#include "atlas/field/Field.h"
+#include "atlas/functionspace/NodeColumns.h"
+#include "atlas/functionspace/PointCloud.h"
+#include "atlas/functionspace/StructuredColumns.h"
+#include "atlas/grid.h"
+#include "atlas/interpolation.h"
+#include "atlas/mesh.h"
+#include "atlas/meshgenerator.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/util/CoordinateEnums.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+using atlas::functionspace::NodeColumns;
+using atlas::functionspace::PointCloud;
+using atlas::functionspace::StructuredColumns;
+using atlas::util::Config;
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+// Target points within the partition of the source, so that every task interpolates points of its own
+PointCloud target_points( const FunctionSpace& source ) {
+    const auto& polygon = source.polygon();
+    std::vector<PointXY> points;
+    for ( idx_t j = 0; j < 9; ++j ) {
+        for ( idx_t i = 0; i < 12; ++i ) {
+            const PointXY p{15. + 30. * i + 0.3 * j, -80. + 20. * j};
+            if ( polygon.contains( p ) ) {
+                points.emplace_back( p );
+            }
+        }
+    }
+    return PointCloud( points );
+}
+
+// Dot-product test: < W x, y > == < x, W^T y >, summed over owned points only. On more than one task the adjoint
+// halo exchange adds the contributions to ghost points of the source to their owners.
+void check_adjoint( const Interpolation& interpolation, const FunctionSpace& source, const Field& source_ghost ) {
+    const PointCloud target = interpolation.target();
+
+    Field x  = source.createField<double>( option::name( "x" ) );
+    Field xa = source.createField<double>( option::name( "xa" ) );
+    Field y( "y", array::make_datatype<double>(), array::make_shape( target.size() ) );
+    Field ya( "ya", array::make_datatype<double>(), array::make_shape( target.size() ) );
+
+    auto vx    = array::make_view<double, 1>( x );
+    auto vxa   = array::make_view<double, 1>( xa );
+    auto vy    = array::make_view<double, 1>( y );
+    auto vya   = array::make_view<double, 1>( ya );
+    auto ghost = array::make_view<int, 1>( source_ghost );
+
+    for ( idx_t n = 0; n < vx.size(); ++n ) {
+        vx( n ) = std::sin( 0.37 * n ) + 0.1 * std::cos( 1.3 * n );
+    }
+    source.haloExchange( x );
+
+    for ( idx_t n = 0; n < vya.size(); ++n ) {
+        vya( n ) = std::cos( 0.71 * n ) - 0.2 * std::sin( 0.11 * n );
+    }
+
+    interpolation.execute( x, y );
+    interpolation.execute_adjoint( xa, ya );
+
+    double dot_target = 0.;
+    for ( idx_t n = 0; n < vy.size(); ++n ) {
+        dot_target += vy( n ) * vya( n );
+    }
+    double dot_source = 0.;
+    for ( idx_t n = 0; n < vx.size(); ++n ) {
+        if ( not ghost( n ) ) {
+            dot_source += vx( n ) * vxa( n );
+        }
+    }
+    mpi::comm().allReduceInPlace( dot_target, eckit::mpi::sum() );
+    mpi::comm().allReduceInPlace( dot_source, eckit::mpi::sum() );
+
+    Log::info() << "< W x, y > = " << dot_target << "  < x, W^T y > = " << dot_source << std::endl;
+    EXPECT( std::abs( dot_target - dot_source ) <= 1.e-12 * std::abs( dot_target ) );
+}
+
+//-----------------------------------------------------------------------------
+
+CASE( "test_adjoint_finite_element" ) {
+    Grid grid( "O32" );
+    Mesh mesh = MeshGenerator( "structured" ).generate( grid );
+    NodeColumns fs( mesh );
+
+    Interpolation interpolation( option::type( "finite-element" ), fs, target_points( fs ) );
+    check_adjoint( interpolation, fs, fs.nodes().ghost() );
+}
+
+CASE( "test_adjoint_structured" ) {
+    Grid grid( "O32" );
+    StructuredColumns fs( grid, option::halo( 2 ) );
+
+    for ( std::string type : {"structured-linear2D", "structured-bicubic", "structured-biquasicubic"} ) {
+        for ( bool matrix_free : {false, true} ) {
+            Log::info() << type << ( matrix_free ? " (matrix_free)" : "" ) << std::endl;
+            Interpolation interpolation( Config( "type", type ).set( "matrix_free", matrix_free ), fs,
+                                         target_points( fs ) );
+            check_adjoint( interpolation, fs, fs.ghost() );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main( int argc, char** argv ) {
+    return atlas::test::run( argc, argv );
+}
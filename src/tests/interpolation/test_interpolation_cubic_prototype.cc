@@ -9,6 +9,7 @@
  */
 
 #include <algorithm>
+#include <cmath>
 #include <iomanip>
 
 #include "eckit/linalg/LinearAlgebra.h"
@@ -387,6 +388,71 @@ CASE( "test 3d cubic interpolation" ) {
     }
 }
 
+CASE( "test 3d interpolation fused over fields" ) {
+    idx_t nlev = 21;  // more than one block of levels
+    Vertical vertical( nlev, zrange( nlev, 0., 1. ) );
+
+    Config config;
+    config.set( "halo", 2 );
+    config.set( "periodic_points", true );
+    StructuredColumns fs( StructuredGrid( "O8" ), vertical, Partitioner( "equal_regions" ), config );
+
+    auto xy       = array::make_view<double, 2>( fs.xy() );
+    const auto& z = fs.vertical();
+
+    // Departure points displaced from the grid points; halo points take the departure points of the first point
+    auto dp_field = fs.createField<double>( option::variables( 3 ) );
+    {
+        auto dp = array::make_view<double, 3>( dp_field );
+        for ( idx_t n = 0; n < dp.shape( 0 ); ++n ) {
+            const idx_t m = n < fs.sizeOwned() ? n : 0;
+            for ( idx_t k = 0; k < dp.shape( 1 ); ++k ) {
+                dp( n, k, LON ) = xy( m, XX ) + 3. * std::sin( 0.3 * m + 0.7 * k );
+                dp( n, k, LAT ) = std::max( -90., std::min( 90., xy( m, YY ) + 2. * std::cos( 0.5 * m + 0.2 * k ) ) );
+                dp( n, k, ZZ )  = std::max( 0., std::min( 1., z( k ) + 0.03 * std::sin( 0.1 * m + 1.3 * k ) ) );
+            }
+        }
+    }
+
+    auto fill = [&]( Field& field, double offset ) {
+        double* values = field.array().data<double>();
+        for ( idx_t i = 0; i < field.size(); ++i ) {
+            values[i] = std::sin( 0.37 * i + offset ) + 0.1 * std::cos( 1.3 * i );
+        }
+        field.set_dirty( false );  // to avoid halo-exchange
+    };
+
+    auto check = [&]( const std::string& type, const option::variables& variables ) {
+        FieldSet input;
+        FieldSet output_fused;
+        FieldSet output_per_field;
+        for ( idx_t i = 0; i < 3; ++i ) {
+            Field field = input.add( fs.createField<double>( variables ) );
+            fill( field, i );
+            output_fused.add( fs.createField<double>( variables ) );
+            output_per_field.add( fs.createField<double>( variables ) );
+        }
+
+        auto matrix_free = Config( "matrix_free", true );
+        Interpolation( option::type( type ) | matrix_free, fs, dp_field ).execute( input, output_fused );
+        Interpolation( option::type( type ) | matrix_free | Config( "fused", false ), fs, dp_field )
+            .execute( input, output_per_field );
+
+        for ( idx_t i = 0; i < 3; ++i ) {
+            const double* fused     = output_fused[i].array().data<double>();
+            const double* per_field = output_per_field[i].array().data<double>();
+            for ( idx_t j = 0; j < output_fused[i].size(); ++j ) {
+                EXPECT( is_approximately_equal( fused[j], per_field[j], 1.e-12 ) );
+            }
+        }
+    };
+
+    for ( std::string type : {"trilinear", "tricubic", "triquasicubic"} ) {
+        SECTION( type + " rank 2" ) { check( type, option::variables( 0 ) ); }
+        SECTION( type + " rank 3" ) { check( type, option::variables( 2 ) ); }
+    }
+}
+
 }  // namespace test
 }  // namespace atlas
 
@@ -9,7 +9,9 @@
  */
 
 #include <cmath>
+#include <cstdlib>
 
+#include "eckit/filesystem/PathName.h"
 #include "eckit/types/FloatCompare.h"
 
 #include "atlas/array.h"
@@ -79,6 +81,294 @@ CASE( "test_interpolation_finite_element" ) {
 
 //-----------------------------------------------------------------------------
 
+CASE( "test_interpolation_finite_element_fieldset" ) {
+    Grid grid( "O32" );
+    MeshGenerator meshgen( "structured" );
+    Mesh mesh = meshgen.generate( grid );
+    NodeColumns fs( mesh );
+
+    PointCloud pointcloud( {{00., 0.}, {10., 10.}, {20., 20.}, {30., 30.}, {40., 40.}, {50., -50.}, {60., -60.}} );
+
+    Interpolation interpolation( option::type( "finite-element" ), fs, pointcloud );
+
+    // fields of different datatype and rank, interpolated both together and one by one
+    const idx_t nlev = 3;
+    FieldSet fields_source;
+    FieldSet fields_target;
+    FieldSet fields_check;
+    auto lonlat = array::make_view<double, 2>( fs.nodes().lonlat() );
+    for ( idx_t f = 0; f < 5; ++f ) {
+        Field src = fields_source.add( fs.createField<double>( option::name( "d" + std::to_string( f ) ) ) );
+        fields_target.add( Field( "d" + std::to_string( f ), array::make_datatype<double>(),
+                                  array::make_shape( pointcloud.size() ) ) );
+        fields_check.add( Field( "d" + std::to_string( f ), array::make_datatype<double>(),
+                                 array::make_shape( pointcloud.size() ) ) );
+        auto source = array::make_view<double, 1>( src );
+        for ( idx_t j = 0; j < fs.nodes().size(); ++j ) {
+            source( j ) = std::sin( ( f + 1 ) * lonlat( j, LON ) * M_PI / 180. ) + lonlat( j, LAT );
+        }
+    }
+    for ( idx_t f = 0; f < 3; ++f ) {
+        Field src = fields_source.add(
+            fs.createField<float>( option::name( "f" + std::to_string( f ) ) | option::levels( nlev ) ) );
+        fields_target.add( Field( "f" + std::to_string( f ), array::make_datatype<float>(),
+                                  array::make_shape( pointcloud.size(), nlev ) ) );
+        fields_check.add( Field( "f" + std::to_string( f ), array::make_datatype<float>(),
+                                 array::make_shape( pointcloud.size(), nlev ) ) );
+        auto source = array::make_view<float, 2>( src );
+        for ( idx_t j = 0; j < fs.nodes().size(); ++j ) {
+            for ( idx_t k = 0; k < nlev; ++k ) {
+                source( j, k ) = float( std::cos( ( f + k ) * lonlat( j, LON ) * M_PI / 180. ) );
+            }
+        }
+    }
+
+    interpolation.execute( fields_source, fields_target );
+    for ( idx_t f = 0; f < fields_source.size(); ++f ) {
+        interpolation.execute( fields_source[f], fields_check[f] );
+    }
+
+    for ( idx_t f = 0; f < 5; ++f ) {
+        auto target = array::make_view<double, 1>( fields_target[f] );
+        auto check  = array::make_view<double, 1>( fields_check[f] );
+        for ( idx_t j = 0; j < pointcloud.size(); ++j ) {
+            EXPECT( target( j ) == check( j ) );
+        }
+    }
+    for ( idx_t f = 5; f < fields_source.size(); ++f ) {
+        auto target = array::make_view<float, 2>( fields_target[f] );
+        auto check  = array::make_view<float, 2>( fields_check[f] );
+        for ( idx_t j = 0; j < pointcloud.size(); ++j ) {
+            for ( idx_t k = 0; k < nlev; ++k ) {
+                EXPECT( target( j, k ) == check( j, k ) );
+            }
+        }
+    }
+}
+
+CASE( "test_interpolation_finite_element_matrix_storage" ) {
+    Grid grid( "O32" );
+    MeshGenerator meshgen( "structured" );
+    Mesh mesh = meshgen.generate( grid );
+    NodeColumns fs( mesh );
+
+    PointCloud pointcloud( {{00., 0.}, {10., 10.}, {20., 20.}, {30., 30.}, {40., 40.}, {50., -50.}, {60., -60.}} );
+
+    const idx_t nlev = 3;
+    Field src_d      = fs.createField<double>( option::name( "d" ) );
+    Field src_f      = fs.createField<float>( option::name( "f" ) | option::levels( nlev ) );
+    Field src_v      = fs.createField<float>( option::name( "v" ) | option::levels( nlev ) | option::variables( 2 ) );
+    auto source_d    = array::make_view<double, 1>( src_d );
+    auto source_f    = array::make_view<float, 2>( src_f );
+    auto source_v    = array::make_view<float, 3>( src_v );
+    auto lonlat      = array::make_view<double, 2>( fs.nodes().lonlat() );
+    for ( idx_t j = 0; j < fs.nodes().size(); ++j ) {
+        source_d( j ) = std::sin( lonlat( j, LON ) * M_PI / 180. ) + lonlat( j, LAT );
+        for ( idx_t k = 0; k < nlev; ++k ) {
+            source_f( j, k )    = float( std::cos( k * lonlat( j, LON ) * M_PI / 180. ) );
+            source_v( j, k, 0 ) = float( std::cos( k * lonlat( j, LON ) * M_PI / 180. ) );
+            source_v( j, k, 1 ) = float( std::sin( k * lonlat( j, LAT ) * M_PI / 180. ) );
+        }
+    }
+
+    auto interpolate = [&]( const Config& config, Field& tgt_d, Field& tgt_f, Field& tgt_v ) {
+        Interpolation interpolation( option::type( "finite-element" ) | config, fs, pointcloud );
+        tgt_d = Field( "d", array::make_datatype<double>(), array::make_shape( pointcloud.size() ) );
+        tgt_f = Field( "f", array::make_datatype<float>(), array::make_shape( pointcloud.size(), nlev ) );
+        tgt_v = Field( "v", array::make_datatype<float>(), array::make_shape( pointcloud.size(), nlev, 2 ) );
+        interpolation.execute( src_d, tgt_d );
+        interpolation.execute( src_f, tgt_f );
+        interpolation.execute( src_v, tgt_v );
+    };
+
+    Field ref_d, ref_f, ref_v;
+    interpolate( Config(), ref_d, ref_f, ref_v );
+    auto reference_d = array::make_view<double, 1>( ref_d );
+    auto reference_f = array::make_view<float, 2>( ref_f );
+    auto reference_v = array::make_view<float, 3>( ref_v );
+
+    for ( bool delta_encoding : {false, true} ) {
+        Field tgt_d, tgt_f, tgt_v;
+        interpolate( Config( "matrix_storage", "float" ) | Config( "matrix_delta_encoding", delta_encoding ), tgt_d,
+                     tgt_f, tgt_v );
+        auto target_d = array::make_view<double, 1>( tgt_d );
+        auto target_f = array::make_view<float, 2>( tgt_f );
+        auto target_v = array::make_view<float, 3>( tgt_v );
+        for ( idx_t j = 0; j < pointcloud.size(); ++j ) {
+            // double fields see single precision weights, float fields were already using them
+            EXPECT( eckit::types::is_approximately_equal( target_d( j ), reference_d( j ), 1.e-6 ) );
+            for ( idx_t k = 0; k < nlev; ++k ) {
+                EXPECT( target_f( j, k ) == reference_f( j, k ) );
+                EXPECT( target_v( j, k, 0 ) == reference_v( j, k, 0 ) );
+                EXPECT( target_v( j, k, 1 ) == reference_v( j, k, 1 ) );
+            }
+        }
+    }
+}
+
+CASE( "test_interpolation_finite_element_sell_matrix" ) {
+    Grid grid( "O32" );
+    MeshGenerator meshgen( "structured" );
+    Mesh mesh = meshgen.generate( grid );
+    NodeColumns fs( mesh );
+
+    // enough points for several chunks of rows, the last one incomplete
+    std::vector<PointXY> points;
+    for ( idx_t j = 0; j < 101; ++j ) {
+        points.emplace_back( 3.6 * j, -80. + 1.6 * j );
+    }
+    PointCloud pointcloud( points );
+
+    auto lonlat   = array::make_view<double, 2>( fs.nodes().lonlat() );
+    auto function = [&]( idx_t j, idx_t k ) {
+        return std::sin( ( k + 1 ) * lonlat( j, LON ) * M_PI / 180. ) + lonlat( j, LAT );
+    };
+
+    auto interpolate = [&]( bool sell_matrix, const Field& src, Field& tgt ) {
+        Interpolation interpolation( option::type( "finite-element" ) | Config( "sell_matrix", sell_matrix ), fs,
+                                     pointcloud );
+        interpolation.execute( src, tgt );
+    };
+
+    SECTION( "rank 1" ) {
+        Field src = fs.createField<double>();
+        auto vsrc = array::make_view<double, 1>( src );
+        for ( idx_t j = 0; j < fs.nodes().size(); ++j ) {
+            vsrc( j ) = function( j, 0 );
+        }
+        Field ref( "ref", array::make_datatype<double>(), array::make_shape( pointcloud.size() ) );
+        Field tgt( "tgt", array::make_datatype<double>(), array::make_shape( pointcloud.size() ) );
+        interpolate( false, src, ref );
+        interpolate( true, src, tgt );
+        auto reference = array::make_view<double, 1>( ref );
+        auto target    = array::make_view<double, 1>( tgt );
+        for ( idx_t j = 0; j < pointcloud.size(); ++j ) {
+            EXPECT( eckit::types::is_approximately_equal( target( j ), reference( j ), 1.e-12 ) );
+        }
+    }
+
+    // with few levels the SELL kernel is used, with many levels the CSR kernel
+    for ( idx_t nlev : {4, 16} ) {
+        SECTION( "rank 2, levels = " + std::to_string( nlev ) ) {
+            Field src = fs.createField<double>( option::levels( nlev ) );
+            auto vsrc = array::make_view<double, 2>( src );
+            for ( idx_t j = 0; j < fs.nodes().size(); ++j ) {
+                for ( idx_t k = 0; k < nlev; ++k ) {
+                    vsrc( j, k ) = function( j, k );
+                }
+            }
+            Field ref( "ref", array::make_datatype<double>(), array::make_shape( pointcloud.size(), nlev ) );
+            Field tgt( "tgt", array::make_datatype<double>(), array::make_shape( pointcloud.size(), nlev ) );
+            interpolate( false, src, ref );
+            interpolate( true, src, tgt );
+            auto reference = array::make_view<double, 2>( ref );
+            auto target    = array::make_view<double, 2>( tgt );
+            for ( idx_t j = 0; j < pointcloud.size(); ++j ) {
+                for ( idx_t k = 0; k < nlev; ++k ) {
+                    EXPECT( eckit::types::is_approximately_equal( target( j, k ), reference( j, k ), 1.e-12 ) );
+                }
+            }
+        }
+    }
+}
+
+CASE( "test_interpolation_structured_locator" ) {
+    Grid grid( "O32" );
+    MeshGenerator meshgen( "structured" );
+    Mesh mesh = meshgen.generate( grid );
+    NodeColumns fs( mesh );
+
+    auto lonlat = array::make_view<double, 2>( fs.nodes().lonlat() );
+    Field src   = fs.createField<double>();
+    auto vsrc   = array::make_view<double, 1>( src );
+    for ( idx_t j = 0; j < fs.nodes().size(); ++j ) {
+        vsrc( j ) = std::sin( 3. * lonlat( j, LON ) * M_PI / 180. ) + lonlat( j, LAT );
+    }
+
+    // results located with the structured grid arithmetic and with a kd-tree are the same
+    auto check = [&]( const std::string& type, const FunctionSpace& target ) {
+        Field ref = target.createField<double>();
+        Field tgt = target.createField<double>();
+        Interpolation( option::type( type ) | Config( "structured_locator", false ), fs, target ).execute( src, ref );
+        Interpolation( option::type( type ) | Config( "structured_locator", true ), fs, target ).execute( src, tgt );
+        auto reference = array::make_view<double, 1>( ref );
+        auto result    = array::make_view<double, 1>( tgt );
+        for ( idx_t j = 0; j < reference.size(); ++j ) {
+            EXPECT( eckit::types::is_approximately_equal( result( j ), reference( j ), 1.e-12 ) );
+        }
+    };
+
+    SECTION( "finite-element" ) {
+        // points all over the globe, including negative longitudes and close to the poles
+        std::vector<PointXY> points;
+        for ( idx_t j = 0; j < 101; ++j ) {
+            points.emplace_back( -179.3 + 7.31 * j, -89.5 + 1.79 * j );
+        }
+        check( "finite-element", PointCloud( points ) );
+    }
+
+    SECTION( "nearest-neighbour" ) {
+        Mesh target_mesh = meshgen.generate( Grid( "O20" ) );
+        check( "nearest-neighbour", NodeColumns( target_mesh ) );
+    }
+}
+
+CASE( "test_interpolation_finite_element_search_tree_cache" ) {
+    Grid grid( "O32" );
+    MeshGenerator meshgen( "structured" );
+    Mesh mesh = meshgen.generate( grid );
+    NodeColumns fs( mesh );
+
+    auto lonlat = array::make_view<double, 2>( fs.nodes().lonlat() );
+    Field src   = fs.createField<double>();
+    auto vsrc   = array::make_view<double, 1>( src );
+    for ( idx_t j = 0; j < fs.nodes().size(); ++j ) {
+        vsrc( j ) = std::sin( 3. * lonlat( j, LON ) * M_PI / 180. ) + lonlat( j, LAT );
+    }
+
+    std::vector<PointXY> points;
+    for ( idx_t j = 0; j < 101; ++j ) {
+        points.emplace_back( -179.3 + 7.31 * j, -89.5 + 1.79 * j );
+    }
+    PointCloud pointcloud( points );
+
+    const char* tmpdir = ::getenv( "TMPDIR" );
+    const PathName cache = PathName::unique( PathName( tmpdir ? tmpdir : "/tmp" ) / "atlas_test_search_tree_cache" );
+    cache.mkdir();
+
+    // the element search tree is written by the first setup, and read by the second
+    auto interpolate = [&]( const Config& config ) {
+        Field tgt = pointcloud.createField<double>();
+        Interpolation( option::type( "finite-element" ) | Config( "structured_locator", false ) | config, fs,
+                       pointcloud )
+            .execute( src, tgt );
+        return tgt;
+    };
+    Field ref     = interpolate( Config() );
+    Field written = interpolate( Config( "search_tree_cache", cache.asString() ) );
+
+    std::vector<PathName> files, dirs;
+    cache.children( files, dirs );
+    EXPECT_EQ( files.size(), size_t( 1 ) );
+
+    Field read = interpolate( Config( "search_tree_cache", cache.asString() ) );
+
+    auto reference = array::make_view<double, 1>( ref );
+    auto result_w  = array::make_view<double, 1>( written );
+    auto result_r  = array::make_view<double, 1>( read );
+    for ( idx_t j = 0; j < reference.size(); ++j ) {
+        EXPECT( result_w( j ) == reference( j ) );
+        EXPECT( result_r( j ) == reference( j ) );
+    }
+
+    for ( auto& file : files ) {
+        file.unlink();
+    }
+    cache.rmdir();
+}
+
+//-----------------------------------------------------------------------------
+
 }  // namespace test
 }  // namespace atlas
 
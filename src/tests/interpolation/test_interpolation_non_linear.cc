@@ -13,6 +13,8 @@
 #include <algorithm>
 #include <limits>
 
+#include "eckit/linalg/Triplet.h"
+
 #include "atlas/array.h"
 #include "atlas/field/MissingValue.h"
 #include "atlas/functionspace.h"
@@ -35,6 +37,7 @@ const double missingValueEps = 1e-9;
 const double nan             = std::numeric_limits<double>::quiet_NaN();
 
 using field::MissingValue;
+using interpolation::NonLinear;
 using util::Config;
 
 CASE( "Interpolation with MissingValue" ) {
@@ -132,6 +135,58 @@ CASE( "Interpolation with MissingValue" ) {
 }
 
 
+CASE( "NonLinear interpolate on the fly matches corrected matrix" ) {
+    using Matrix = NonLinear::Matrix;
+
+    // rows: no missing value, heaviest missing, all missing, one (light) missing
+    std::vector<eckit::linalg::Triplet> triplets{{0, 0, 0.5}, {0, 1, 0.5}, {1, 1, 0.2}, {1, 2, 0.5}, {1, 3, 0.3},
+                                                 {2, 2, 0.4}, {2, 4, 0.6}, {3, 3, 0.5}, {3, 4, 0.2}, {3, 5, 0.3}};
+    const Matrix W( 4, 6, triplets );
+
+    Field src( "src", array::make_datatype<double>(), array::make_shape( 6 ) );
+    Field tgt( "tgt", array::make_datatype<double>(), array::make_shape( 4 ) );
+    auto vsrc = array::make_view<double, 1>( src );
+    auto vtgt = array::make_view<double, 1>( tgt );
+
+    src.metadata().set( "missing_value", missingValue );
+    src.metadata().set( "missing_value_epsilon", missingValueEps );
+
+    for ( std::string non_linear : {"missing-if-all-missing", "missing-if-any-missing", "missing-if-heaviest-missing"} ) {
+        NonLinear nl( non_linear, Config() );
+        for ( std::string type : {"equals", "nan"} ) {
+            src.metadata().set( "missing_value_type", type );
+            const double m = type == "nan" ? nan : missingValue;
+            for ( idx_t n = 0; n < 6; ++n ) {
+                vsrc( n ) = ( n == 2 || n == 4 ) ? m : 1. + n;
+            }
+
+            EXPECT( nl( src ) );
+            EXPECT( nl.interpolate( W, src, tgt ) );
+
+            Matrix Wc( W );
+            nl.execute( Wc, src );
+            const auto outer  = Wc.outer();
+            const auto index  = Wc.inner();
+            const auto weight = Wc.data();
+
+            MissingValue mv( src );
+            for ( idx_t r = 0; r < 4; ++r ) {
+                double expected = 0.;
+                for ( auto c = outer[r]; c < outer[r + 1]; ++c ) {
+                    expected += weight[c] * vsrc( index[c] );
+                }
+                Log::info() << non_linear << " (" << type << ") row " << r << ": " << vtgt( r ) << std::endl;
+                if ( mv( expected ) ) {
+                    EXPECT( mv( vtgt( r ) ) );
+                }
+                else {
+                    EXPECT( vtgt( r ) == expected );
+                }
+            }
+        }
+    }
+}
+
 }  // namespace test
 }  // namespace atlas
 
@@ -277,6 +277,45 @@ CASE( "test_interpolation_structured using fs API multiple levels" ) {
     }
 }
 
+CASE( "test_interpolation_structured matrix_free matches matrix" ) {
+    Grid input_grid( input_gridname( "O32" ) );
+    Grid output_grid( output_gridname( "O64" ) );
+
+    // Cubic interpolation requires a StructuredColumns functionspace with 2 halos
+    StructuredColumns input_fs( input_grid, scheme() | option::levels( 3 ) );
+
+    MeshGenerator meshgen( "structured" );
+    Mesh output_mesh = meshgen.generate( output_grid );
+    NodeColumns output_fs{output_mesh, option::levels( 3 )};
+
+    Field field_source = input_fs.createField<double>( option::name( "source" ) );
+    auto lonlat        = array::make_view<double, 2>( input_fs.xy() );
+    auto source        = array::make_view<double, 2>( field_source );
+    for ( idx_t n = 0; n < input_fs.size(); ++n ) {
+        for ( idx_t k = 0; k < 3; ++k ) {
+            source( n, k ) = vortex_rollup( lonlat( n, LON ), lonlat( n, LAT ), 0.5 + double( k ) / 2 );
+        }
+    }
+
+    // the matrix-free execution computes stencils and weights for blocks of target points at once
+    Field field_matrix      = output_fs.createField<double>( option::name( "matrix" ) );
+    Field field_matrix_free = output_fs.createField<double>( option::name( "matrix_free" ) );
+    Interpolation( scheme(), input_fs, output_fs ).execute( field_source, field_matrix );
+    Interpolation( scheme() | Config( "matrix_free", true ), input_fs, output_fs )
+        .execute( field_source, field_matrix_free );
+
+    auto ghost       = array::make_view<int, 1>( output_fs.nodes().ghost() );
+    auto matrix      = array::make_view<double, 2>( field_matrix );
+    auto matrix_free = array::make_view<double, 2>( field_matrix_free );
+    for ( idx_t n = 0; n < output_fs.size(); ++n ) {
+        if ( not ghost( n ) ) {
+            for ( idx_t k = 0; k < 3; ++k ) {
+                EXPECT_APPROX_EQ( matrix_free( n, k ), matrix( n, k ), 1.e-12 );
+            }
+        }
+    }
+}
+
 CASE( "test_interpolation_structured using fs API for fieldset" ) {
     Grid input_grid( input_gridname( "O32" ) );
     Grid output_grid( output_gridname( "O64" ) );
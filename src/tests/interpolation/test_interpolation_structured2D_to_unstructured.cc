@@ -8,6 +8,8 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include "eckit/types/FloatCompare.h"
+
 #include "atlas/array.h"
 #include "atlas/field/Field.h"
 #include "atlas/field/FieldSet.h"
@@ -16,10 +18,13 @@
 #include "atlas/functionspace/StructuredColumns.h"
 #include "atlas/grid/Grid.h"
 #include "atlas/grid/Iterator.h"
+#include "atlas/grid/StructuredGrid.h"
+#include "atlas/grid/UnstructuredGrid.h"
 #include "atlas/interpolation.h"
 #include "atlas/mesh/Mesh.h"
 #include "atlas/meshgenerator.h"
 #include "atlas/output/Gmsh.h"
+#include "atlas/parallel/mpi/mpi.h"
 #include "atlas/util/CoordinateEnums.h"
 
 #include "tests/AtlasTestEnvironment.h"
@@ -176,6 +181,93 @@ CASE( "test_nomatch" ) {
     }
 }
 
+CASE( "test_grid_api" ) {
+    // With the grid API the target grid is distributed to match the source partitions
+    Grid input_grid( input_gridname( "O32" ) );
+    Grid output_grid( "O64" );
+
+    Interpolation interpolation( option::type( "structured-linear2D" ), input_grid, output_grid );
+
+    StructuredColumns input_fs = interpolation.source();
+    FunctionSpace output_fs    = interpolation.target();
+
+    idx_t nb_owned = 0;
+    auto ghost     = array::make_view<int, 1>( output_fs.ghost() );
+    for ( idx_t n = 0; n < output_fs.size(); ++n ) {
+        nb_owned += ghost( n ) ? 0 : 1;
+    }
+    mpi::comm().allReduceInPlace( nb_owned, eckit::mpi::sum() );
+    EXPECT_EQ( nb_owned, output_grid.size() );
+
+    Field field_source = input_fs.createField<double>();
+    Field field_target = output_fs.createField<double>();
+
+    auto lonlat = array::make_view<double, 2>( input_fs.xy() );
+    auto source = array::make_view<double, 1>( field_source );
+    for ( idx_t n = 0; n < input_fs.size(); ++n ) {
+        source( n ) = vortex_rollup( lonlat( n, LON ), lonlat( n, LAT ), 1. );
+    }
+    field_source.set_dirty();
+
+    interpolation.execute( field_source, field_target );
+
+    // linear interpolation remains within the bounds of the source field, here [0,2]
+    auto target = array::make_view<double, 1>( field_target );
+    for ( idx_t n = 0; n < output_fs.size(); ++n ) {
+        EXPECT( target( n ) >= 0. && target( n ) <= 2. );
+    }
+}
+
+CASE( "test_grid_api_unstructured_target" ) {
+    // An unstructured target grid is distributed as a PointCloud, with the same points per partition as a
+    // structured target grid with the same points
+    Grid input_grid( input_gridname( "O32" ) );
+    StructuredGrid structured( "O64" );
+    std::vector<PointXY> points( structured.xy().begin(), structured.xy().end() );
+    UnstructuredGrid unstructured( points );
+
+    auto interpolate = [&]( const Grid& output_grid, idx_t& nb_owned, double& sum ) {
+        Interpolation interpolation( option::type( "structured-linear2D" ), input_grid, output_grid );
+
+        StructuredColumns input_fs = interpolation.source();
+        FunctionSpace output_fs    = interpolation.target();
+
+        Field field_source = input_fs.createField<double>();
+        Field field_target = output_fs.createField<double>();
+
+        auto lonlat = array::make_view<double, 2>( input_fs.xy() );
+        auto source = array::make_view<double, 1>( field_source );
+        for ( idx_t n = 0; n < input_fs.size(); ++n ) {
+            source( n ) = vortex_rollup( lonlat( n, LON ), lonlat( n, LAT ), 1. );
+        }
+        field_source.set_dirty();
+
+        interpolation.execute( field_source, field_target );
+
+        nb_owned    = 0;
+        sum         = 0.;
+        auto ghost  = array::make_view<int, 1>( output_fs.ghost() );
+        auto target = array::make_view<double, 1>( field_target );
+        for ( idx_t n = 0; n < output_fs.size(); ++n ) {
+            if ( not ghost( n ) ) {
+                ++nb_owned;
+                sum += target( n );
+            }
+        }
+    };
+
+    idx_t nb_owned_structured, nb_owned_unstructured;
+    double sum_structured, sum_unstructured;
+    interpolate( structured, nb_owned_structured, sum_structured );
+    interpolate( unstructured, nb_owned_unstructured, sum_unstructured );
+
+    EXPECT_EQ( nb_owned_unstructured, nb_owned_structured );
+    EXPECT( eckit::types::is_approximately_equal( sum_unstructured, sum_structured, 1.e-8 ) );
+
+    mpi::comm().allReduceInPlace( nb_owned_unstructured, eckit::mpi::sum() );
+    EXPECT_EQ( nb_owned_unstructured, unstructured.size() );
+}
+
 
 }  // namespace test
 }  // namespace atlas
@@ -15,7 +15,7 @@
 
 #include "atlas/array/ArrayView.h"
 #include "atlas/array/MakeView.h"
-#include "atlas/grid/Grid.h"
+#include "atlas/grid.h"
 #include "atlas/mesh/IsGhostNode.h"
 #include "atlas/mesh/Mesh.h"
 #include "atlas/mesh/Nodes.h"
@@ -131,6 +131,36 @@ CASE( "test_distribute_t63" ) {
 }
 //-----------------------------------------------------------------------------
 
+CASE( "test_matching_mesh_partitioner_lonlat_polygon" ) {
+    Mesh mesh = StructuredMeshGenerator().generate( Grid( "O16" ) );
+    grid::MatchingMeshPartitioner partitioner( mesh, util::Config( "type", "lonlat-polygon" ) );
+
+    // A StructuredGrid skips rows outside the partition polygon, an UnstructuredGrid tests every point.
+    StructuredGrid structured( "O32" );
+    std::vector<PointXY> points( structured.xy().begin(), structured.xy().end() );
+    UnstructuredGrid unstructured( points );
+
+    std::vector<int> part_structured( structured.size() );
+    std::vector<int> part_unstructured( unstructured.size() );
+    partitioner.partition( structured, part_structured.data() );
+    partitioner.partition( unstructured, part_unstructured.data() );
+
+    // Every task gets the partition of every point, from the runs of points claimed by all tasks
+    idx_t nb_owned = 0;
+    for ( idx_t n = 0; n < structured.size(); ++n ) {
+        EXPECT_EQ( part_structured[n], part_unstructured[n] );
+        EXPECT( part_structured[n] >= 0 && part_structured[n] < mpi::size() );
+        nb_owned += ( part_structured[n] == mpi::rank() );
+    }
+    EXPECT( nb_owned > 0 );
+
+    idx_t nb_owned_total = nb_owned;
+    mpi::comm().allReduceInPlace( nb_owned_total, eckit::mpi::sum() );
+    EXPECT_EQ( nb_owned_total, structured.size() );
+}
+
+//-----------------------------------------------------------------------------
+
 }  // namespace test
 }  // namespace atlas
 
@@ -9,6 +9,7 @@
  */
 
 #include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <sstream>
 
@@ -26,8 +27,11 @@
 #include "atlas/mesh/actions/BuildHalo.h"
 #include "atlas/mesh/actions/BuildParallelFields.h"
 #include "atlas/mesh/actions/BuildPeriodicBoundaries.h"
+#include "atlas/mesh/detail/RenumberGlobalIndex.h"
 #include "atlas/output/Gmsh.h"
+#include "atlas/parallel/mpi/Buffer.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/MicroDeg.h"
 #include "atlas/util/Unique.h"
@@ -103,27 +107,9 @@ CASE( "test_small" )
 }
 #endif
 
-#if 1
-CASE( "test_custom" ) {
-    // Mesh m = test::generate_mesh( T63() );
-
-    Mesh m = test::generate_mesh( {10, 12, 14, 16, 16, 16, 16, 14, 12, 10} );
-
-    mesh::actions::build_nodes_parallel_fields( m.nodes() );
-    mesh::actions::build_periodic_boundaries( m );
-    mesh::actions::build_halo( m, 1 );
-
-    std::stringstream filename;
-    filename << "custom.msh";
-    Gmsh( filename.str(), util::Config( "ghost", true ) ).write( m );
-
-    //  EXPECT( eckit::types::is_approximately_equal( test::dual_volume(m),
-    //  2.*M_PI*M_PI, 1e-6 ));
-
-    auto lonlat = array::make_view<double, 2>( m.nodes().lonlat() );
-
 #if ATLAS_BITS_GLOBAL == 64
-
+// Unique ids of the nodes of the custom mesh with a halo of 1, on every task of 5 tasks
+std::vector<uidx_t> custom_halo_uids() {
     std::vector<uidx_t> check;
     switch ( mpi::comm().rank() ) {
         case 0:
@@ -205,6 +191,32 @@ CASE( "test_custom" ) {
         default:
             check.clear();
     }
+    return check;
+}
+#endif
+
+#if 1
+CASE( "test_custom" ) {
+    // Mesh m = test::generate_mesh( T63() );
+
+    Mesh m = test::generate_mesh( {10, 12, 14, 16, 16, 16, 16, 14, 12, 10} );
+
+    mesh::actions::build_nodes_parallel_fields( m.nodes() );
+    mesh::actions::build_periodic_boundaries( m );
+    mesh::actions::build_halo( m, 1 );
+
+    std::stringstream filename;
+    filename << "custom.msh";
+    Gmsh( filename.str(), util::Config( "ghost", true ) ).write( m );
+
+    //  EXPECT( eckit::types::is_approximately_equal( test::dual_volume(m),
+    //  2.*M_PI*M_PI, 1e-6 ));
+
+    auto lonlat = array::make_view<double, 2>( m.nodes().lonlat() );
+
+#if ATLAS_BITS_GLOBAL == 64
+
+    std::vector<uidx_t> check = custom_halo_uids();
     std::vector<uidx_t> uid( m.nodes().size() );
     for ( idx_t j = 0; j < m.nodes().size(); ++j ) {
         uid[j] = util::unique_lonlat( lonlat( j, 0 ), lonlat( j, 1 ) );
@@ -244,6 +256,122 @@ CASE( "test_custom" ) {
     //  DEBUG("dual_normals checksum "<<checksum,0);
 }
 #endif
+CASE( "test_halo_threads_identical" ) {
+    test::expect_identical_with_threads(
+        []() {
+            Mesh mesh = test::generate_mesh( StructuredGrid( "O32" ) );
+            mesh::actions::build_nodes_parallel_fields( mesh.nodes() );
+            mesh::actions::build_periodic_boundaries( mesh );
+            mesh::actions::build_halo( mesh, 3 );
+            return mesh;
+        },
+        true );
+}
+
+CASE( "test_halo_threads_reference" ) {
+    int max_threads = atlas_omp_get_max_threads();
+    atlas_omp_set_num_threads( std::max( 4, max_threads ) );
+
+#if ATLAS_BITS_GLOBAL == 64
+    // Same nodes in the same order as the reference of test_custom
+    {
+        Mesh m = test::generate_mesh( {10, 12, 14, 16, 16, 16, 16, 14, 12, 10} );
+        mesh::actions::build_nodes_parallel_fields( m.nodes() );
+        mesh::actions::build_periodic_boundaries( m );
+        mesh::actions::build_halo( m, 1 );
+
+        auto lonlat = array::make_view<double, 2>( m.nodes().lonlat() );
+        std::vector<uidx_t> uid( m.nodes().size() );
+        for ( idx_t j = 0; j < m.nodes().size(); ++j ) {
+            uid[j] = util::unique_lonlat( lonlat( j, 0 ), lonlat( j, 1 ) );
+        }
+        std::vector<uidx_t> check = custom_halo_uids();
+        if ( check.size() && mpi::comm().size() == 5 ) {
+            EXPECT( uid == check );
+        }
+    }
+#endif
+
+    // Every node of a halo of 3 has the remote index of the node with the same coordinates on its owner,
+    // up to a periodic shift
+    {
+        Mesh mesh = test::generate_mesh( StructuredGrid( "O32" ) );
+        mesh::actions::build_nodes_parallel_fields( mesh.nodes() );
+        mesh::actions::build_periodic_boundaries( mesh );
+        mesh::actions::build_halo( mesh, 3 );
+
+        const auto& comm     = mpi::comm();
+        const idx_t nb_nodes = mesh.nodes().size();
+        auto xy              = array::make_view<double, 2>( mesh.nodes().xy() );
+        auto part            = array::make_view<int, 1>( mesh.nodes().partition() );
+        auto ridx            = array::make_indexview<idx_t, 1>( mesh.nodes().remote_index() );
+
+        std::vector<std::vector<int>> send_ridx( comm.size() );
+        std::vector<std::vector<int>> recv_ridx( comm.size() );
+        std::vector<std::vector<idx_t>> requested( comm.size() );
+        for ( idx_t n = 0; n < nb_nodes; ++n ) {
+            send_ridx[part( n )].push_back( ridx( n ) );
+            requested[part( n )].push_back( n );
+        }
+        comm.allToAll( send_ridx, recv_ridx );
+
+        std::vector<std::vector<double>> send_xy( comm.size() );
+        std::vector<std::vector<double>> recv_xy( comm.size() );
+        for ( size_t p = 0; p < comm.size(); ++p ) {
+            for ( int r : recv_ridx[p] ) {
+                EXPECT( r >= 0 && r < nb_nodes );
+                const idx_t owned = std::min( std::max( r, 0 ), nb_nodes - 1 );
+                send_xy[p].push_back( xy( owned, XX ) );
+                send_xy[p].push_back( xy( owned, YY ) );
+                send_xy[p].push_back( part( owned ) );
+            }
+        }
+        comm.allToAll( send_xy, recv_xy );
+
+        for ( size_t p = 0; p < comm.size(); ++p ) {
+            EXPECT_EQ( recv_xy[p].size(), 3 * requested[p].size() );
+            for ( size_t j = 0; j < requested[p].size(); ++j ) {
+                const idx_t n = requested[p][j];
+                EXPECT_EQ( int( recv_xy[p][3 * j + 2] ), int( p ) );
+                EXPECT( recv_xy[p][3 * j + 1] == xy( n, YY ) );
+                EXPECT( eckit::types::is_approximately_equal( std::remainder( xy( n, XX ) - recv_xy[p][3 * j], 360. ),
+                                                              0., 1.e-9 ) );
+            }
+        }
+    }
+
+    atlas_omp_set_num_threads( max_threads );
+}
+
+CASE( "test_renumber_global_index" ) {
+    const auto& comm = mpi::comm();
+    const int mypart = static_cast<int>( comm.rank() );
+
+    // Indices shared between tasks, duplicated within a task, and a task without indices
+    std::vector<gidx_t> glb_idx;
+    if ( mypart != 1 ) {
+        for ( int j = 0; j < 100 + 37 * mypart; ++j ) {
+            glb_idx.emplace_back( gidx_t( ( j * 7919 + mypart * 104729 ) % 1000 ) * 1000003 - 500 );
+        }
+    }
+
+    // Reference: sort the indices of all tasks on every task
+    mpi::Buffer<gidx_t, 1> all( comm.size() );
+    comm.allGatherv( glb_idx.begin(), glb_idx.end(), all );
+    std::vector<gidx_t> distinct( all.buffer.begin(), all.buffer.end() );
+    std::sort( distinct.begin(), distinct.end() );
+    distinct.erase( std::unique( distinct.begin(), distinct.end() ), distinct.end() );
+
+    const gidx_t base = 42;
+    std::vector<gidx_t> renumbered( glb_idx );
+    mesh::detail::renumber_global_index( renumbered.data(), renumbered.size(), base );
+
+    for ( size_t j = 0; j < glb_idx.size(); ++j ) {
+        auto rank = std::lower_bound( distinct.begin(), distinct.end(), glb_idx[j] ) - distinct.begin();
+        EXPECT_EQ( renumbered[j], base + 1 + rank );
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
@@ -9,6 +9,7 @@
  */
 
 #include <algorithm>
+#include <cstdint>
 #include <iomanip>
 #include <sstream>
 
@@ -29,12 +30,14 @@
 #include "atlas/meshgenerator.h"
 #include "atlas/output/Gmsh.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/util/Config.h"
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/Metadata.h"
 
 #include "tests/AtlasTestEnvironment.h"
+#include "tests/TestMeshes.h"
 
 namespace atlas {
 namespace grid {
@@ -445,6 +448,103 @@ CASE( "test_meshgen_ghost_at_end" ) {
     Log::info() << "]" << std::endl;
 }
 
+CASE( "test_meshgen_threads_bit_identical" ) {
+    Grid grid( "O32" );
+
+    std::vector<util::Config> configs;
+    for ( int p : {0, 3, 6} ) {
+        configs.emplace_back( util::Config( "nb_parts", 7 )( "part", p ) );
+        configs.emplace_back( util::Config( "nb_parts", 7 )( "part", p )( "ghost_at_end", false ) );
+    }
+    configs.emplace_back( util::Config( "nb_parts", 1 )( "part", 0 )( "include_pole", true ) );
+    configs.emplace_back( util::Config( "nb_parts", 1 )( "part", 0 )( "patch_pole", true ) );
+    configs.emplace_back( util::Config( "nb_parts", 1 )( "part", 0 )( "3d", true ) );
+
+    for ( const auto& config : configs ) {
+        test::expect_identical_with_threads( [&]() { return StructuredMeshGenerator( config ).generate( grid ); } );
+    }
+}
+
+CASE( "test_meshgen_threads_reference" ) {
+    // Reference values were computed with the serial generator, before pairs of latitudes were generated in
+    // parallel. Bands 2 and 3 and chunk 2 have no elements in their northernmost pair of latitudes.
+    StructuredGrid grid( "O32" );
+
+    auto checksum = []( const std::vector<gidx_t>& values ) {
+        std::uint64_t h = 0;
+        for ( gidx_t v : values ) {
+            h = h * 1000003 + static_cast<std::uint64_t>( v );
+        }
+        return h;
+    };
+
+    grid::Distribution::partition_t bands( grid.size() );
+    grid::Distribution::partition_t chunks( grid.size() );
+    grid::Distribution::partition_t serial( grid.size(), 0 );
+    gidx_t n = 0;
+    for ( idx_t j = 0; j < grid.ny(); ++j ) {
+        for ( idx_t i = 0; i < grid.nx( j ); ++i, ++n ) {
+            bands[n]  = j / 16;
+            chunks[n] = static_cast<int>( n * 3 / grid.size() );
+        }
+    }
+    grid::Distribution bands_distribution( 4, std::move( bands ) );
+    grid::Distribution chunks_distribution( 3, std::move( chunks ) );
+    grid::Distribution serial_distribution( 1, std::move( serial ) );
+
+    struct Reference {
+        grid::Distribution distribution;
+        util::Config config;
+        idx_t nb_nodes;
+        idx_t nb_cells;
+        std::uint64_t glb_idx;
+        std::uint64_t connectivity;
+    };
+    auto part = []( int nb_parts, int p ) { return util::Config( "nb_parts", nb_parts )( "part", p ); };
+
+    std::vector<Reference> references{
+        {bands_distribution, part( 4, 0 ), 900, 1681, 10696422250927535354u, 2159984698753963729u},
+        {bands_distribution, part( 4, 1 ), 1986, 3565, 18407451498964664145u, 9817437032516486570u},
+        {bands_distribution, part( 4, 2 ), 1921, 3584, 16133416239246881009u, 2550913706066293224u},
+        {bands_distribution, part( 4, 3 ), 816, 1518, 4898523546145565624u, 10808024930738015885u},
+        {bands_distribution, part( 4, 2 )( "ghost_at_end", false ), 1921, 3584, 725746549844322161u,
+         2550913706066293224u},
+        {bands_distribution, part( 4, 3 )( "ghost_at_end", false ), 816, 1518, 16162896215618935096u,
+         10808024930738015885u},
+        {chunks_distribution, part( 3, 0 ), 1897, 3618, 3773849913269445851u, 7348310279054883408u},
+        {chunks_distribution, part( 3, 1 ), 1882, 3351, 15768100225118437948u, 17603548183619680002u},
+        {chunks_distribution, part( 3, 2 ), 1775, 3379, 6308701062862818391u, 35894141378798744u},
+        {serial_distribution, part( 1, 0 )( "include_pole", true ), 5314, 10352, 3846292335092715301u,
+         3409662707545850781u},
+        {serial_distribution, part( 1, 0 )( "3d", true ), 5248, 10348, 2713081850214542656u, 10519420888628093252u},
+    };
+
+    int max_threads = atlas_omp_get_max_threads();
+    atlas_omp_set_num_threads( std::max( 4, max_threads ) );
+    for ( const auto& reference : references ) {
+        Mesh mesh = StructuredMeshGenerator( reference.config ).generate( grid, reference.distribution );
+
+        EXPECT_EQ( mesh.nodes().size(), reference.nb_nodes );
+        EXPECT_EQ( mesh.cells().size(), reference.nb_cells );
+
+        auto glb_idx = array::make_view<gidx_t, 1>( mesh.nodes().global_index() );
+        std::vector<gidx_t> nodes;
+        for ( idx_t jnode = 0; jnode < mesh.nodes().size(); ++jnode ) {
+            nodes.push_back( glb_idx( jnode ) );
+        }
+        std::vector<gidx_t> cells;
+        const auto& conn = mesh.cells().node_connectivity();
+        for ( idx_t c = 0; c < mesh.cells().size(); ++c ) {
+            for ( idx_t k = 0; k < conn.cols( c ); ++k ) {
+                cells.push_back( glb_idx( conn( c, k ) ) );
+            }
+        }
+        EXPECT_EQ( checksum( nodes ), reference.glb_idx );
+        EXPECT_EQ( checksum( cells ), reference.connectivity );
+    }
+    atlas_omp_set_num_threads( max_threads );
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
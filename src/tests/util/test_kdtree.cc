@@ -8,14 +8,21 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdlib>
 #include <limits>
 #include <numeric>
 #include <vector>
 
+#include "eckit/filesystem/PathName.h"
+#include "eckit/types/FloatCompare.h"
+
 #include "atlas/grid.h"
+#include "atlas/util/Config.h"
 #include "atlas/util/KDTree.h"
+#include "atlas/util/detail/FlatKDTree.h"
 
 #include "tests/AtlasTestEnvironment.h"
 
@@ -252,6 +259,141 @@ CASE( "test closestPointsWithinRadius" ) {
     EXPECT_EQ( neighbours, expected_neighbours );
 }
 
+CASE( "test batched searches" ) {
+    const std::vector<PointLonLat> lonlat{PointLonLat{180., 45.}, PointLonLat{89.9, 44.9}, PointLonLat{0., 90.},
+                                          PointLonLat{-10., -87.}, PointLonLat{359.9, 0.1}};
+    std::vector<PointXYZ> xyz;
+    for ( const auto& p : lonlat ) {
+        xyz.emplace_back( make_xyz( p ) );
+    }
+    const size_t n = lonlat.size();
+    const size_t k = 8;
+    const double r = 500.e3;
+
+    std::vector<size_t> offsets( n + 1 );
+    std::vector<idx_t> payloads( n * k );
+    std::vector<double> distances( n * k );
+
+    auto check = [&]( const std::vector<IndexKDTree::Value>& expected, size_t i ) {
+        EXPECT_EQ( offsets[i + 1] - offsets[i], std::min( expected.size(), k ) );
+        for ( size_t j = offsets[i]; j < offsets[i + 1]; ++j ) {
+            EXPECT_EQ( payloads[j], expected[j - offsets[i]].payload() );
+            EXPECT_APPROX_EQ( distances[j], expected[j - offsets[i]].distance(), 1.e-6 );
+        }
+    };
+
+    SECTION( "lonlat" ) {
+        search().closestPoint( n, lonlat.data(), payloads.data(), distances.data() );
+        for ( size_t i = 0; i < n; ++i ) {
+            EXPECT_EQ( payloads[i], search().closestPoint( lonlat[i] ).payload() );
+        }
+        search().closestPoints( n, lonlat.data(), k, offsets.data(), payloads.data(), distances.data() );
+        for ( size_t i = 0; i < n; ++i ) {
+            check( search().closestPoints( lonlat[i], k ), i );
+        }
+        search().closestPointsWithinRadius( n, lonlat.data(), r, k, offsets.data(), payloads.data(),
+                                            distances.data() );
+        for ( size_t i = 0; i < n; ++i ) {
+            check( search().closestPointsWithinRadius( lonlat[i], r ), i );
+        }
+    }
+    SECTION( "xyz" ) {
+        search().closestPoint( n, xyz.data(), payloads.data(), distances.data() );
+        for ( size_t i = 0; i < n; ++i ) {
+            EXPECT_EQ( payloads[i], search().closestPoint( xyz[i] ).payload() );
+        }
+        search().closestPoints( n, xyz.data(), k, offsets.data(), payloads.data(), distances.data() );
+        for ( size_t i = 0; i < n; ++i ) {
+            check( search().closestPoints( xyz[i], k ), i );
+        }
+        search().closestPointsWithinRadius( n, xyz.data(), r, k, offsets.data(), payloads.data(), distances.data() );
+        for ( size_t i = 0; i < n; ++i ) {
+            check( search().closestPointsWithinRadius( xyz[i], r ), i );
+        }
+    }
+}
+
+CASE( "test flat kdtree against eckit kdtree" ) {
+    auto grid = Grid{"O32"};
+    IndexKDTree flat( geometry(), util::Config( "type", "flat" ) );
+    flat.build( grid.lonlat(), PayloadGenerator( grid.size() ) );
+
+    // Points without equidistant neighbours: the results are the same, in the same order
+    for ( const auto& p : {PointLonLat{180., 45.}, PointLonLat{89.9, 44.9}, PointLonLat{-10., -87.},
+                           PointLonLat{359.9, 0.1}} ) {
+        EXPECT_EQ( flat.closestPoint( p ).payload(), search().closestPoint( p ).payload() );
+        EXPECT_EQ( flat.closestPoints( p, 8 ).payloads(), search().closestPoints( p, 8 ).payloads() );
+        EXPECT_EQ( flat.closestPointsWithinRadius( p, 500.e3 ).payloads(),
+                   search().closestPointsWithinRadius( p, 500.e3 ).payloads() );
+    }
+
+    // At the pole, a whole latitude is (nearly) equidistant: the distances are the same, and the neighbours closer
+    // than the k-th distance are the same set. The order of equidistant neighbours is fixed, but may differ
+    // from the eckit kd-tree.
+    {
+        const PointLonLat pole{0., 90.};
+        const auto expected = search().closestPoints( pole, 8 );
+        const auto result   = flat.closestPoints( pole, 8 );
+        EXPECT_EQ( result.size(), expected.size() );
+        const double kth = expected.back().distance();
+        std::vector<idx_t> closer_expected, closer_result;
+        for ( size_t i = 0; i < result.size(); ++i ) {
+            EXPECT( eckit::types::is_approximately_equal( result[i].distance(), expected[i].distance(), 1.e-6 ) );
+            if ( expected[i].distance() < kth - 1.e-6 ) {
+                closer_expected.emplace_back( expected[i].payload() );
+            }
+            if ( result[i].distance() < kth - 1.e-6 ) {
+                closer_result.emplace_back( result[i].payload() );
+            }
+        }
+        std::sort( closer_expected.begin(), closer_expected.end() );
+        std::sort( closer_result.begin(), closer_result.end() );
+        EXPECT_EQ( closer_result, closer_expected );
+        EXPECT_EQ( flat.closestPoints( pole, 8 ).payloads(), result.payloads() );
+    }
+
+    const std::vector<PointLonLat> points{PointLonLat{180., 45.}, PointLonLat{-10., -87.}};
+    std::vector<size_t> offsets( points.size() + 1 );
+    std::vector<idx_t> payloads( points.size() * 4 );
+    std::vector<double> distances( points.size() * 4 );
+    flat.closestPoints( points.size(), points.data(), 4, offsets.data(), payloads.data(), distances.data() );
+    EXPECT_EQ( offsets, ( std::vector<size_t>{0, 4, 8} ) );
+    for ( size_t i = 0; i < points.size(); ++i ) {
+        EXPECT_EQ( std::vector<idx_t>( payloads.begin() + offsets[i], payloads.begin() + offsets[i + 1] ),
+                   search().closestPoints( points[i], 4 ).payloads() );
+    }
+}
+
+CASE( "test flat kdtree written to file and memory-mapped" ) {
+    auto grid = Grid{"O32"};
+
+    const char* tmpdir = ::getenv( "TMPDIR" );
+    const eckit::PathName dir( tmpdir ? tmpdir : "/tmp" );
+    const eckit::PathName file    = eckit::PathName::unique( dir / "atlas_test_kdtree_flat.bin" );
+    const eckit::PathName missing = eckit::PathName::unique( dir / "atlas_test_kdtree_missing.bin" );
+    {
+        IndexKDTree flat( geometry(), util::Config( "type", "flat" ) );
+        flat.build( grid.lonlat(), PayloadGenerator( grid.size() ) );
+        flat.write( file.asString(), grid.uid() );
+    }
+
+    IndexKDTree mapped( geometry(), util::Config( "type", "flat" ) );
+    EXPECT( not mapped.open( file.asString(), "other key" ) );
+    EXPECT( not mapped.open( missing.asString(), grid.uid() ) );
+    EXPECT( mapped.open( file.asString(), grid.uid() ) );
+
+    for ( const auto& p : {PointLonLat{180., 45.}, PointLonLat{89.9, 44.9}, PointLonLat{-10., -87.}} ) {
+        EXPECT_EQ( mapped.closestPoint( p ).payload(), search().closestPoint( p ).payload() );
+        EXPECT_EQ( mapped.closestPoints( p, 8 ).payloads(), search().closestPoints( p, 8 ).payloads() );
+    }
+    EXPECT_THROWS_AS( mapped.insert( PointLonLat{0., 0.}, 0 ), eckit::AssertionFailed );
+
+    IndexKDTree eckit_tree( geometry() );
+    EXPECT_THROWS_AS( eckit_tree.open( file.asString(), grid.uid() ), eckit::NotImplemented );
+
+    file.unlink();
+}
+
 CASE( "test compatibility with external eckit KDTree" ) {
     // External world
     struct ExternalKDTreeTraits {
@@ -299,6 +441,36 @@ CASE( "test IndexKDTree 2D vs 3D" ) {
     // Note that the expected values are different whether 2D search or 3D search is used
 }
 
+CASE( "test FlatKDTree against IndexKDTree" ) {
+    auto grid = Grid{"O32"};
+    detail::FlatKDTree<idx_t, PointXYZ> flat;
+    flat.reserve( grid.size() );
+    idx_t n{0};
+    for ( auto& point : grid.lonlat() ) {
+        flat.insert( make_xyz( point ), n++ );
+    }
+    flat.build();
+    EXPECT_EQ( flat.size(), static_cast<size_t>( grid.size() ) );
+
+    std::vector<detail::FlatKDTree<idx_t, PointXYZ>::Neighbour> neighbours;
+    for ( const auto& p : {PointLonLat{180., 45.}, PointLonLat{89.9, 44.9}, PointLonLat{0., 90.},
+                           PointLonLat{-10., -87.}, PointLonLat{359.9, 0.1}} ) {
+        const PointXYZ xyz = make_xyz( p );
+
+        EXPECT_EQ( flat.payload( flat.closestPoint( xyz ).index ), search().closestPoint( p ).payload() );
+
+        flat.closestPoints( xyz, 8, neighbours );
+        auto expected = search().closestPoints( p, 8 );
+        EXPECT_EQ( neighbours.size(), expected.size() );
+        for ( size_t i = 0; i < neighbours.size(); ++i ) {
+            EXPECT_APPROX_EQ( std::sqrt( neighbours[i].distance2 ), expected[i].distance(), 1.e-6 );
+        }
+
+        flat.closestPointsWithinRadius( xyz, 500.e3, neighbours );
+        EXPECT_EQ( neighbours.size(), search().closestPointsWithinRadius( p, 500.e3 ).size() );
+    }
+}
+
 //------------------------------------------------------------------------------------------------
 
 }  // namespace test